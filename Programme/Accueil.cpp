@@ -13,16 +13,152 @@
 #include "SupprimerCompte.h"
 #include "Epargne.h"
 #include "Cheque.h"
+#include <QHeaderView>
 #include <QMessageBox>
+#include <QTextCursor>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace
+{
+// Taille visée d'un morceau de relevé, et quantité de texte versée dans la
+// zone de texte par tour de la boucle d'événements.
+const int TAILLE_MORCEAU = 16 * 1024;
+const int TAILLE_TRANCHE = 64 * 1024;
+}
 
 
-Accueil::Accueil () : m_client(1000, "Florentino", "Perez", "418 656-0235", util::Date(19, 03, 1975))
+Accueil::Accueil () : m_client(1000, "Florentino", "Perez", "418 656-0235", util::Date(19, 03, 1975)),
+m_modele(m_client), m_annulation(std::make_shared<std::atomic<bool>>(false)),
+m_releveEnAttente(false), m_prochainMorceau(0)
 {
   widget.setupUi (this);
-  widget.textEditReleveClient->setPlainText(m_client.reqReleves ().c_str());
+  widget.tableViewComptes->setModel (&m_modele);
+  // Hauteurs et largeurs fixes : la vue ne mesure que les lignes visibles.
+  widget.tableViewComptes->verticalHeader ()->setSectionResizeMode (QHeaderView::Fixed);
+  widget.tableViewComptes->verticalHeader ()->hide ();
+  widget.tableViewComptes->horizontalHeader ()->setSectionResizeMode (QHeaderView::Interactive);
+  widget.tableViewComptes->horizontalHeader ()->setStretchLastSection (true);
+  widget.tableViewComptes->setSelectionBehavior (QAbstractItemView::SelectRows);
+  widget.tableViewComptes->setEditTriggers (QAbstractItemView::NoEditTriggers);
+  widget.plainTextEditReleve->setReadOnly (true);
+  connect (&m_rendu, &QFutureWatcher<QStringList>::finished, this, &Accueil::releveTermine);
+  m_alimentation.setSingleShot (true);
+  m_alimentation.setInterval (0);
+  connect (&m_alimentation, &QTimer::timeout, this, &Accueil::alimenterReleve);
+  demanderReleve ();
+}
+
+Accueil::~Accueil ()
+{
+  // Le rendu ne travaille que sur sa copie du client ; on l'annule et on
+  // l'attend seulement pour ne pas laisser de tâche dans le pool à la fermeture.
+  m_annulation->store (true);
+  m_rendu.waitForFinished ();
+}
+
+/**
+ * Demande un relevé à jour. Si un rendu tourne déjà, son résultat sera périmé :
+ * on l'annule, et un seul rendu, sur l'état le plus récent, sera relancé à sa
+ * fin. Des demandes rapprochées ne coûtent donc qu'un rendu.
+ */
+void Accueil::demanderReleve ()
+{
+  if (m_rendu.isRunning ())
+    {
+      m_annulation->store (true);
+      m_releveEnAttente = true;
+      return;
+    }
+  lancerReleve ();
 }
 
-Accueil::~Accueil () { }
+/**
+ * Lance le rendu du relevé sur le pool de QtConcurrent. La copie du client est
+ * prise dans le fil de l'interface ; le fil de travail n'en lit rien d'autre.
+ * Le relevé est celui de Client::reqReleves, découpé en morceaux d'environ
+ * TAILLE_MORCEAU entre les comptes ; l'annulation est vérifiée entre deux
+ * comptes, et un rendu annulé rend une liste vide.
+ */
+void Accueil::lancerReleve ()
+{
+  m_releveEnAttente = false;
+  m_alimentation.stop ();
+  m_morceaux.clear ();
+  m_annulation = std::make_shared<std::atomic<bool>>(false);
+  std::shared_ptr<const bancaire::Client> instantane = std::make_shared<const bancaire::Client>(m_client);
+  std::shared_ptr<std::atomic<bool>> annulation = m_annulation;
+  widget.statusbar->showMessage ("Generation du releve...");
+  m_rendu.setFuture (QtConcurrent::run ([instantane, annulation] ()
+  {
+    QStringList morceaux;
+    std::string morceau = instantane->reqClientFormate ();
+    bool annule = false;
+    instantane->parcourirComptes ([&] (const bancaire::Compte& p_compte)
+    {
+      if (annule)
+        {
+          return;
+        }
+      if (annulation->load (std::memory_order_relaxed))
+        {
+          annule = true;
+          return;
+        }
+      morceau += p_compte.reqCompteFormate ();
+      if (morceau.size () >= static_cast<size_t> (TAILLE_MORCEAU))
+        {
+          morceaux.append (QString::fromStdString (morceau));
+          morceau.clear ();
+        }
+    });
+    if (annule)
+      {
+        return QStringList();
+      }
+    morceaux.append (QString::fromStdString (morceau));
+    return morceaux;
+  }));
+}
+
+void Accueil::releveTermine ()
+{
+  if (m_releveEnAttente)
+    {
+      lancerReleve ();
+      return;
+    }
+  m_morceaux = m_rendu.result ();
+  m_prochainMorceau = 0;
+  widget.plainTextEditReleve->clear ();
+  widget.statusbar->showMessage ("Affichage du releve...");
+  alimenterReleve ();
+}
+
+/**
+ * Verse dans la zone de texte les morceaux suivants du relevé, environ
+ * TAILLE_TRANCHE caractères à la fois, puis rend la main à la boucle
+ * d'événements : l'interface reste réactive même pour un très long relevé.
+ * Un nouveau rendu interrompt l'alimentation (lancerReleve).
+ */
+void Accueil::alimenterReleve ()
+{
+  QTextCursor curseur(widget.plainTextEditReleve->document ());
+  curseur.movePosition (QTextCursor::End);
+  int verse = 0;
+  while (m_prochainMorceau < m_morceaux.size () && verse < TAILLE_TRANCHE)
+    {
+      const QString& morceau = m_morceaux.at (m_prochainMorceau++);
+      curseur.insertText (morceau);
+      verse += morceau.size ();
+    }
+  if (m_prochainMorceau < m_morceaux.size ())
+    {
+      m_alimentation.start ();
+      return;
+    }
+  m_morceaux.clear ();
+  widget.statusbar->clearMessage ();
+}
 
 void Accueil::slotAjouterCheque ()
 {
@@ -33,14 +169,14 @@ void Accueil::slotAjouterCheque ()
         {
           bancaire::Cheque unCheque(cheque.reqNoCompte (), cheque.reqTransactions (), cheque.reqSolde (), 
                           cheque.reqTauxInteret (), cheque.reqDescription (), cheque.reqTauxMin ());
-          m_client.ajouterCompte (unCheque);
+          m_modele.ajouterCompte (unCheque);
         }   
       catch(CompteDejaPresentException& erreur)
         {
           QString message = (erreur.what ());
           QMessageBox::information(this, "ERREUR", message);
         }
-      widget.textEditReleveClient->setPlainText (m_client.reqReleves ().c_str ());
+      demanderReleve ();
     }
 }
 
@@ -53,14 +189,14 @@ void Accueil::slotAjouterEpargne ()
         {
           bancaire::Epargne unEpargne(epargne.reqNoCompte (), epargne.reqTauxInteret (),
                             epargne.reqSolde (), epargne.reqDescription ());
-          m_client.ajouterCompte (unEpargne);
+          m_modele.ajouterCompte (unEpargne);
         }
       catch(CompteDejaPresentException& erreur)
         {
           QString message = (erreur.what());
           QMessageBox::information (this, "ERREUR", message);
         }
-      widget.textEditReleveClient->setPlainText (m_client.reqReleves ().c_str());
+      demanderReleve ();
     }
 }
 
@@ -71,13 +207,13 @@ void Accueil::slotSupprimerCompte ()
     {
       try
         {
-          m_client.supprimerCompte (suppression.reqNoCompte ());
+          m_modele.supprimerCompte (suppression.reqNoCompte ());
         }
       catch(CompteAbsentException& erreur)
         {
           QString message = (erreur.what());
           QMessageBox::information (this, "ERREUR", message);
         }
-      widget.textEditReleveClient->setPlainText (m_client.reqReleves ().c_str());
+      demanderReleve ();
     }
 }
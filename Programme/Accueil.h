@@ -15,6 +15,12 @@
 
 #include "ui_Accueil.h"
 #include "Client.h"
+#include "ModeleComptes.h"
+#include <QFutureWatcher>
+#include <QStringList>
+#include <QTimer>
+#include <atomic>
+#include <memory>
 
 class Accueil : public QMainWindow
 {
@@ -29,8 +35,24 @@ public:
     void slotSupprimerCompte();
     
 private:
+  void demanderReleve();
+  void lancerReleve();
+  void releveTermine();
+  void alimenterReleve();
+
   Ui::Accueil widget;
   bancaire::Client m_client;
+  ModeleComptes m_modele;
+  // Rendu du relevé en cours sur une copie du client, par morceaux ; au plus
+  // un rendu tourne, et une nouvelle demande l'annule et attend sa fin.
+  QFutureWatcher<QStringList> m_rendu;
+  std::shared_ptr<std::atomic<bool>> m_annulation;
+  bool m_releveEnAttente;
+  // Morceaux du dernier relevé, versés dans la zone de texte à chaque tour de
+  // la boucle d'événements plutôt que d'un seul bloc.
+  QStringList m_morceaux;
+  int m_prochainMorceau;
+  QTimer m_alimentation;
 };
  
 #endif /* _ACCUEIL_H */
@@ -0,0 +1,140 @@
+/*
+ * File:   ModeleComptes.cpp
+ * Author: etudiant
+ */
+
+#include "ModeleComptes.h"
+#include "Cheque.h"
+#include <utility>
+
+ModeleComptes::ModeleComptes (bancaire::Client& p_client, QObject* p_parent)
+  : QAbstractTableModel(p_parent), m_client(p_client)
+{
+  // Client n'expose pas ses comptes un à un : le modèle suit le client depuis
+  // son premier compte.
+  Q_ASSERT(m_client.reqComptes () == 0);
+}
+
+
+int ModeleComptes::rowCount (const QModelIndex& p_parent) const
+{
+  return p_parent.isValid () ? 0 : static_cast<int> (m_lignes.size ());
+}
+
+
+int ModeleComptes::columnCount (const QModelIndex& p_parent) const
+{
+  return p_parent.isValid () ? 0 : NombreColonnes;
+}
+
+
+QVariant ModeleComptes::data (const QModelIndex& p_index, int p_role) const
+{
+  if (!p_index.isValid () || p_index.row () >= rowCount ())
+    {
+      return QVariant();
+    }
+  if (p_role == Qt::TextAlignmentRole)
+    {
+      bool numerique = p_index.column () != ColonneType && p_index.column () != ColonneDescription;
+      return static_cast<int> (Qt::AlignVCenter | (numerique ? Qt::AlignRight : Qt::AlignLeft));
+    }
+  if (p_role != Qt::DisplayRole)
+    {
+      return QVariant();
+    }
+
+  const bancaire::Compte& compte = *m_lignes[p_index.row ()];
+  switch (p_index.column ())
+    {
+    case ColonneNoCompte:
+      return compte.reqNoCompte ();
+    case ColonneType:
+      return dynamic_cast<const bancaire::Cheque*> (&compte) ? QString("Cheque") : QString("Epargne");
+    case ColonneDescription:
+      return QString::fromStdString (compte.reqDescription ());
+    case ColonneSolde:
+      return QString::number (compte.reqSolde (), 'f', 2);
+    case ColonneTauxInteret:
+      return QString::number (compte.reqTauxInteret (), 'f', 2) + " %";
+    case ColonneInteret:
+      return QString::number (compte.calculerInteret (), 'f', 2);
+    default:
+      return QVariant();
+    }
+}
+
+
+QVariant ModeleComptes::headerData (int p_section, Qt::Orientation p_orientation, int p_role) const
+{
+  if (p_role != Qt::DisplayRole || p_orientation != Qt::Horizontal)
+    {
+      return QAbstractTableModel::headerData (p_section, p_orientation, p_role);
+    }
+  switch (p_section)
+    {
+    case ColonneNoCompte:
+      return QString("Numero");
+    case ColonneType:
+      return QString("Type");
+    case ColonneDescription:
+      return QString("Description");
+    case ColonneSolde:
+      return QString("Solde");
+    case ColonneTauxInteret:
+      return QString("Taux d'interet");
+    case ColonneInteret:
+      return QString("Interet");
+    default:
+      return QVariant();
+    }
+}
+
+
+/**
+ * Ajoute le compte au client, puis une seule ligne à la fin du modèle.
+ * Lève CompteDejaPresentException comme Client::ajouterCompte ; le modèle est
+ * alors inchangé.
+ */
+void ModeleComptes::ajouterCompte (const bancaire::Compte& p_compte)
+{
+  m_client.ajouterCompte (p_compte);
+  int ligne = rowCount ();
+  beginInsertRows (QModelIndex(), ligne, ligne);
+  // Accès en lecture : seul l'accès modifiable remplace un compte partagé
+  // (avec l'instantané d'un relevé) par son clone.
+  m_lignes.push_back (&std::as_const (m_client).reqCompte (p_compte.reqNoCompte ()));
+  endInsertRows ();
+}
+
+
+/**
+ * Retire la seule ligne du compte, puis le compte du client.
+ * Lève CompteAbsentException comme Client::supprimerCompte.
+ */
+void ModeleComptes::supprimerCompte (int p_noCompte)
+{
+  int ligne = reqLigne (p_noCompte);
+  if (ligne < 0)
+    {
+      m_client.supprimerCompte (p_noCompte);
+      return;
+    }
+  beginRemoveRows (QModelIndex(), ligne, ligne);
+  m_lignes.erase (m_lignes.begin () + ligne);
+  m_client.supprimerCompte (p_noCompte);
+  endRemoveRows ();
+}
+
+
+int ModeleComptes::reqLigne (int p_noCompte) const
+{
+  for (size_t i = 0; i < m_lignes.size (); ++i)
+    {
+      if (m_lignes[i]->reqNoCompte () == p_noCompte)
+        {
+          return static_cast<int> (i);
+        }
+    }
+  return -1;
+}
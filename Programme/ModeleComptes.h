@@ -0,0 +1,50 @@
+/*
+ * File:   ModeleComptes.h
+ * Author: etudiant
+ *
+ * Modèle Qt des comptes d'un client. Chaque ajout ou suppression ne signale
+ * que la ligne touchée, et une cellule n'est formatée que lorsque la vue
+ * l'affiche : le coût d'une modification ne dépend plus du nombre de comptes.
+ */
+
+#ifndef _MODELECOMPTES_H
+#define _MODELECOMPTES_H
+
+#include <QAbstractTableModel>
+#include <vector>
+#include "Client.h"
+
+class ModeleComptes : public QAbstractTableModel
+{
+public:
+  enum Colonne
+  {
+    ColonneNoCompte,
+    ColonneType,
+    ColonneDescription,
+    ColonneSolde,
+    ColonneTauxInteret,
+    ColonneInteret,
+    NombreColonnes
+  };
+
+  explicit ModeleComptes (bancaire::Client& p_client, QObject* p_parent = nullptr);
+
+  int rowCount (const QModelIndex& p_parent = QModelIndex ()) const override;
+  int columnCount (const QModelIndex& p_parent = QModelIndex ()) const override;
+  QVariant data (const QModelIndex& p_index, int p_role = Qt::DisplayRole) const override;
+  QVariant headerData (int p_section, Qt::Orientation p_orientation,
+                       int p_role = Qt::DisplayRole) const override;
+
+  void ajouterCompte (const bancaire::Compte& p_compte);
+  void supprimerCompte (int p_noCompte);
+
+private:
+  int reqLigne (int p_noCompte) const;
+
+  bancaire::Client& m_client;
+  // Comptes du client dans l'ordre des lignes ; ils appartiennent au client.
+  std::vector<const bancaire::Compte*> m_lignes;
+};
+
+#endif /* _MODELECOMPTES_H */
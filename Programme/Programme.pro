@@ -0,0 +1,38 @@
+# Projet qmake de l'interface graphique et du mode --lot.
+# Les sources de Sources/ sont compilées avec le programme ; QtConcurrent
+# sert au rendu du relevé hors du fil de l'interface (Accueil).
+
+TEMPLATE = app
+TARGET = Programme
+
+QT += core gui widgets concurrent
+CONFIG += c++17 thread
+
+INCLUDEPATH += ../Sources
+
+HEADERS += \
+    Accueil.h \
+    AjoutCheque.h \
+    AjoutEpargne.h \
+    FonctionsEntree.h \
+    ModeleComptes.h \
+    SupprimerCompte.h \
+    $$files(../Sources/*.h)
+
+SOURCES += \
+    main.cpp \
+    Accueil.cpp \
+    AjoutCheque.cpp \
+    AjoutEpargne.cpp \
+    FonctionsEntree.cpp \
+    ModeleComptes.cpp \
+    SupprimerCompte.cpp \
+    $$files(../Sources/*.cpp)
+
+FORMS += \
+    Accueil.ui \
+    AjoutCheque.ui \
+    AjoutEpargne.ui \
+    SupprimerCompte.ui
+
+CONFIG(release, debug|release): DEFINES += NDEBUG
@@ -7,11 +7,104 @@
 
 #include <QApplication>
 #include <qt5/QtWidgets/qwidget.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
 #include "Accueil.h"
+#include "Banque.h"
+#include "ExecuteurLot.h"
+#include "GroupeValidation.h"
+#include "Recuperation.h"
+#include <memory>
+
+/**
+ * Affiche l'usage du programme
+ */
+static void
+afficherAide (std::ostream& p_sortie, const char* p_programme)
+{
+  p_sortie << "Usage : " << p_programme << " [--lot <script> [--journal <fichier>]]\n"
+          "  sans option           ouvre l'interface graphique\n"
+          "  --lot <script>        execute un script d'operations (- pour l'entree standard),\n"
+          "                        voir ExecuteurLot.h pour son format\n"
+          "  --journal <fichier>   relit la banque depuis ce journal des transactions puis y\n"
+          "                        consigne chaque operation ; sans journal, le lot s'execute\n"
+          "                        sur une banque vide en memoire et rien n'est conserve\n"
+          "                        (essai a blanc ou test de charge)" << std::endl;
+}
+
+/**
+ * Mode sans interface : Programme --lot <script> (ou - pour l'entrée standard)
+ * exécute le script ; voir ExecuteurLot.h pour son format. Avec --journal, la
+ * banque est d'abord reconstruite par Recuperation, puis chaque opération est
+ * rendue durable par un GroupeValidation ; sans journal, le lot s'exécute sur
+ * une banque vide et ne laisse aucune trace : c'est un essai à blanc.
+ */
+static int
+executerLot (const char* p_script, const char* p_journal)
+{
+  std::ifstream fichier;
+  std::istream* script = &std::cin;
+  if (std::strcmp (p_script, "-") != 0)
+    {
+      fichier.open (p_script);
+      if (!fichier)
+        {
+          std::cerr << "Ouverture impossible : " << p_script << std::endl;
+          return 2;
+        }
+      script = &fichier;
+    }
+  std::ios::sync_with_stdio (false);
+
+  bancaire::Banque banque;
+  std::unique_ptr<bancaire::GroupeValidation> journal;
+  if (p_journal != nullptr)
+    {
+      try
+        {
+          banque = bancaire::Recuperation().recuperer (p_journal);
+          journal = std::make_unique<bancaire::GroupeValidation> (p_journal);
+        }
+      catch (const std::exception& erreur)
+        {
+          std::cerr << "Journal inutilisable : " << p_journal << " : " << erreur.what () << std::endl;
+          return 2;
+        }
+      banque.asgJournal (journal.get ());
+    }
+  else
+    {
+      std::cerr << "Aucun journal : essai a blanc, les operations ne sont pas conservees" << std::endl;
+    }
+  bancaire::BilanLot bilan = bancaire::ExecuteurLot(banque).executer (*script, &std::cerr);
+  std::cout << bilan.lignes << " lignes, " << bilan.executees << " operations, "
+          << bilan.erreurs << " erreurs, " << banque.reqNombreClients () << " clients" << std::endl;
+  return bilan.erreurs == 0 ? 0 : 1;
+}
 
 int
 main (int argc, char *argv[])
 {
+  if (argc == 2 && (std::strcmp (argv[1], "--help") == 0 || std::strcmp (argv[1], "-h") == 0))
+    {
+      afficherAide (std::cout, argv[0]);
+      return 0;
+    }
+  if (argc >= 2 && std::strcmp (argv[1], "--lot") == 0)
+    {
+      if (argc == 3)
+        {
+          return executerLot (argv[2], nullptr);
+        }
+      if (argc == 5 && std::strcmp (argv[3], "--journal") == 0)
+        {
+          return executerLot (argv[2], argv[4]);
+        }
+      afficherAide (std::cerr, argv[0]);
+      return 2;
+    }
+
   // initialize resources, if needed
   // Q_INIT_RESOURCE(resfile);
 
@@ -15,8 +15,9 @@
 #include <QtWidgets/QMainWindow>
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QMenuBar>
+#include <QtWidgets/QPlainTextEdit>
 #include <QtWidgets/QStatusBar>
-#include <QtWidgets/QTextEdit>
+#include <QtWidgets/QTableView>
 #include <QtWidgets/QWidget>
 
 QT_BEGIN_NAMESPACE
@@ -29,7 +30,8 @@ public:
     QAction *actionEpargne;
     QAction *actionCheque;
     QWidget *centralwidget;
-    QTextEdit *textEditReleveClient;
+    QTableView *tableViewComptes;
+    QPlainTextEdit *plainTextEditReleve;
     QMenuBar *menubar;
     QMenu *menuMenu;
     QMenu *menuAjouter_un_Compte;
@@ -50,9 +52,12 @@ public:
         actionCheque->setObjectName(QString::fromUtf8("actionCheque"));
         centralwidget = new QWidget(Accueil);
         centralwidget->setObjectName(QString::fromUtf8("centralwidget"));
-        textEditReleveClient = new QTextEdit(centralwidget);
-        textEditReleveClient->setObjectName(QString::fromUtf8("textEditReleveClient"));
-        textEditReleveClient->setGeometry(QRect(50, 40, 611, 491));
+        tableViewComptes = new QTableView(centralwidget);
+        tableViewComptes->setObjectName(QString::fromUtf8("tableViewComptes"));
+        tableViewComptes->setGeometry(QRect(50, 40, 611, 241));
+        plainTextEditReleve = new QPlainTextEdit(centralwidget);
+        plainTextEditReleve->setObjectName(QString::fromUtf8("plainTextEditReleve"));
+        plainTextEditReleve->setGeometry(QRect(50, 290, 611, 241));
         Accueil->setCentralWidget(centralwidget);
         menubar = new QMenuBar(Accueil);
         menubar->setObjectName(QString::fromUtf8("menubar"));
@@ -0,0 +1,272 @@
+/**
+ * \file ArenaComptes.cpp
+ * \brief Implantation de la classe ArenaComptes
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "ArenaComptes.h"
+#include "ContratException.h"
+#include <new>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief En-tête placé devant chaque objet : l'arène d'origine, ou nullptr
+ *        pour un objet pris sur le tas. Sa taille préserve l'alignement maximal.
+ */
+const size_t TAILLE_ENTETE = alignof (max_align_t) > sizeof (void*) ? alignof (max_align_t) : sizeof (void*);
+
+
+size_t
+arrondir (size_t p_taille)
+{
+  return (p_taille + alignof (max_align_t) - 1) & ~(alignof (max_align_t) - 1);
+}
+} //namespace
+
+
+thread_local ArenaComptes* ArenaComptes::s_courante = nullptr;
+
+
+/**
+ * \brief Crée une arène vide
+ * \param[in] p_tailleBloc taille des blocs réservés au système
+ * \return la première référence vers l'arène
+ * \pre p_tailleBloc doit être supérieur à zéro
+ */
+ArenaComptes::Reference ArenaComptes::creer(std::size_t p_tailleBloc)
+{
+  PRECONDITION(p_tailleBloc>0);
+  return Reference(new ArenaComptes(p_tailleBloc));
+}
+
+
+/**
+ * \brief Constructeur privé, les arènes sont créées par ArenaComptes::creer
+ * \param[in] p_tailleBloc taille des blocs réservés au système
+ */
+ArenaComptes::ArenaComptes(std::size_t p_tailleBloc):
+        m_tailleBloc(p_tailleBloc), m_proprietaire(), m_portees(0), m_courant(nullptr), m_fin(nullptr),
+        m_octetsReserves(0), m_references(0) { }
+
+
+/**
+ * \brief Retourne le nombre de blocs réservés par l'arène
+ * \return le nombre de blocs
+ */
+std::size_t ArenaComptes::reqNombreBlocs() const
+{
+  return m_blocs.size ();
+}
+
+
+/**
+ * \brief Retourne le nombre d'octets distribués par l'arène, en-têtes compris
+ * \return le nombre d'octets réservés aux objets
+ */
+std::size_t ArenaComptes::reqOctetsReserves() const
+{
+  return m_octetsReserves;
+}
+
+
+/**
+ * \brief Alloue la mémoire d'un compte dans l'arène du fil courant, ou sur le tas
+ *        si aucune portée n'est active
+ * \param[in] p_taille taille de l'objet
+ * \return l'adresse de l'objet
+ * \exception std::bad_alloc si la mémoire est épuisée
+ */
+void* ArenaComptes::allouer(std::size_t p_taille)
+{
+  ArenaComptes* arena = s_courante;
+  char* debut = nullptr;
+  if (arena != nullptr)
+    {
+      debut = arena->reserver (TAILLE_ENTETE + arrondir (p_taille));
+      arena->acquerir ();
+    }
+  else
+    {
+      debut = static_cast<char*> (::operator new(TAILLE_ENTETE + p_taille));
+    }
+  *reinterpret_cast<ArenaComptes**> (debut) = arena;
+  return debut + TAILLE_ENTETE;
+}
+
+
+/**
+ * \brief Libère la mémoire d'un compte alloué par ArenaComptes::allouer
+ *        Un objet d'arène ne fait que relâcher sa référence vers l'arène.
+ * \param[in] p_objet l'adresse de l'objet, ou nullptr
+ */
+void ArenaComptes::liberer(void* p_objet) noexcept
+{
+  if (p_objet == nullptr)
+    {
+      return;
+    }
+  char* debut = static_cast<char*> (p_objet) - TAILLE_ENTETE;
+  ArenaComptes* arena = *reinterpret_cast<ArenaComptes**> (debut);
+  if (arena != nullptr)
+    {
+      arena->relacher ();
+    }
+  else
+    {
+      ::operator delete(debut);
+    }
+}
+
+
+/**
+ * \brief Réserve une zone contiguë, en ouvrant un nouveau bloc au besoin
+ * \param[in] p_taille taille arrondie de la zone
+ * \return le début de la zone
+ */
+char* ArenaComptes::reserver(std::size_t p_taille)
+{
+  if (static_cast<size_t> (m_fin - m_courant) < p_taille)
+    {
+      size_t taille = p_taille > m_tailleBloc ? p_taille : m_tailleBloc;
+      m_blocs.emplace_back (new char[taille]);
+      m_courant = m_blocs.back ().get ();
+      m_fin = m_courant + taille;
+    }
+  char* zone = m_courant;
+  m_courant += p_taille;
+  m_octetsReserves += p_taille;
+  return zone;
+}
+
+
+/**
+ * \brief Ajoute une référence (objet vivant ou Reference) vers l'arène
+ */
+void ArenaComptes::acquerir() noexcept
+{
+  m_references.fetch_add (1, memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retire une référence ; la dernière rend tous les blocs d'un coup
+ */
+void ArenaComptes::relacher() noexcept
+{
+  if (m_references.fetch_sub (1, memory_order_acq_rel) == 1)
+    {
+      delete this;
+    }
+}
+
+
+/**
+ * \brief Constructeur d'une référence vide
+ */
+ArenaComptes::Reference::Reference() noexcept: m_arena(nullptr) { }
+
+
+/**
+ * \brief Constructeur privé, prend une nouvelle référence vers une arène
+ * \param[in] p_arena l'arène référencée
+ */
+ArenaComptes::Reference::Reference(ArenaComptes* p_arena) noexcept: m_arena(p_arena)
+{
+  m_arena->acquerir ();
+}
+
+
+/**
+ * \brief Constructeur copie, partage la même arène
+ * \param[in] p_reference la référence copiée
+ */
+ArenaComptes::Reference::Reference(const Reference& p_reference) noexcept: m_arena(p_reference.m_arena)
+{
+  if (m_arena != nullptr)
+    {
+      m_arena->acquerir ();
+    }
+}
+
+
+/**
+ * \brief Opérateur d'assignation
+ * \param[in] p_reference la référence assignée
+ */
+ArenaComptes::Reference& ArenaComptes::Reference::operator=(Reference p_reference) noexcept
+{
+  std::swap (m_arena, p_reference.m_arena);
+  return *this;
+}
+
+
+/**
+ * \brief Destructeur, relâche la référence vers l'arène
+ */
+ArenaComptes::Reference::~Reference()
+{
+  if (m_arena != nullptr)
+    {
+      m_arena->relacher ();
+    }
+}
+
+
+/**
+ * \brief Accès à l'arène référencée
+ * \return l'arène
+ */
+ArenaComptes& ArenaComptes::Reference::operator*() const noexcept
+{
+  return *m_arena;
+}
+
+
+/**
+ * \brief Accès aux membres de l'arène référencée
+ * \return l'adresse de l'arène
+ */
+ArenaComptes* ArenaComptes::Reference::operator->() const noexcept
+{
+  return m_arena;
+}
+
+
+/**
+ * \brief Active une arène pour les allocations de comptes du fil courant
+ *        Le fil devient propriétaire de l'arène jusqu'à la fin de sa dernière portée.
+ * \param[in] p_arena l'arène à utiliser
+ * \pre aucun autre fil ne doit avoir de portée active sur p_arena
+ */
+ArenaComptes::Portee::Portee(ArenaComptes& p_arena): m_arena(p_arena), m_precedente(s_courante)
+{
+  const thread::id fil = this_thread::get_id ();
+  thread::id proprietaire;
+  [[maybe_unused]] const bool libre = p_arena.m_proprietaire.compare_exchange_strong (proprietaire, fil)
+          || proprietaire == fil;
+  PRECONDITION(libre);
+
+  ++p_arena.m_portees;
+  s_courante = &p_arena;
+}
+
+
+/**
+ * \brief Rétablit l'arène active avant la portée, et libère l'arène pour
+ *        les autres fils si c'était la dernière portée
+ */
+ArenaComptes::Portee::~Portee()
+{
+  s_courante = m_precedente;
+  if (--m_arena.m_portees == 0)
+    {
+      m_arena.m_proprietaire.store (thread::id(), memory_order_release);
+    }
+}
+
+} //namespace bancaire
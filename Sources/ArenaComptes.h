@@ -0,0 +1,162 @@
+/**
+ * \file ArenaComptes.h
+ * \brief Fichier qui contient l'interface de la classe ArenaComptes.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef ARENACOMPTES_H
+#define ARENACOMPTES_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \class ArenaComptes
+ * \brief Mémoire des comptes construits en masse, libérée d'un seul coup.
+ *
+ * Tant qu'une ArenaComptes::Portee est active dans un fil, les comptes créés
+ * par ce fil (Compte::operator new) sont pris par simple avancement d'un
+ * pointeur dans de grands blocs. Détruire un tel compte ne libère rien :
+ * l'arène compte ses objets vivants et rend tous ses blocs au système quand
+ * le dernier objet et la dernière Reference disparaissent. L'ordre de
+ * destruction entre l'arène et ses comptes est donc sans importance.
+ *
+ * Contrat de fils : l'arène ne prend aucun verrou pour réserver. Un seul fil
+ * à la fois peut y avoir des Portee actives ; le constructeur de Portee le
+ * vérifie par précondition. Un autre fil peut la reprendre une fois la
+ * dernière portée du premier détruite. Les comptes, eux, peuvent être
+ * détruits dans n'importe quel fil.
+ *
+ * Pour retrouver leur arène à la destruction, tous les comptes portent un
+ * en-tête de la taille de l'alignement maximal (16 octets sur x86-64), y
+ * compris ceux pris sur le tas hors de toute portée.
+ */
+class ArenaComptes
+{
+public:
+  class Reference;
+  class Portee;
+  template<typename T> class Allocateur;
+
+  static Reference creer(std::size_t p_tailleBloc=1 << 20);
+
+  std::size_t reqNombreBlocs() const;
+  std::size_t reqOctetsReserves() const;
+
+  static void* allouer(std::size_t p_taille);
+  static void liberer(void* p_objet) noexcept;
+
+private:
+  explicit ArenaComptes(std::size_t p_tailleBloc);
+  char* reserver(std::size_t p_taille);
+  void acquerir() noexcept;
+  void relacher() noexcept;
+
+  static thread_local ArenaComptes* s_courante;
+
+  const std::size_t m_tailleBloc;
+  std::atomic<std::thread::id> m_proprietaire;
+  unsigned m_portees;
+  std::vector<std::unique_ptr<char[]>> m_blocs;
+  char* m_courant;
+  char* m_fin;
+  std::size_t m_octetsReserves;
+  std::atomic<std::size_t> m_references;
+};
+
+
+/**
+ * \class ArenaComptes::Reference
+ * \brief Garde une arène en vie tant qu'on peut encore y allouer.
+ */
+class ArenaComptes::Reference
+{
+public:
+  Reference() noexcept;
+  Reference(const Reference& p_reference) noexcept;
+  Reference& operator=(Reference p_reference) noexcept;
+  ~Reference();
+
+  ArenaComptes& operator*() const noexcept;
+  ArenaComptes* operator->() const noexcept;
+
+private:
+  friend class ArenaComptes;
+  explicit Reference(ArenaComptes* p_arena) noexcept;
+  ArenaComptes* m_arena;
+};
+
+
+/**
+ * \class ArenaComptes::Portee
+ * \brief Dirige les allocations de comptes du fil courant vers une arène.
+ *
+ * Les portées s'imbriquent ; la destruction rétablit l'arène précédente.
+ * Toutes les portées actives d'une arène appartiennent au même fil.
+ */
+class ArenaComptes::Portee
+{
+public:
+  explicit Portee(ArenaComptes& p_arena);
+  ~Portee();
+  Portee(const Portee&)=delete;
+  Portee& operator=(const Portee&)=delete;
+
+private:
+  ArenaComptes& m_arena;
+  ArenaComptes* m_precedente;
+};
+
+
+/**
+ * \class ArenaComptes::Allocateur
+ * \brief Allocateur standard qui passe par ArenaComptes::allouer.
+ *
+ * Sert aux blocs de contrôle des std::shared_ptr qui possèdent des comptes :
+ * dans une Portee, le bloc est pris dans l'arène comme le compte lui-même,
+ * et ne coûte ni appel au tas ni libération individuelle.
+ */
+template<typename T>
+class ArenaComptes::Allocateur
+{
+public:
+  typedef T value_type;
+
+  Allocateur() noexcept { }
+  template<typename U>
+  Allocateur(const Allocateur<U>&) noexcept { }
+
+  T*
+  allocate (std::size_t p_nombre)
+  {
+    return static_cast<T*> (ArenaComptes::allouer (p_nombre * sizeof (T)));
+  }
+
+  void
+  deallocate (T* p_objet, std::size_t) noexcept
+  {
+    ArenaComptes::liberer (p_objet);
+  }
+
+  template<typename U>
+  bool
+  operator== (const Allocateur<U>&) const noexcept
+  {
+    return true;
+  }
+
+  template<typename U>
+  bool
+  operator!= (const Allocateur<U>&) const noexcept
+  {
+    return false;
+  }
+};
+} //namespace bancaire
+
+#endif /* ARENACOMPTES_H */
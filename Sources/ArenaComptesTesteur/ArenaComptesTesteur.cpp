@@ -0,0 +1,166 @@
+/**
+ * \file ArenaComptesTesteur.cpp
+ * \brief Test unitaire de la classe ArenaComptes.
+ *
+ * À tester :
+ *         static Reference creer(std::size_t p_tailleBloc);
+ *         Portee(ArenaComptes& p_arena);
+ *         std::size_t reqNombreBlocs() const;
+ *         std::size_t reqOctetsReserves() const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ArenaComptes.h"
+#include "Cheque.h"
+#include "Client.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace bancaire;
+using namespace std;
+
+
+/**
+ * \brief Test de la méthode static Reference creer(std::size_t p_tailleBloc);
+ *     Cas valide : une arène neuve n'a réservé aucun bloc.
+ *     Cas invalide : une taille de bloc nulle.
+ */
+TEST(ArenaComptes, creer_TailleValide_ArenaVide)
+{
+  ArenaComptes::Reference arena = ArenaComptes::creer ();
+  ASSERT_EQ(0u, arena->reqNombreBlocs ());
+  ASSERT_EQ(0u, arena->reqOctetsReserves ());
+}
+
+TEST(ArenaComptes, creer_TailleNulle_PreconditionException)
+{
+  ASSERT_THROW(ArenaComptes::creer (0), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la classe Portee
+ *     Cas valides : les comptes créés dans la portée sont pris dans l'arène,
+ *                   ceux créés après la portée sont pris sur le tas ;
+ *                   les portées imbriquées rétablissent l'arène précédente ;
+ *                   les blocs de contrôle des comptes confiés à un client
+ *                   dans la portée sont eux aussi pris dans l'arène ; un
+ *                   autre fil reprend l'arène une fois la dernière portée
+ *                   du premier détruite.
+ *     Cas invalide : une portée sur une arène dont un autre fil a une portée active.
+ */
+TEST(ArenaComptes, Portee_ComptesCrees_PrisDansArena)
+{
+  ArenaComptes::Reference arena = ArenaComptes::creer (4096);
+  vector<unique_ptr<Compte>> comptes;
+  {
+    ArenaComptes::Portee portee(*arena);
+    for (int noCompte = 1; noCompte <= 100; ++noCompte)
+      {
+        comptes.push_back (make_unique<Epargne>(noCompte, 1.5, 100.0, "Epargne"));
+      }
+  }
+  size_t octets = arena->reqOctetsReserves ();
+  ASSERT_GE(octets, 100 * sizeof (Epargne));
+  ASSERT_GT(arena->reqNombreBlocs (), 1u);
+
+  comptes.push_back (make_unique<Cheque>(101, 5, 100.0, 2.0, "Cheque", 1.0));
+  ASSERT_EQ(octets, arena->reqOctetsReserves ());
+}
+
+TEST(ArenaComptes, Portee_ComptesConfiesAuClient_BlocsDeControleDansArena)
+{
+  ArenaComptes::Reference arena = ArenaComptes::creer ();
+  Client client(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983));
+  size_t octetsComptes = 0;
+  {
+    ArenaComptes::Portee portee(*arena);
+    vector<unique_ptr<Compte>> comptes;
+    for (int noCompte = 1; noCompte <= 100; ++noCompte)
+      {
+        comptes.push_back (make_unique<Epargne>(noCompte, 1.5, 100.0, "Epargne"));
+      }
+    octetsComptes = arena->reqOctetsReserves ();
+    client.ajouterComptesEnBloc (move (comptes));
+  }
+  ASSERT_GE(arena->reqOctetsReserves (), octetsComptes + 100 * 2 * sizeof (void*));
+  ASSERT_EQ(100u, client.reqComptes ());
+}
+
+TEST(ArenaComptes, Portee_Imbriquee_ArenaPrecedenteRetablie)
+{
+  ArenaComptes::Reference externe = ArenaComptes::creer ();
+  ArenaComptes::Reference interne = ArenaComptes::creer ();
+  ArenaComptes::Portee porteeExterne(*externe);
+  {
+    ArenaComptes::Portee porteeInterne(*interne);
+    Epargne* compte = new Epargne(1, 1.5, 100.0, "Interne");
+    delete compte;
+  }
+  Epargne* compte = new Epargne(2, 1.5, 100.0, "Externe");
+  delete compte;
+  ASSERT_GT(interne->reqOctetsReserves (), 0u);
+  ASSERT_EQ(interne->reqOctetsReserves (), externe->reqOctetsReserves ());
+}
+
+
+TEST(ArenaComptes, Portee_ArenaDUnAutreFil_PreconditionException)
+{
+  ArenaComptes::Reference arena = ArenaComptes::creer ();
+  bool refusee = false;
+  {
+    ArenaComptes::Portee portee(*arena);
+    thread autre([&arena, &refusee] ()
+    {
+      try
+        {
+          ArenaComptes::Portee concurrente(*arena);
+        }
+      catch (const PreconditionException&)
+        {
+          refusee = true;
+        }
+    });
+    autre.join ();
+  }
+  ASSERT_TRUE(refusee);
+
+  bool reprise = false;
+  thread autre([&arena, &reprise] ()
+  {
+    ArenaComptes::Portee portee(*arena);
+    delete new Epargne(1, 1.5, 100.0, "Autre fil");
+    reprise = true;
+  });
+  autre.join ();
+  ASSERT_TRUE(reprise);
+}
+
+
+/**
+ * \brief Test de la durée de vie de l'arène
+ *     Cas valide : les comptes d'un client survivent à la dernière référence
+ *                  vers l'arène, et les copies du client sont indépendantes de l'arène.
+ *     Cas invalide : aucun
+ */
+TEST(ArenaComptes, Reference_RelacheeAvantComptes_ComptesUtilisables)
+{
+  Client client(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983));
+  {
+    ArenaComptes::Reference arena = ArenaComptes::creer ();
+    ArenaComptes::Portee portee(*arena);
+    vector<unique_ptr<Compte>> comptes;
+    comptes.push_back (make_unique<Epargne>(1, 1.5, 100.0, "Epargne"));
+    comptes.push_back (make_unique<Cheque>(2, 5, 200.0, 2.0, "Cheque", 1.0));
+    client.ajouterComptesEnBloc (move (comptes));
+  }
+  Client copie(client);
+  ASSERT_EQ(200.0, client.reqCompte (2).reqSolde ());
+  client.viderComptes ();
+  ASSERT_EQ(2u, copie.reqComptes ());
+  ASSERT_EQ(100.0, copie.reqCompte (1).reqSolde ());
+}
@@ -0,0 +1,364 @@
+/**
+ * \file Banque.cpp
+ * \brief Implantation de la classe Banque
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "Banque.h"
+#include "Cheque.h"
+#include "ClientException.h"
+#include "CompteException.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "GroupeValidation.h"
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Clé d'une date dans l'index des naissances : aaaammjj, qui croît avec la date
+ */
+int64_t
+cleDate (const util::Date& p_date)
+{
+  return static_cast<int64_t> (p_date.reqAnnee ()) * 10000 + p_date.reqMois () * 100 + p_date.reqJour ();
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe Banque
+ *        On construit une banque sans client ni journal.
+ */
+Banque::Banque(): m_journal(nullptr) { }
+
+
+/**
+ * \brief Constructeur copie
+ *        La copie a ses propres versions : si la banque copiée publie ses
+ *        clients, la copie publie les siens dans un nouveau VersionsClients.
+ *        La copie n'a pas de journal : partager celui de la banque copiée y
+ *        mêlerait les mutations de deux banques. L'appelant qui veut rendre
+ *        durables les mutations de la copie doit appeler asgJournal.
+ * \param[in] p_banque la banque à copier
+ */
+Banque::Banque(const Banque& p_banque):
+        m_clients(p_banque.m_clients), m_indexNoms(p_banque.m_indexNoms),
+        m_indexTelephones(p_banque.m_indexTelephones), m_indexNaissances(p_banque.m_indexNaissances),
+        m_journal(nullptr)
+{
+  if (p_banque.m_versions != nullptr)
+    {
+      activerInstantanes ();
+    }
+}
+
+
+/**
+ * \brief Opérateur d'assignation
+ *        Les instantanés de la banque assignée doivent avoir été détruits.
+ *        Comme une copie, la banque assignée n'a plus de journal ensuite.
+ * \param[in] p_banque la banque à copier
+ * \return une référence vers la banque assignée
+ */
+Banque& Banque::operator=(const Banque& p_banque)
+{
+  if (this != &p_banque)
+    {
+      Banque copie(p_banque);
+      *this = std::move (copie);
+    }
+  return *this;
+}
+
+
+/**
+ * \brief Retourne le nombre de clients de la banque
+ * \return un size_t qui représente le nombre de clients
+ */
+std::size_t Banque::reqNombreClients() const
+{
+  return m_clients.size ();
+}
+
+
+/**
+ * \brief Vérifie si un client avec un numéro de folio donné fait partie de la banque
+ * \param[in] p_noFolio Le numéro de folio à vérifier.
+ * \return true si le client est présent, false sinon.
+ */
+bool Banque::clientEstPresent(int p_noFolio) const
+{
+  return m_clients.count (p_noFolio) != 0;
+}
+
+
+/**
+ * \brief Retourne un client à partir de son numéro de folio
+ * \param[in] p_noFolio Le numéro de folio du client.
+ * \return une référence constante vers le client
+ * \exception ClientAbsentException Levée si aucun client ne correspond au folio fourni.
+ */
+const Client& Banque::reqClient(int p_noFolio) const
+{
+  auto it = m_clients.find (p_noFolio);
+  if (it == m_clients.end ())
+    {
+      throw ClientAbsentException("Il n'existe aucun client avec le folio " + to_string (p_noFolio));
+    }
+  return it->second;
+}
+
+
+/**
+ * \brief Retourne l'ensemble des clients, ordonnés par numéro de folio
+ * \return une référence constante vers les clients de la banque
+ */
+const std::map<int, Client>& Banque::reqClients() const
+{
+  return m_clients;
+}
+
+
+/**
+ * \brief Retourne l'index des clients par nom, tenu à jour à chaque ajout de client
+ * \return une référence constante vers l'index
+ */
+const IndexNoms& Banque::reqIndexNoms() const
+{
+  return m_indexNoms;
+}
+
+
+/**
+ * \brief Retourne l'index des clients par téléphone, tenu à jour à chaque ajout de client
+ * \return une référence constante vers l'index
+ */
+const IndexTelephones& Banque::reqIndexTelephones() const
+{
+  return m_indexTelephones;
+}
+
+
+/**
+ * \brief Visite, par folio croissant, les clients dont le folio est dans un intervalle
+ * \param[in] p_folioMinimum le plus petit folio retenu
+ * \param[in] p_folioMaximum le plus grand folio retenu
+ * \param[in] p_visiteur la fonction appelée pour chaque client retenu
+ * \pre p_folioMinimum <= p_folioMaximum
+ */
+void Banque::parcourirClients(int p_folioMinimum, int p_folioMaximum,
+                              const std::function<void(const Client&)>& p_visiteur) const
+{
+  PRECONDITION(p_folioMinimum <= p_folioMaximum);
+
+  for (auto it = m_clients.lower_bound (p_folioMinimum); it != m_clients.end () && it->first <= p_folioMaximum; ++it)
+    {
+      p_visiteur (it->second);
+    }
+}
+
+
+/**
+ * \brief Visite, par date de naissance puis par folio croissants, les clients
+ *        nés dans un intervalle de dates
+ *        Seuls les clients de l'intervalle sont lus, grâce à l'index des
+ *        naissances tenu à jour à chaque ajout de client.
+ * \param[in] p_debut la première date de naissance retenue
+ * \param[in] p_fin la dernière date de naissance retenue
+ * \param[in] p_visiteur la fonction appelée pour chaque client retenu
+ * \pre p_debut ne doit pas suivre p_fin
+ */
+void Banque::parcourirClientsParNaissance(const util::Date& p_debut, const util::Date& p_fin,
+                                          const std::function<void(const Client&)>& p_visiteur) const
+{
+  PRECONDITION(!(p_fin < p_debut));
+
+  m_indexNaissances.parcourir (cleDate (p_debut), cleDate (p_fin), [this, &p_visiteur] (int64_t, int p_noFolio)
+  {
+    p_visiteur (m_clients.find (p_noFolio)->second);
+  });
+}
+
+
+/**
+ * \brief Associe un journal qui rendra durables les mutations exécutées
+ * \param[in] p_journal le groupe de validation à utiliser, ou nullptr pour
+ *            ne plus journaliser ; il doit survivre à son utilisation par la banque
+ */
+void Banque::asgJournal(GroupeValidation* p_journal)
+{
+  m_journal = p_journal;
+}
+
+
+/**
+ * \brief Active les instantanés : tous les clients actuels sont publiés, puis
+ *        chaque client l'est de nouveau après chaque mutation acceptée
+ *        Sans effet si les instantanés sont déjà actifs.
+ */
+void Banque::activerInstantanes()
+{
+  if (m_versions != nullptr)
+    {
+      return;
+    }
+  m_versions = make_unique<VersionsClients>();
+  for (const auto& paire : m_clients)
+    {
+      m_versions->publier (paire.second);
+    }
+}
+
+
+/**
+ * \brief Épingle un instantané cohérent des clients, que l'on peut lire d'un
+ *        autre fil pendant que les mutations se poursuivent
+ * \return un instantané qui reflète toutes les mutations déjà appliquées ; il
+ *         ne doit pas survivre à la banque
+ * \pre les instantanés doivent avoir été activés
+ */
+VersionsClients::Instantane Banque::epingler() const
+{
+  PRECONDITION(m_versions != nullptr);
+
+  return m_versions->epingler ();
+}
+
+
+/**
+ * \brief Ajoute un client déjà construit, avec ses comptes, à la banque
+ *        Cette insertion n'est pas journalisée ; elle sert à construire une
+ *        banque en mémoire (récupération, chargement, jeux d'essai).
+ * \param[in] p_client le client à ajouter
+ * \exception ClientDejaPresentException Levée si un client a déjà ce numéro de folio.
+ * \post Le client est présent dans la banque.
+ */
+void Banque::ajouterClient(Client p_client)
+{
+  const int noFolio = p_client.reqNoFolio ();
+  auto insertion = m_clients.emplace (noFolio, move (p_client));
+  if (!insertion.second)
+    {
+      throw ClientDejaPresentException("Il existe deja un client avec le folio " + to_string (noFolio));
+    }
+  const Client& client = insertion.first->second;
+  m_indexNoms.ajouter (client.reqNom (), client.reqPrenom (), noFolio);
+  m_indexTelephones.ajouter (client.reqTelephone (), noFolio);
+  m_indexNaissances.ajouter (cleDate (client.reqDateNaissance ()), noFolio);
+  if (m_versions != nullptr)
+    {
+      m_versions->publier (client);
+    }
+
+  POSTCONDITION(clientEstPresent (noFolio));
+}
+
+
+/**
+ * \brief Applique une mutation puis la confie au journal s'il y en a un
+ *        La mutation n'est journalisée que si elle a été acceptée.
+ * \param[in] p_operation la mutation à exécuter
+ * \return un futur satisfait lorsque la mutation est durable (immédiatement
+ *         si aucun journal n'est associé)
+ * \exception ClientException, CompteException ou ContratException si la mutation est refusée
+ */
+std::future<void> Banque::executer(const EnregistrementJournal& p_operation)
+{
+  appliquer (p_operation);
+  if (m_journal != nullptr)
+    {
+      return m_journal->soumettre (p_operation);
+    }
+  promise<void> immediat;
+  immediat.set_value ();
+  return immediat.get_future ();
+}
+
+
+/**
+ * \brief Applique une mutation aux clients de la banque sans la journaliser
+ * \param[in] p_operation la mutation à appliquer
+ * \exception ClientDejaPresentException, ClientAbsentException si le folio ne convient pas
+ * \exception CompteDejaPresentException, CompteAbsentException si le numéro de compte ne convient pas
+ * \exception CompteException si la mutation ne convient pas au type ou au taux
+ *            minimum du compte visé (verifierMutationCompte) ; rien n'est modifié
+ */
+void Banque::appliquer(const EnregistrementJournal& p_operation)
+{
+  if (p_operation.type == TypeOperation::AsgSolde || p_operation.type == TypeOperation::AsgTauxInteret
+      || p_operation.type == TypeOperation::AsgNombreTransactions)
+    {
+      const Compte& compte = reqClient (p_operation.noFolio).reqCompte (p_operation.noCompte);
+      const Cheque* cheque = dynamic_cast<const Cheque*> (&compte);
+      const TypeOperation typeCompte = cheque != nullptr ? TypeOperation::AjoutCheque : TypeOperation::AjoutEpargne;
+      verifierMutationCompte (p_operation, typeCompte, cheque != nullptr ? cheque->reqTauxInteretMinimum () : 0);
+    }
+
+  switch (p_operation.type)
+    {
+    case TypeOperation::AjoutClient:
+      ajouterClient (Client(p_operation.noFolio, p_operation.nom, p_operation.prenom,
+                            p_operation.telephone,
+                            util::Date(p_operation.jour, p_operation.mois, p_operation.annee)));
+      break;
+    case TypeOperation::AjoutCheque:
+      reqClientModifiable (p_operation.noFolio).ajouterCompte (
+              Cheque(p_operation.noCompte, p_operation.nombreTransactions, p_operation.solde,
+                     p_operation.tauxInteret, p_operation.description,
+                     p_operation.tauxInteretMinimum));
+      break;
+    case TypeOperation::AjoutEpargne:
+      reqClientModifiable (p_operation.noFolio).ajouterCompte (
+              Epargne(p_operation.noCompte, p_operation.tauxInteret, p_operation.solde,
+                      p_operation.description));
+      break;
+    case TypeOperation::SuppressionCompte:
+      reqClientModifiable (p_operation.noFolio).supprimerCompte (p_operation.noCompte);
+      break;
+    case TypeOperation::AsgSolde:
+      reqClientModifiable (p_operation.noFolio).reqCompte (p_operation.noCompte)
+              .asgSolde (p_operation.solde);
+      break;
+    case TypeOperation::AsgTauxInteret:
+      reqClientModifiable (p_operation.noFolio).reqCompte (p_operation.noCompte)
+              .asgTauxInteret (p_operation.tauxInteret);
+      break;
+    case TypeOperation::AsgNombreTransactions:
+      {
+        Cheque* cheque = dynamic_cast<Cheque*> (
+                &reqClientModifiable (p_operation.noFolio).reqCompte (p_operation.noCompte));
+        if (cheque == nullptr)
+          {
+            throw CompteException("Le nombre de transactions ne s'applique qu'a un compte cheque");
+          }
+        cheque->asgNombreTransactions (p_operation.nombreTransactions);
+      }
+      break;
+    case TypeOperation::AsgDescription:
+      reqClientModifiable (p_operation.noFolio).reqCompte (p_operation.noCompte)
+              .asgDescription (p_operation.description);
+      break;
+    }
+  if (m_versions != nullptr && p_operation.type != TypeOperation::AjoutClient)
+    {
+      m_versions->publier (m_clients.find (p_operation.noFolio)->second);
+    }
+}
+
+
+/**
+ * \brief Retourne un client modifiable à partir de son numéro de folio
+ * \param[in] p_noFolio Le numéro de folio du client.
+ * \return une référence vers le client
+ * \exception ClientAbsentException Levée si aucun client ne correspond au folio fourni.
+ */
+Client& Banque::reqClientModifiable(int p_noFolio)
+{
+  return const_cast<Client&> (static_cast<const Banque&> (*this).reqClient (p_noFolio));
+}
+
+} //namespace bancaire
@@ -0,0 +1,81 @@
+/**
+ * \file Banque.h
+ * \brief Fichier qui contient l'interface de la classe Banque.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef BANQUE_H
+#define BANQUE_H
+
+#include "Client.h"
+#include "IndexNoms.h"
+#include "IndexOrdonne.h"
+#include "IndexTelephones.h"
+#include "Journal.h"
+#include "VersionsClients.h"
+#include <future>
+#include <map>
+#include <memory>
+
+namespace bancaire
+{
+class GroupeValidation;
+
+/**
+ * \class Banque
+ * \brief Cette classe regroupe les clients d'une banque, indexés par numéro de folio.
+ *
+ * Toute mutation passe par un EnregistrementJournal : la méthode executer
+ * l'applique aux clients puis, si un journal est associé, la confie au
+ * GroupeValidation pour la rendre durable. La méthode appliquer seule sert
+ * à la relecture du journal. Une copie n'a pas de journal tant que
+ * l'appelant ne lui en associe pas un par asgJournal.
+ *
+ * Une fois activerInstantanes appelée, chaque client ajouté ou modifié est
+ * aussi publié dans un VersionsClients : des lecteurs d'autres fils peuvent
+ * alors épingler un instantané cohérent sans jamais bloquer les mutations.
+ */
+class Banque
+{
+public:
+  Banque();
+  Banque(const Banque& p_banque);
+  Banque(Banque&&) = default;
+  Banque& operator=(const Banque& p_banque);
+  Banque& operator=(Banque&&) = default;
+
+  //accesseurs
+  std::size_t reqNombreClients() const;
+  bool clientEstPresent(int p_noFolio) const;
+  const Client& reqClient(int p_noFolio) const;
+  const std::map<int, Client>& reqClients() const;
+  const IndexNoms& reqIndexNoms() const;
+  const IndexTelephones& reqIndexTelephones() const;
+  void parcourirClients(int p_folioMinimum, int p_folioMaximum,
+                        const std::function<void(const Client&)>& p_visiteur) const;
+  void parcourirClientsParNaissance(const util::Date& p_debut, const util::Date& p_fin,
+                                    const std::function<void(const Client&)>& p_visiteur) const;
+
+  //mutateurs
+  void asgJournal(GroupeValidation* p_journal);
+  void activerInstantanes();
+
+  //methodes
+  void ajouterClient(Client p_client);
+  std::future<void> executer(const EnregistrementJournal& p_operation);
+  void appliquer(const EnregistrementJournal& p_operation);
+  VersionsClients::Instantane epingler() const;
+
+private:
+  Client& reqClientModifiable(int p_noFolio);
+
+  std::map<int, Client> m_clients;
+  IndexNoms m_indexNoms;
+  IndexTelephones m_indexTelephones;
+  IndexOrdonne m_indexNaissances;
+  std::unique_ptr<VersionsClients> m_versions;
+  GroupeValidation* m_journal;
+};
+} //namespace bancaire
+
+#endif /* BANQUE_H */
@@ -0,0 +1,267 @@
+/**
+ * \file BanqueTesteur.cpp
+ * \brief Test unitaire de la classe Banque.
+ *
+ * À tester :
+ *         std::size_t reqNombreClients() const;
+ *         bool clientEstPresent(int p_noFolio) const;
+ *         const Client& reqClient(int p_noFolio) const;
+ *         void ajouterClient(Client p_client);
+ *         const IndexNoms& reqIndexNoms() const;
+ *         const IndexTelephones& reqIndexTelephones() const;
+ *         void parcourirClients(int p_folioMinimum, int p_folioMaximum,
+ *                               const std::function<void(const Client&)>& p_visiteur) const;
+ *         void parcourirClientsParNaissance(const util::Date& p_debut, const util::Date& p_fin,
+ *                                           const std::function<void(const Client&)>& p_visiteur) const;
+ *         std::future<void> executer(const EnregistrementJournal& p_operation);
+ *         void appliquer(const EnregistrementJournal& p_operation);
+ *         void activerInstantanes();
+ *         VersionsClients::Instantane epingler() const;
+ *         Banque(const Banque& p_banque);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "Banque.h"
+#include "Cheque.h"
+#include "ClientException.h"
+#include "CompteException.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "GroupeValidation.h"
+#include "Journal.h"
+#include <cstdio>
+#include <unistd.h>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture utilisée pour les tests de la classe Banque
+ */
+class BanqueTest : public ::testing::Test
+{
+public:
+  BanqueTest():
+  f_client(2000, "Carlo", "Ancelotti", "590 234-0342", util::Date(20, 01, 1983))
+  {
+    f_banque.ajouterClient (f_client);
+  }
+
+  EnregistrementJournal operation(TypeOperation p_type, int p_noCompte)
+  {
+    EnregistrementJournal enregistrement;
+    enregistrement.type = p_type;
+    enregistrement.noFolio = 2000;
+    enregistrement.noCompte = p_noCompte;
+    return enregistrement;
+  }
+
+  Client f_client;
+  Banque f_banque;
+};
+
+
+/**
+ * \brief Test de la méthode void ajouterClient(Client p_client);
+ *     Cas valides : le client ajouté est retrouvé par son folio.
+ *     Cas invalides : un deuxième client avec le même folio est refusé.
+ */
+TEST_F(BanqueTest, ajouterClient_NouveauFolio_ClientPresent)
+{
+  ASSERT_EQ(1u, f_banque.reqNombreClients ());
+  ASSERT_TRUE(f_banque.clientEstPresent (2000));
+  ASSERT_EQ("Ancelotti", f_banque.reqClient (2000).reqPrenom ());
+}
+
+TEST_F(BanqueTest, ajouterClient_FolioDejaPresent_ClientDejaPresentException)
+{
+  ASSERT_THROW(f_banque.ajouterClient (f_client), ClientDejaPresentException);
+}
+
+TEST_F(BanqueTest, reqClient_FolioAbsent_ClientAbsentException)
+{
+  ASSERT_THROW(f_banque.reqClient (3000), ClientAbsentException);
+}
+
+
+/**
+ * \brief Test de la méthode std::future<void> executer(const EnregistrementJournal& p_operation);
+ *     Cas valides : les ajouts et mutations de comptes sont appliqués au client.
+ *     Cas invalides : une mutation d'un compte absent est refusée ; une mutation
+ *                     qui ne convient pas au compte visé (transactions ou solde
+ *                     négatif sur un compte épargne, taux chèque sous le minimum)
+ *                     lève CompteException, même sans contrats, sans rien modifier.
+ */
+TEST_F(BanqueTest, executer_MutationsValides_ComptesModifies)
+{
+  f_banque.executer (enregistrementAjoutCompte (2000, Epargne(1000, 2.5, 100, "Etudes"))).get ();
+  f_banque.executer (enregistrementAjoutCompte (2000, Cheque(1280, 5, -50, 7.25, "Loyer", 2.5))).get ();
+
+  EnregistrementJournal solde = operation (TypeOperation::AsgSolde, 1000);
+  solde.solde = 300;
+  f_banque.executer (solde).get ();
+  EnregistrementJournal transactions = operation (TypeOperation::AsgNombreTransactions, 1280);
+  transactions.nombreTransactions = 30;
+  f_banque.executer (transactions).get ();
+
+  const Client& client = f_banque.reqClient (2000);
+  ASSERT_EQ(2u, client.reqComptes ());
+  ASSERT_EQ(300, client.reqCompte (1000).reqSolde ());
+  ASSERT_EQ(30, dynamic_cast<const Cheque&> (client.reqCompte (1280)).reqNombreTransactions ());
+
+  f_banque.executer (operation (TypeOperation::SuppressionCompte, 1000)).get ();
+  ASSERT_EQ(1u, f_banque.reqClient (2000).reqComptes ());
+}
+
+TEST_F(BanqueTest, executer_CompteAbsent_CompteAbsentException)
+{
+  ASSERT_THROW(f_banque.executer (operation (TypeOperation::AsgSolde, 42)), CompteAbsentException);
+}
+
+TEST_F(BanqueTest, executer_MutationIncompatibleAvecLeCompte_CompteException)
+{
+  f_banque.executer (enregistrementAjoutCompte (2000, Epargne(1000, 2.5, 100, "Etudes"))).get ();
+  f_banque.executer (enregistrementAjoutCompte (2000, Cheque(1280, 5, -50, 7.25, "Loyer", 2.5))).get ();
+
+  EnregistrementJournal transactions = operation (TypeOperation::AsgNombreTransactions, 1000);
+  transactions.nombreTransactions = 5;
+  ASSERT_THROW(f_banque.executer (transactions), CompteException);
+  EnregistrementJournal solde = operation (TypeOperation::AsgSolde, 1000);
+  solde.solde = -50;
+  ASSERT_THROW(f_banque.executer (solde), CompteException);
+  EnregistrementJournal taux = operation (TypeOperation::AsgTauxInteret, 1280);
+  taux.tauxInteret = 1;
+  ASSERT_THROW(f_banque.executer (taux), CompteException);
+
+  ASSERT_EQ(100, f_banque.reqClient (2000).reqCompte (1000).reqSolde ());
+  ASSERT_EQ(7.25, f_banque.reqClient (2000).reqCompte (1280).reqTauxInteret ());
+}
+
+
+/**
+ * \brief Test de la méthode const IndexNoms& reqIndexNoms() const;
+ *     Cas valide : l'index suit les clients ajoutés directement ou par une mutation.
+ *     Cas invalide : un client refusé n'est pas indexé.
+ */
+TEST_F(BanqueTest, reqIndexNoms_ClientsAjoutes_Indexes)
+{
+  EnregistrementJournal ajout = operation (TypeOperation::AjoutClient, 0);
+  ajout.noFolio = 3000;
+  ajout.nom = "Carlo";
+  ajout.prenom = "Bertrand";
+  ajout.telephone = "590 234-0343";
+  ajout.jour = 22;
+  ajout.mois = 7;
+  ajout.annee = 1989;
+  f_banque.appliquer (ajout);
+  ASSERT_THROW(f_banque.ajouterClient (f_client), ClientDejaPresentException);
+
+  ASSERT_EQ(2u, f_banque.reqIndexNoms ().reqNombreEntrees ());
+  ASSERT_EQ((vector<int> {2000, 3000}), f_banque.reqIndexNoms ().rechercherExact ("carlo"));
+}
+
+
+/**
+ * \brief Test de la méthode const IndexTelephones& reqIndexTelephones() const;
+ *     Cas valide : un client ajouté est retrouvé par son téléphone, quelle qu'en
+ *                  soit la présentation.
+ *     Cas invalide : un numéro inconnu ne retrouve personne.
+ */
+TEST_F(BanqueTest, reqIndexTelephones_ClientAjoute_RetrouveParTelephone)
+{
+  ASSERT_EQ(1u, f_banque.reqIndexTelephones ().reqNombreEntrees ());
+  ASSERT_EQ((vector<int> {2000}), f_banque.reqIndexTelephones ().rechercher ("(590) 234-0342"));
+  ASSERT_TRUE(f_banque.reqIndexTelephones ().rechercher ("590 234-0343").empty ());
+}
+
+
+/**
+ * \brief Test des méthodes void parcourirClients(...) const et
+ *        void parcourirClientsParNaissance(...) const;
+ *     Cas valides : seuls les clients de l'intervalle sont visités, par folio
+ *                   ou par date de naissance croissants, bornes incluses.
+ *     Cas invalide : un intervalle renversé est refusé.
+ */
+TEST_F(BanqueTest, parcourirClients_Intervalles_ClientsDansLOrdre)
+{
+  f_banque.ajouterClient (Client(1500, "Zidane", "Zinedine", "418 555-1234", util::Date(23, 6, 1972)));
+  f_banque.ajouterClient (Client(2500, "Pirlo", "Andrea", "418 555-1235", util::Date(19, 5, 1979)));
+  vector<int> folios;
+  auto visiteur = [&folios] (const Client& p_client)
+  {
+    folios.push_back (p_client.reqNoFolio ());
+  };
+
+  f_banque.parcourirClients (1600, 2500, visiteur);
+  ASSERT_EQ((vector<int> {2000, 2500}), folios);
+
+  folios.clear ();
+  f_banque.parcourirClientsParNaissance (util::Date(1, 1, 1970), util::Date(20, 1, 1983), visiteur);
+  ASSERT_EQ((vector<int> {1500, 2500, 2000}), folios);
+
+  ASSERT_THROW(f_banque.parcourirClients (2, 1, visiteur), PreconditionException);
+}
+
+
+/**
+ * \brief Test des méthodes void activerInstantanes() et VersionsClients::Instantane epingler() const;
+ *     Cas valides : les clients existants sont visibles ; un instantané ne voit
+ *                   pas les mutations qui le suivent, un nouveau les voit.
+ *     Cas invalide : épingler sans avoir activé les instantanés est refusé.
+ */
+TEST_F(BanqueTest, epingler_MutationsPosterieures_Invisibles)
+{
+  ASSERT_THROW(f_banque.epingler (), PreconditionException);
+  f_banque.activerInstantanes ();
+  f_banque.executer (enregistrementAjoutCompte (2000, Epargne(1000, 2.5, 100, "Etudes"))).get ();
+  VersionsClients::Instantane avant = f_banque.epingler ();
+
+  EnregistrementJournal solde = operation (TypeOperation::AsgSolde, 1000);
+  solde.solde = 300;
+  f_banque.executer (solde).get ();
+
+  ASSERT_EQ(100, avant.reqClient (2000).reqCompte (1000).reqSolde ());
+  ASSERT_EQ(300, f_banque.epingler ().reqClient (2000).reqCompte (1000).reqSolde ());
+}
+
+
+/**
+ * \brief Test du constructeur copie Banque(const Banque& p_banque);
+ *     Cas valides : la copie a ses propres clients et ses propres instantanés ;
+ *                   les mutations de l'une ne sont visibles ni dans l'autre, ni
+ *                   dans ses instantanés ; la copie n'hérite pas du journal.
+ */
+TEST_F(BanqueTest, Copie_InstantanesActives_Independants)
+{
+  f_banque.executer (enregistrementAjoutCompte (2000, Epargne(1000, 2.5, 100, "Etudes"))).get ();
+  f_banque.activerInstantanes ();
+  Banque copie(f_banque);
+
+  EnregistrementJournal solde = operation (TypeOperation::AsgSolde, 1000);
+  solde.solde = 300;
+  copie.appliquer (solde);
+
+  ASSERT_EQ(300, copie.epingler ().reqClient (2000).reqCompte (1000).reqSolde ());
+  ASSERT_EQ(100, f_banque.epingler ().reqClient (2000).reqCompte (1000).reqSolde ());
+  ASSERT_EQ(100, f_banque.reqClient (2000).reqCompte (1000).reqSolde ());
+}
+
+TEST_F(BanqueTest, Copie_BanqueJournalisee_CopieSansJournal)
+{
+  const string chemin = "/tmp/BanqueTesteur_" + to_string (::getpid ()) + ".journal";
+  remove (chemin.c_str ());
+  {
+    GroupeValidation groupe(chemin);
+    f_banque.asgJournal (&groupe);
+    Banque copie(f_banque);
+    copie.executer (enregistrementAjoutCompte (2000, Epargne(1000, 2.5, 100, "Etudes"))).get ();
+    ASSERT_EQ(0u, groupe.reqNombreEnregistrements ());
+
+    copie.asgJournal (&groupe);
+    copie.executer (enregistrementAjoutCompte (2000, Epargne(1001, 2.5, 100, "Voyage"))).get ();
+    ASSERT_EQ(1u, groupe.reqNombreEnregistrements ());
+    f_banque.asgJournal (nullptr);
+  }
+  remove (chemin.c_str ());
+}
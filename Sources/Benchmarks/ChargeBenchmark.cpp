@@ -0,0 +1,224 @@
+/**
+ * \file ChargeBenchmark.cpp
+ * \brief Mesures de la Banque sous une charge synthétique reproductible.
+ *
+ * Les populations sont produites par GenerateurCharge (graine fixe) aux
+ * échelles de référence de 10 000, 1 000 000 et 10 000 000 comptes. Les
+ * grandes échelles ne font qu'une itération : la construction seule de
+ * la population y prend plusieurs secondes.
+ *
+ * À mesurer :
+ *         Banque GenerateurCharge::construireBanque();
+ *         void Banque::appliquer(const EnregistrementJournal& p_operation);
+ *         std::vector<Agregat> TableComptes::executer(const RequeteComptes& p_requete) const;
+ *         (comparé au parcours des clients par leurs accesseurs virtuels)
+ *         std::vector<double> ProjectionInterets::projeterTotaux(const std::vector<ScenarioTaux>& p_scenarios,
+ *                                                                int p_periodes) const;
+ *         (comparé à la capitalisation période par période)
+ *         StatistiquesSimulation SimulationTaux::executer() const;
+ *         (100 000 scénarios, selon le nombre de fils)
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include "Banque.h"
+#include "Cheque.h"
+#include "ContexteBenchmark.h"
+#include "GenerateurCharge.h"
+#include "ProjectionInterets.h"
+#include "SimulationTaux.h"
+#include "TableComptes.h"
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+const uint64_t GRAINE = 20240601;
+const size_t NOMBRE_OPERATIONS = 100000;
+const int PERIODES_DIX_ANS = 120;
+const vector<ScenarioTaux> SCENARIOS = {{-1.0}, {0.0}, {0.5}, {1.0}};
+const size_t NOMBRE_SCENARIOS_MONTE_CARLO = 100000;
+
+
+ParametresCharge
+parametresEchelle (benchmark::State& p_etat)
+{
+  ParametresCharge parametres;
+  parametres.graine = GRAINE;
+  parametres.nombreComptes = static_cast<size_t> (p_etat.range (0));
+  return parametres;
+}
+} //namespace
+
+
+static void
+BM_Charge_ConstruireBanque (benchmark::State& p_etat)
+{
+  for (auto _ : p_etat)
+    {
+      GenerateurCharge generateur(parametresEchelle (p_etat));
+      Banque banque = generateur.construireBanque ();
+      benchmark::DoNotOptimize (banque);
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * p_etat.range (0));
+}
+BENCHMARK(BM_Charge_ConstruireBanque)->Arg (ECHELLE_PETITE)->Unit (benchmark::kMillisecond);
+BENCHMARK(BM_Charge_ConstruireBanque)->Arg (ECHELLE_MOYENNE)->Arg (ECHELLE_GRANDE)
+        ->Iterations (1)->Unit (benchmark::kMillisecond);
+
+
+static void
+BM_Charge_AppliquerOperations (benchmark::State& p_etat)
+{
+  GenerateurCharge generateur(parametresEchelle (p_etat));
+  Banque banque = generateur.construireBanque ();
+  vector<EnregistrementJournal> operations;
+  operations.reserve (NOMBRE_OPERATIONS);
+  generateur.genererOperations (NOMBRE_OPERATIONS, [&] (const EnregistrementJournal& p_operation)
+  {
+    operations.push_back (p_operation);
+  });
+
+  for (auto _ : p_etat)
+    {
+      p_etat.PauseTiming ();
+      Banque copie = banque;
+      p_etat.ResumeTiming ();
+      for (const EnregistrementJournal& operation : operations)
+        {
+          copie.appliquer (operation);
+        }
+      p_etat.PauseTiming ();
+      copie = Banque();
+      p_etat.ResumeTiming ();
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * operations.size ());
+}
+BENCHMARK(BM_Charge_AppliquerOperations)->Arg (ECHELLE_PETITE)->Unit (benchmark::kMillisecond);
+BENCHMARK(BM_Charge_AppliquerOperations)->Arg (ECHELLE_MOYENNE)->Arg (ECHELLE_GRANDE)
+        ->Iterations (1)->Unit (benchmark::kMillisecond);
+
+
+/**
+ * \brief Découvert total des comptes chèque, par parcours des clients
+ */
+static void
+BM_Charge_DecouvertParParcours (benchmark::State& p_etat)
+{
+  Banque banque = GenerateurCharge(parametresEchelle (p_etat)).construireBanque ();
+  for (auto _ : p_etat)
+    {
+      double decouvert = 0;
+      for (const auto& paire : banque.reqClients ())
+        {
+          paire.second.parcourirComptes ([&decouvert] (const Compte& p_compte)
+          {
+            if (dynamic_cast<const Cheque*> (&p_compte) != nullptr && p_compte.reqSolde () < 0)
+              {
+                decouvert += p_compte.reqSolde ();
+              }
+          });
+        }
+      benchmark::DoNotOptimize (decouvert);
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * p_etat.range (0));
+}
+BENCHMARK(BM_Charge_DecouvertParParcours)->Arg (ECHELLE_PETITE)->Arg (ECHELLE_MOYENNE)
+        ->Unit (benchmark::kMillisecond);
+
+
+/**
+ * \brief Découvert total des comptes chèque, par requête sur la table en colonnes
+ */
+static void
+BM_Charge_DecouvertParTable (benchmark::State& p_etat)
+{
+  TableComptes table(GenerateurCharge(parametresEchelle (p_etat)).construireBanque ());
+  RequeteComptes requete;
+  requete.filtrerType = true;
+  requete.type = TypeCompte::Cheque;
+  requete.soldeMaximum = 0;
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (table.executer (requete));
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * p_etat.range (0));
+}
+BENCHMARK(BM_Charge_DecouvertParTable)->Arg (ECHELLE_PETITE)->Arg (ECHELLE_MOYENNE)
+        ->Unit (benchmark::kMillisecond);
+
+
+/**
+ * \brief Dix ans de capitalisation mensuelle des comptes épargne, sous quatre
+ *        scénarios, en capitalisant période par période
+ */
+static void
+BM_Charge_ProjectionParPeriodes (benchmark::State& p_etat)
+{
+  ProjectionInterets projection(TableComptes(GenerateurCharge(parametresEchelle (p_etat)).construireBanque ()));
+  const vector<double>& soldes = projection.reqSoldes ();
+  const vector<double>& taux = projection.reqTaux ();
+  for (auto _ : p_etat)
+    {
+      for (const ScenarioTaux& scenario : SCENARIOS)
+        {
+          double total = 0;
+          for (size_t i = 0; i < soldes.size (); ++i)
+            {
+              const double tauxScenario = min (3.5, max (0.1, taux[i] + scenario.deplacement));
+              double solde = soldes[i];
+              for (int periode = 0; periode < PERIODES_DIX_ANS; ++periode)
+                {
+                  solde += solde * tauxScenario / 100;
+                }
+              total += solde;
+            }
+          benchmark::DoNotOptimize (total);
+        }
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * projection.reqNombreComptes () * SCENARIOS.size ());
+}
+BENCHMARK(BM_Charge_ProjectionParPeriodes)->Arg (ECHELLE_PETITE)->Arg (ECHELLE_MOYENNE)
+        ->Unit (benchmark::kMillisecond);
+
+
+/**
+ * \brief Les mêmes projections, par les noyaux en blocs de ProjectionInterets
+ */
+static void
+BM_Charge_ProjectionParBlocs (benchmark::State& p_etat)
+{
+  ProjectionInterets projection(TableComptes(GenerateurCharge(parametresEchelle (p_etat)).construireBanque ()));
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (projection.projeterTotaux (SCENARIOS, PERIODES_DIX_ANS));
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * projection.reqNombreComptes () * SCENARIOS.size ());
+}
+BENCHMARK(BM_Charge_ProjectionParBlocs)->Arg (ECHELLE_PETITE)->Arg (ECHELLE_MOYENNE)
+        ->Unit (benchmark::kMillisecond);
+
+
+/**
+ * \brief Simulation de Monte-Carlo de 100 000 chocs de taux sur un an ; le
+ *        second argument est le nombre de fils, 0 pour tous les cœurs
+ */
+static void
+BM_Charge_SimulationTaux (benchmark::State& p_etat)
+{
+  ParametresSimulation parametres;
+  parametres.graine = GRAINE;
+  parametres.nombreScenarios = NOMBRE_SCENARIOS_MONTE_CARLO;
+  SimulationTaux simulation(TableComptes(GenerateurCharge(parametresEchelle (p_etat)).construireBanque ()),
+                            parametres, static_cast<unsigned> (p_etat.range (1)));
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (simulation.executer ());
+    }
+  p_etat.counters["fils"] = simulation.reqNombreFils ();
+  p_etat.SetItemsProcessed (p_etat.iterations () * NOMBRE_SCENARIOS_MONTE_CARLO);
+}
+BENCHMARK(BM_Charge_SimulationTaux)->Args ({ECHELLE_PETITE, 1})->Args ({ECHELLE_PETITE, 2})
+        ->Args ({ECHELLE_PETITE, 4})->Args ({ECHELLE_PETITE, 0})
+        ->Iterations (1)->UseRealTime ()->Unit (benchmark::kMillisecond);
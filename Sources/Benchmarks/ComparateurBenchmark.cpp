@@ -0,0 +1,264 @@
+/**
+ * \file ComparateurBenchmark.cpp
+ * \brief Outil qui enregistre les références des bancs d'essai et juge une
+ *        nouvelle exécution par rapport à elles.
+ *
+ * Utilisation :
+ *   ComparateurBenchmark enregistrer <executable> <reference.json> [options]
+ *   ComparateurBenchmark comparer <executable|resultats.json> <reference.json> [options]
+ *
+ * Options :
+ *   --repetitions=N  répétitions de chaque banc (9 par défaut)
+ *   --filtre=REGEX   transmis à --benchmark_filter
+ *   --seuil=X        variation relative minimale signalée (0.05 par défaut)
+ *   --mad=K          nombre de MAD que l'écart des médianes doit dépasser (3 par défaut)
+ *   --alpha=P        probabilité de Mann-Whitney maximale (0.01 par défaut)
+ *   --cpu            compare le temps CPU plutôt que le temps réel
+ *   --forcer         compare malgré des contextes différents, avec un avertissement
+ *
+ * Les références sont rangées dans Benchmarks/References/, une par exécutable,
+ * et doivent être enregistrées à partir de bancs compilés en mode release.
+ * Une comparaison est refusée si le nombre de processeurs ou un type de
+ * compilation diffère de celui de la référence, sauf avec --forcer.
+ * Le code de retour vaut 1 si au moins un banc régresse, 2 en cas d'erreur.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+
+#include "ReferenceBenchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace banc;
+using namespace std;
+
+namespace
+{
+/**
+ * \brief Options de la ligne de commande
+ */
+struct Options
+{
+  string commande;
+  string source;
+  string reference;
+  unsigned repetitions = 9;
+  string filtre;
+  Seuils seuils;
+  bool forcer = false;
+};
+
+
+[[noreturn]] void
+usage ()
+{
+  cerr << "Utilisation : ComparateurBenchmark enregistrer <executable> <reference.json> [options]\n"
+       << "              ComparateurBenchmark comparer <executable|resultats.json> <reference.json> [options]\n"
+       << "Options : --repetitions=N --filtre=REGEX --seuil=X --mad=K --alpha=P --cpu --forcer\n";
+  exit (2);
+}
+
+
+Options
+lireOptions (int argc, char* argv[])
+{
+  if (argc < 4)
+    {
+      usage ();
+    }
+  Options options;
+  options.commande = argv[1];
+  options.source = argv[2];
+  options.reference = argv[3];
+  if (options.commande != "enregistrer" && options.commande != "comparer")
+    {
+      usage ();
+    }
+  for (int i = 4; i < argc; ++i)
+    {
+      string option = argv[i];
+      auto valeur = [&] (const string& p_prefixe)
+      {
+        return option.compare (0, p_prefixe.size (), p_prefixe) == 0 ? option.substr (p_prefixe.size ()) : string ();
+      };
+      if (!valeur ("--repetitions=").empty ())
+        {
+          options.repetitions = static_cast<unsigned> (stoul (valeur ("--repetitions=")));
+        }
+      else if (!valeur ("--filtre=").empty ())
+        {
+          options.filtre = valeur ("--filtre=");
+        }
+      else if (!valeur ("--seuil=").empty ())
+        {
+          options.seuils.variationMinimale = stod (valeur ("--seuil="));
+        }
+      else if (!valeur ("--mad=").empty ())
+        {
+          options.seuils.nombreMad = stod (valeur ("--mad="));
+        }
+      else if (!valeur ("--alpha=").empty ())
+        {
+          options.seuils.alpha = stod (valeur ("--alpha="));
+        }
+      else if (option == "--cpu")
+        {
+          options.seuils.tempsCpu = true;
+        }
+      else if (option == "--forcer")
+        {
+          options.forcer = true;
+        }
+      else
+        {
+          usage ();
+        }
+    }
+  if (options.repetitions < 3)
+    {
+      throw invalid_argument("au moins 3 répétitions sont nécessaires à la comparaison");
+    }
+  return options;
+}
+
+
+/**
+ * \brief Exécute un banc d'essai en demandant sa sortie JSON dans p_sortie
+ */
+void
+executerBanc (const Options& p_options, const string& p_sortie)
+{
+  string commande = "'" + p_options.source + "'"
+          + " --benchmark_repetitions=" + to_string (p_options.repetitions)
+          + " --benchmark_out_format=json --benchmark_out='" + p_sortie + "'";
+  if (!p_options.filtre.empty ())
+    {
+      commande += " --benchmark_filter='" + p_options.filtre + "'";
+    }
+  commande += " > /dev/null";
+  cerr << "Exécution : " << commande << endl;
+  if (system (commande.c_str ()) != 0)
+    {
+      throw runtime_error("échec de l'exécution de " + p_options.source);
+    }
+}
+
+
+Resultats
+lireFichier (const string& p_chemin)
+{
+  ifstream fichier(p_chemin);
+  if (!fichier)
+    {
+      throw runtime_error("lecture impossible de " + p_chemin);
+    }
+  return lireDocument (fichier);
+}
+
+
+/**
+ * \brief Signale les différences de contexte ; les refuse sans --forcer
+ */
+void
+verifierContextes (const Contexte& p_reference, const Contexte& p_nouveau, bool p_forcer)
+{
+  const vector<string> differences = comparerContextes (p_reference, p_nouveau);
+  for (const string& difference : differences)
+    {
+      cerr << (p_forcer ? "Avertissement, contexte différent : " : "Contexte différent : ") << difference << endl;
+    }
+  if (!differences.empty () && !p_forcer)
+    {
+      throw runtime_error("exécutions incomparables ; réenregistrer la référence ou utiliser --forcer");
+    }
+}
+
+
+bool
+estJson (const string& p_chemin)
+{
+  return p_chemin.size () > 5 && p_chemin.compare (p_chemin.size () - 5, 5, ".json") == 0;
+}
+
+
+int
+afficherRapport (const vector<Verdict>& p_verdicts)
+{
+  int regressions = 0;
+  cout << left << setw (60) << "Banc" << right << setw (14) << "Reference(ns)" << setw (14) << "Nouveau(ns)"
+       << setw (10) << "Ecart" << setw (10) << "p" << "  Verdict" << endl;
+  for (const Verdict& verdict : p_verdicts)
+    {
+      cout << left << setw (60) << verdict.nom << right << fixed << setprecision (1)
+           << setw (14) << verdict.medianeReference << setw (14) << verdict.medianeNouvelle
+           << setw (9) << showpos << verdict.variation * 100 << noshowpos << '%'
+           << setprecision (4) << setw (10) << verdict.probabilite
+           << "  " << reqNomEtat (verdict.etat) << endl;
+      if (verdict.etat == Etat::Regression)
+        {
+          ++regressions;
+        }
+    }
+  cout << regressions << " régression(s) sur " << p_verdicts.size () << " banc(s)" << endl;
+  return regressions == 0 ? 0 : 1;
+}
+} //namespace
+
+
+int
+main (int argc, char* argv[])
+{
+  try
+    {
+      Options options = lireOptions (argc, argv);
+      if (options.commande == "enregistrer")
+        {
+          executerBanc (options, options.reference);
+          cout << lireFichier (options.reference).bancs.size () << " banc(s) enregistré(s) dans "
+               << options.reference << endl;
+          return 0;
+        }
+
+      Resultats nouvelle;
+      if (estJson (options.source))
+        {
+          nouvelle = lireFichier (options.source);
+        }
+      else
+        {
+          char modele[] = "/tmp/ComparateurBenchmarkXXXXXX";
+          int descripteur = mkstemp (modele);
+          if (descripteur < 0)
+            {
+              throw runtime_error("création du fichier temporaire impossible");
+            }
+          close (descripteur);
+          try
+            {
+              executerBanc (options, modele);
+              nouvelle = lireFichier (modele);
+            }
+          catch (...)
+            {
+              unlink (modele);
+              throw;
+            }
+          unlink (modele);
+        }
+      const Resultats reference = lireFichier (options.reference);
+      verifierContextes (reference.contexte, nouvelle.contexte, options.forcer);
+      return afficherRapport (comparer (reference.bancs, nouvelle.bancs, options.seuils));
+    }
+  catch (const exception& e)
+    {
+      cerr << "ComparateurBenchmark : " << e.what () << endl;
+      return 2;
+    }
+}
@@ -0,0 +1,27 @@
+/**
+ * \file ContexteBenchmark.h
+ * \brief Ajoute au contexte JSON des bancs d'essai le type de leur compilation.
+ *
+ * Le champ "library_build_type" de Google Benchmark ne décrit que la
+ * bibliothèque ; "type_compilation" décrit les bancs et le code mesuré, et
+ * permet à ComparateurBenchmark de refuser une référence prise en mode debug.
+ * À inclure une fois dans chaque exécutable de bancs d'essai.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef CONTEXTEBENCHMARK_H
+#define CONTEXTEBENCHMARK_H
+
+#include <benchmark/benchmark.h>
+
+namespace banc
+{
+#if defined(NDEBUG)
+inline const bool CONTEXTE_COMPILATION = (benchmark::AddCustomContext ("type_compilation", "release"), true);
+#else
+inline const bool CONTEXTE_COMPILATION = (benchmark::AddCustomContext ("type_compilation", "debug"), true);
+#endif
+} //namespace banc
+
+#endif /* CONTEXTEBENCHMARK_H */
@@ -0,0 +1,136 @@
+/**
+ * \file ContratBenchmark.cpp
+ * \brief Mesure du coût de chaque niveau de vérification des contrats.
+ *
+ * Chaque banc est exécuté aux quatre niveaux (Aucun, Preconditions,
+ * InvariantsEchantillonnes, Complet) sur les opérations courantes de
+ * Client et de Compte. À compiler sans NDEBUG, ou avec NDEBUG et
+ * CONTRAT_NIVEAU_EXECUTION pour mesurer une version de production.
+ *
+ * À mesurer :
+ *         void Compte::asgSolde(double p_solde);
+ *         void Compte::asgTauxInteret(double p_tauxInteret);
+ *         Epargne(...) et ~Epargne();
+ *         void Client::ajouterCompte(const Compte& p_nouveauCompte);
+ *         void Client::supprimerCompte(int p_noCompte);
+ *         Client(const Client& p_client);
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include "Cheque.h"
+#include "Client.h"
+#include "ContexteBenchmark.h"
+#include "ContratException.h"
+#include "Epargne.h"
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+const char* const NOMS_NIVEAUX[] = {"Aucun", "Preconditions", "InvariantsEchantillonnes", "Complet"};
+
+
+/**
+ * \brief Applique le niveau demandé pendant la durée d'un banc, puis rétablit Complet
+ */
+class NiveauBanc
+{
+public:
+  explicit NiveauBanc (benchmark::State& p_etat)
+  {
+    contrat::asgNiveau (static_cast<contrat::Niveau> (p_etat.range (0)), 64);
+    p_etat.SetLabel (NOMS_NIVEAUX[p_etat.range (0)]);
+  }
+
+  ~NiveauBanc ()
+  {
+    contrat::asgNiveau (contrat::Niveau::Complet);
+  }
+};
+
+
+Client
+clientAvecComptes (int p_nombreComptes)
+{
+  Client client(1000, "Jean", "Marie", "418 567-4213", util::Date(2, 3, 1980));
+  for (int no = 1; no <= p_nombreComptes; ++no)
+    {
+      client.ajouterCompte (Epargne(no, 1.5, 100, "Etudes"));
+    }
+  return client;
+}
+} //namespace
+
+
+static void
+BM_Contrat_CompteAsgSolde (benchmark::State& p_etat)
+{
+  NiveauBanc niveau(p_etat);
+  Cheque cheque(1, 5, 0, 4, "Loyer", 1);
+  double solde = 0;
+  for (auto _ : p_etat)
+    {
+      cheque.asgSolde (solde);
+      solde += 1;
+    }
+}
+BENCHMARK(BM_Contrat_CompteAsgSolde)->DenseRange (0, 3);
+
+
+static void
+BM_Contrat_EpargneAsgTauxInteret (benchmark::State& p_etat)
+{
+  NiveauBanc niveau(p_etat);
+  Epargne epargne(1, 1.5, 100, "Etudes");
+  double taux = 0.1;
+  for (auto _ : p_etat)
+    {
+      epargne.asgTauxInteret (taux);
+      taux = taux < 3.4 ? taux + 0.1 : 0.1;
+    }
+}
+BENCHMARK(BM_Contrat_EpargneAsgTauxInteret)->DenseRange (0, 3);
+
+
+static void
+BM_Contrat_EpargneConstructionDestruction (benchmark::State& p_etat)
+{
+  NiveauBanc niveau(p_etat);
+  for (auto _ : p_etat)
+    {
+      Epargne epargne(1, 1.5, 100, "Etudes");
+      benchmark::DoNotOptimize (epargne);
+    }
+}
+BENCHMARK(BM_Contrat_EpargneConstructionDestruction)->DenseRange (0, 3);
+
+
+static void
+BM_Contrat_ClientAjouterSupprimerCompte (benchmark::State& p_etat)
+{
+  NiveauBanc niveau(p_etat);
+  Client client = clientAvecComptes (16);
+  Epargne epargne(100, 1.5, 100, "Etudes");
+  for (auto _ : p_etat)
+    {
+      client.ajouterCompte (epargne);
+      client.supprimerCompte (100);
+    }
+}
+BENCHMARK(BM_Contrat_ClientAjouterSupprimerCompte)->DenseRange (0, 3);
+
+
+static void
+BM_Contrat_ClientCopie (benchmark::State& p_etat)
+{
+  NiveauBanc niveau(p_etat);
+  Client client = clientAvecComptes (16);
+  for (auto _ : p_etat)
+    {
+      Client copie(client);
+      benchmark::DoNotOptimize (copie);
+    }
+}
+BENCHMARK(BM_Contrat_ClientCopie)->DenseRange (0, 3);
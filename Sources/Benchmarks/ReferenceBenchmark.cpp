@@ -0,0 +1,506 @@
+/**
+ * \file ReferenceBenchmark.cpp
+ * \brief Implantation de la lecture et de la comparaison des résultats de bancs d'essai
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "ReferenceBenchmark.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace banc
+{
+namespace
+{
+/**
+ * \brief Valeur JSON minimale : juste ce qu'il faut pour la sortie de Google Benchmark
+ */
+struct Valeur
+{
+  enum class Type { Nul, Booleen, Nombre, Texte, Tableau, Objet } type = Type::Nul;
+  double nombre = 0;
+  string texte;
+  vector<Valeur> elements;
+  vector<pair<string, Valeur>> membres;
+
+  const Valeur* membre (const string& p_nom) const
+  {
+    for (const auto& paire : membres)
+      {
+        if (paire.first == p_nom)
+          {
+            return &paire.second;
+          }
+      }
+    return nullptr;
+  }
+};
+
+
+/**
+ * \brief Analyseur JSON par descente récursive
+ */
+class Analyseur
+{
+public:
+  explicit Analyseur (const string& p_texte) : m_texte(p_texte), m_position(0) { }
+
+  Valeur analyser ()
+  {
+    Valeur valeur = lireValeur ();
+    sauterBlancs ();
+    if (m_position != m_texte.size ())
+      {
+        erreur ("contenu après la valeur");
+      }
+    return valeur;
+  }
+
+private:
+  [[noreturn]] void erreur (const char* p_message) const
+  {
+    throw runtime_error(string ("JSON invalide à la position ") + to_string (m_position) + " : " + p_message);
+  }
+
+  void sauterBlancs ()
+  {
+    while (m_position < m_texte.size () && isspace (static_cast<unsigned char> (m_texte[m_position])))
+      {
+        ++m_position;
+      }
+  }
+
+  char attendre (char p_caractere)
+  {
+    sauterBlancs ();
+    if (m_position >= m_texte.size () || m_texte[m_position] != p_caractere)
+      {
+        erreur ("caractère inattendu");
+      }
+    return m_texte[m_position++];
+  }
+
+  bool suivantEst (char p_caractere)
+  {
+    sauterBlancs ();
+    return m_position < m_texte.size () && m_texte[m_position] == p_caractere;
+  }
+
+  Valeur lireValeur ()
+  {
+    sauterBlancs ();
+    if (m_position >= m_texte.size ())
+      {
+        erreur ("fin prématurée");
+      }
+    Valeur valeur;
+    char c = m_texte[m_position];
+    if (c == '{')
+      {
+        valeur.type = Valeur::Type::Objet;
+        attendre ('{');
+        if (!suivantEst ('}'))
+          {
+            do
+              {
+                sauterBlancs ();
+                string nom = lireTexte ();
+                attendre (':');
+                valeur.membres.emplace_back (move (nom), lireValeur ());
+              }
+            while (suivantEst (',') && attendre (','));
+          }
+        attendre ('}');
+      }
+    else if (c == '[')
+      {
+        valeur.type = Valeur::Type::Tableau;
+        attendre ('[');
+        if (!suivantEst (']'))
+          {
+            do
+              {
+                valeur.elements.push_back (lireValeur ());
+              }
+            while (suivantEst (',') && attendre (','));
+          }
+        attendre (']');
+      }
+    else if (c == '"')
+      {
+        valeur.type = Valeur::Type::Texte;
+        valeur.texte = lireTexte ();
+      }
+    else if (m_texte.compare (m_position, 4, "true") == 0 || m_texte.compare (m_position, 5, "false") == 0)
+      {
+        valeur.type = Valeur::Type::Booleen;
+        valeur.nombre = c == 't' ? 1 : 0;
+        m_position += c == 't' ? 4 : 5;
+      }
+    else if (m_texte.compare (m_position, 4, "null") == 0)
+      {
+        m_position += 4;
+      }
+    else
+      {
+        size_t lus = 0;
+        try
+          {
+            valeur.nombre = stod (m_texte.substr (m_position, 32), &lus);
+          }
+        catch (const logic_error&)
+          {
+            erreur ("nombre attendu");
+          }
+        valeur.type = Valeur::Type::Nombre;
+        m_position += lus;
+      }
+    return valeur;
+  }
+
+  string lireTexte ()
+  {
+    if (m_position >= m_texte.size () || m_texte[m_position] != '"')
+      {
+        erreur ("chaîne attendue");
+      }
+    ++m_position;
+    string texte;
+    while (m_position < m_texte.size () && m_texte[m_position] != '"')
+      {
+        char c = m_texte[m_position++];
+        if (c == '\\' && m_position < m_texte.size ())
+          {
+            char echappe = m_texte[m_position++];
+            switch (echappe)
+              {
+              case 'n': texte += '\n'; break;
+              case 't': texte += '\t'; break;
+              case 'u': texte += '?'; m_position += 4; break;
+              default: texte += echappe; break;
+              }
+          }
+        else
+          {
+            texte += c;
+          }
+      }
+    if (m_position >= m_texte.size ())
+      {
+        erreur ("chaîne non terminée");
+      }
+    ++m_position;
+    return texte;
+  }
+
+  const string& m_texte;
+  size_t m_position;
+};
+
+
+double
+facteurNanosecondes (const string& p_unite)
+{
+  if (p_unite == "us")
+    {
+      return 1e3;
+    }
+  if (p_unite == "ms")
+    {
+      return 1e6;
+    }
+  if (p_unite == "s")
+    {
+      return 1e9;
+    }
+  return 1;
+}
+} //namespace
+
+
+/**
+ * \brief Lit la sortie JSON de Google Benchmark (--benchmark_out_format=json)
+ *        Seules les répétitions individuelles sont retenues ; les agrégats
+ *        (moyenne, médiane, écart type) calculés par la bibliothèque sont ignorés.
+ *        Les champs absents du contexte restent vides.
+ * \param[in] p_json le flux qui contient le document JSON
+ * \return le contexte de l'exécution et les mesures de chaque banc, indexées par nom
+ * \exception std::runtime_error si le document n'a pas la forme attendue
+ */
+Resultats lireDocument(std::istream& p_json)
+{
+  string texte((istreambuf_iterator<char>(p_json)), istreambuf_iterator<char>());
+  Valeur document = Analyseur(texte).analyser ();
+  const Valeur* bancs = document.membre ("benchmarks");
+  if (bancs == nullptr || bancs->type != Valeur::Type::Tableau)
+    {
+      throw runtime_error("JSON sans tableau \"benchmarks\"");
+    }
+
+  Resultats lus;
+  const Valeur* contexte = document.membre ("context");
+  if (contexte != nullptr)
+    {
+      auto texteMembre = [contexte] (const char* p_nom)
+      {
+        const Valeur* valeur = contexte->membre (p_nom);
+        return valeur != nullptr ? valeur->texte : string ();
+      };
+      const Valeur* nombreCpus = contexte->membre ("num_cpus");
+      lus.contexte.hote = texteMembre ("host_name");
+      lus.contexte.nombreCpus = nombreCpus != nullptr ? static_cast<int> (nombreCpus->nombre) : 0;
+      lus.contexte.typeBibliotheque = texteMembre ("library_build_type");
+      lus.contexte.typeCompilation = texteMembre ("type_compilation");
+    }
+
+  map<string, Mesures>& resultats = lus.bancs;
+  for (const Valeur& banc : bancs->elements)
+    {
+      const Valeur* type = banc.membre ("run_type");
+      if ((type != nullptr && type->texte != "iteration") || banc.membre ("error_occurred") != nullptr)
+        {
+          continue;
+        }
+      const Valeur* nom = banc.membre ("run_name");
+      if (nom == nullptr)
+        {
+          nom = banc.membre ("name");
+        }
+      const Valeur* reel = banc.membre ("real_time");
+      const Valeur* cpu = banc.membre ("cpu_time");
+      const Valeur* unite = banc.membre ("time_unit");
+      if (nom == nullptr || reel == nullptr || cpu == nullptr)
+        {
+          throw runtime_error("banc sans nom ou sans durée");
+        }
+      double facteur = facteurNanosecondes (unite != nullptr ? unite->texte : "ns");
+      Mesures& mesures = resultats[nom->texte];
+      mesures.tempsReel.push_back (reel->nombre * facteur);
+      mesures.tempsCpu.push_back (cpu->nombre * facteur);
+    }
+  return lus;
+}
+
+
+/**
+ * \brief Lit les seules mesures d'une sortie JSON de Google Benchmark
+ * \param[in] p_json le flux qui contient le document JSON
+ * \return les mesures de chaque banc, indexées par nom
+ * \exception std::runtime_error si le document n'a pas la forme attendue
+ */
+std::map<std::string, Mesures> lireResultats(std::istream& p_json)
+{
+  return lireDocument (p_json).bancs;
+}
+
+
+/**
+ * \brief Relève ce qui rend deux exécutions incomparables : le nombre de
+ *        processeurs et les types de compilation des bancs et de la bibliothèque
+ *        L'hôte n'est pas comparé, deux machines identiques pouvant se relayer.
+ * \param[in] p_reference le contexte de la référence
+ * \param[in] p_nouveau le contexte de l'exécution à juger
+ * \return une description de chaque différence, vide si les contextes concordent
+ */
+std::vector<std::string> comparerContextes(const Contexte& p_reference, const Contexte& p_nouveau)
+{
+  vector<string> differences;
+  auto relever = [&differences] (const string& p_champ, const string& p_reference, const string& p_nouveau)
+  {
+    if (p_reference != p_nouveau)
+      {
+        differences.push_back (p_champ + " : " + (p_reference.empty () ? "inconnu" : p_reference)
+                               + " (référence) contre " + (p_nouveau.empty () ? "inconnu" : p_nouveau));
+      }
+  };
+  relever ("num_cpus", to_string (p_reference.nombreCpus), to_string (p_nouveau.nombreCpus));
+  relever ("type_compilation", p_reference.typeCompilation, p_nouveau.typeCompilation);
+  relever ("library_build_type", p_reference.typeBibliotheque, p_nouveau.typeBibliotheque);
+  return differences;
+}
+
+
+/**
+ * \brief Calcule la médiane d'une série
+ * \param[in] p_valeurs la série, non vide
+ * \return la médiane
+ */
+double mediane(std::vector<double> p_valeurs)
+{
+  if (p_valeurs.empty ())
+    {
+      throw invalid_argument("médiane d'une série vide");
+    }
+  size_t milieu = p_valeurs.size () / 2;
+  nth_element (p_valeurs.begin (), p_valeurs.begin () + milieu, p_valeurs.end ());
+  double haute = p_valeurs[milieu];
+  if (p_valeurs.size () % 2 == 1)
+    {
+      return haute;
+    }
+  double basse = *max_element (p_valeurs.begin (), p_valeurs.begin () + milieu);
+  return (basse + haute) / 2;
+}
+
+
+/**
+ * \brief Calcule l'écart absolu médian, mis à l'échelle d'un écart type
+ *        pour une distribution normale (facteur 1,4826)
+ * \param[in] p_valeurs la série, non vide
+ * \return le MAD normalisé
+ */
+double ecartAbsoluMedian(const std::vector<double>& p_valeurs)
+{
+  double centre = mediane (p_valeurs);
+  vector<double> ecarts;
+  ecarts.reserve (p_valeurs.size ());
+  for (double valeur : p_valeurs)
+    {
+      ecarts.push_back (fabs (valeur - centre));
+    }
+  return 1.4826 * mediane (move (ecarts));
+}
+
+
+/**
+ * \brief Test bilatéral de Mann-Whitney, par approximation normale avec
+ *        correction pour les égalités et pour la continuité
+ * \param[in] p_a la première série
+ * \param[in] p_b la deuxième série
+ * \return la probabilité d'observer un tel écart si les séries ont la même distribution
+ */
+double probabiliteMannWhitney(const std::vector<double>& p_a, const std::vector<double>& p_b)
+{
+  const double n1 = static_cast<double> (p_a.size ());
+  const double n2 = static_cast<double> (p_b.size ());
+  if (p_a.empty () || p_b.empty ())
+    {
+      return 1;
+    }
+
+  vector<pair<double, int>> toutes;
+  for (double valeur : p_a)
+    {
+      toutes.emplace_back (valeur, 0);
+    }
+  for (double valeur : p_b)
+    {
+      toutes.emplace_back (valeur, 1);
+    }
+  sort (toutes.begin (), toutes.end ());
+
+  double sommeRangsA = 0;
+  double correctionEgalites = 0;
+  for (size_t debut = 0; debut < toutes.size ();)
+    {
+      size_t fin = debut;
+      while (fin < toutes.size () && toutes[fin].first == toutes[debut].first)
+        {
+          ++fin;
+        }
+      const double rang = (static_cast<double> (debut + fin) + 1) / 2;
+      const double egaux = static_cast<double> (fin - debut);
+      correctionEgalites += egaux * egaux * egaux - egaux;
+      for (size_t i = debut; i < fin; ++i)
+        {
+          if (toutes[i].second == 0)
+            {
+              sommeRangsA += rang;
+            }
+        }
+      debut = fin;
+    }
+
+  const double n = n1 + n2;
+  const double u = sommeRangsA - n1 * (n1 + 1) / 2;
+  const double moyenne = n1 * n2 / 2;
+  const double variance = n1 * n2 / 12 * ((n + 1) - correctionEgalites / (n * (n - 1)));
+  if (variance <= 0)
+    {
+      return 1;
+    }
+  const double z = max (0.0, fabs (u - moyenne) - 0.5) / sqrt (variance);
+  return erfc (z / sqrt (2.0));
+}
+
+
+/**
+ * \brief Compare chaque banc d'une exécution avec sa référence
+ *        Un écart n'est signalé que s'il dépasse la variation minimale relative,
+ *        nombreMad fois le bruit (le plus grand MAD des deux séries) et si la
+ *        probabilité de Mann-Whitney est inférieure à alpha.
+ * \param[in] p_reference les mesures enregistrées
+ * \param[in] p_nouvelle les mesures de l'exécution à juger
+ * \param[in] p_seuils les critères de signalement
+ * \return un verdict par banc présent dans l'une ou l'autre exécution, par nom
+ */
+std::vector<Verdict> comparer(const std::map<std::string, Mesures>& p_reference,
+                              const std::map<std::string, Mesures>& p_nouvelle,
+                              const Seuils& p_seuils)
+{
+  auto serie = [&] (const Mesures& p_mesures) -> const vector<double>&
+  {
+    return p_seuils.tempsCpu ? p_mesures.tempsCpu : p_mesures.tempsReel;
+  };
+
+  vector<Verdict> verdicts;
+  for (const auto& nouvelle : p_nouvelle)
+    {
+      Verdict verdict {nouvelle.first, 0, mediane (serie (nouvelle.second)), 0, 1, Etat::Nouveau};
+      auto reference = p_reference.find (nouvelle.first);
+      if (reference != p_reference.end ())
+        {
+          const vector<double>& avant = serie (reference->second);
+          const vector<double>& apres = serie (nouvelle.second);
+          verdict.medianeReference = mediane (avant);
+          verdict.variation = verdict.medianeReference > 0
+                  ? (verdict.medianeNouvelle - verdict.medianeReference) / verdict.medianeReference : 0;
+          verdict.probabilite = probabiliteMannWhitney (avant, apres);
+          const double bruit = max (ecartAbsoluMedian (avant), ecartAbsoluMedian (apres));
+          const bool significatif = fabs (verdict.variation) > p_seuils.variationMinimale
+                  && fabs (verdict.medianeNouvelle - verdict.medianeReference) > p_seuils.nombreMad * bruit
+                  && verdict.probabilite < p_seuils.alpha;
+          verdict.etat = !significatif ? Etat::Stable
+                  : verdict.variation > 0 ? Etat::Regression : Etat::Amelioration;
+        }
+      verdicts.push_back (verdict);
+    }
+  for (const auto& reference : p_reference)
+    {
+      if (p_nouvelle.count (reference.first) == 0)
+        {
+          verdicts.push_back (Verdict {reference.first, mediane (serie (reference.second)), 0, 0, 1, Etat::Absent});
+        }
+    }
+  sort (verdicts.begin (), verdicts.end (), [] (const Verdict& p_a, const Verdict& p_b)
+  {
+    return p_a.nom < p_b.nom;
+  });
+  return verdicts;
+}
+
+
+/**
+ * \brief Retourne le libellé d'un état de comparaison
+ * \param[in] p_etat l'état
+ * \return le libellé affiché dans le rapport
+ */
+const char* reqNomEtat(Etat p_etat)
+{
+  switch (p_etat)
+    {
+    case Etat::Regression: return "REGRESSION";
+    case Etat::Amelioration: return "amelioration";
+    case Etat::Nouveau: return "nouveau";
+    case Etat::Absent: return "absent";
+    default: return "stable";
+    }
+}
+
+} //namespace banc
@@ -0,0 +1,111 @@
+/**
+ * \file ReferenceBenchmark.h
+ * \brief Lecture des résultats JSON de Google Benchmark et comparaison statistique
+ *        d'une exécution avec une référence enregistrée.
+ *
+ * Chaque banc doit avoir été répété (--benchmark_repetitions) : la comparaison
+ * porte sur la médiane des répétitions, l'écart absolu médian (MAD) sert
+ * d'échelle de bruit, et le test de Mann-Whitney donne la confiance que les
+ * deux séries ne proviennent pas de la même distribution.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef REFERENCEBENCHMARK_H
+#define REFERENCEBENCHMARK_H
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace banc
+{
+/**
+ * \struct Mesures
+ * \brief Durées de toutes les répétitions d'un banc, en nanosecondes.
+ */
+struct Mesures
+{
+  std::vector<double> tempsReel;
+  std::vector<double> tempsCpu;
+};
+
+/**
+ * \struct Contexte
+ * \brief Conditions d'une exécution, tirées du bloc "context" du JSON.
+ *
+ * typeCompilation est ajouté par ContexteBenchmark.h : c'est le type de
+ * compilation des bancs eux-mêmes, alors que typeBibliotheque est celui de
+ * la bibliothèque Google Benchmark.
+ */
+struct Contexte
+{
+  std::string hote;
+  int nombreCpus = 0;
+  std::string typeBibliotheque;
+  std::string typeCompilation;
+};
+
+/**
+ * \struct Resultats
+ * \brief Contexte et mesures d'une exécution
+ */
+struct Resultats
+{
+  Contexte contexte;
+  std::map<std::string, Mesures> bancs;
+};
+
+/**
+ * \struct Seuils
+ * \brief Critères qu'un écart doit tous dépasser pour être signalé.
+ */
+struct Seuils
+{
+  double variationMinimale = 0.05;
+  double nombreMad = 3.0;
+  double alpha = 0.01;
+  bool tempsCpu = false;
+};
+
+/**
+ * \enum Etat
+ * \brief Conclusion de la comparaison d'un banc.
+ */
+enum class Etat
+{
+  Stable,
+  Regression,
+  Amelioration,
+  Nouveau,
+  Absent
+};
+
+/**
+ * \struct Verdict
+ * \brief Résultat de la comparaison d'un banc avec sa référence.
+ */
+struct Verdict
+{
+  std::string nom;
+  double medianeReference;
+  double medianeNouvelle;
+  double variation;
+  double probabilite;
+  Etat etat;
+};
+
+Resultats lireDocument(std::istream& p_json);
+std::map<std::string, Mesures> lireResultats(std::istream& p_json);
+std::vector<std::string> comparerContextes(const Contexte& p_reference, const Contexte& p_nouveau);
+double mediane(std::vector<double> p_valeurs);
+double ecartAbsoluMedian(const std::vector<double>& p_valeurs);
+double probabiliteMannWhitney(const std::vector<double>& p_a, const std::vector<double>& p_b);
+std::vector<Verdict> comparer(const std::map<std::string, Mesures>& p_reference,
+                              const std::map<std::string, Mesures>& p_nouvelle,
+                              const Seuils& p_seuils);
+const char* reqNomEtat(Etat p_etat);
+} //namespace banc
+
+#endif /* REFERENCEBENCHMARK_H */
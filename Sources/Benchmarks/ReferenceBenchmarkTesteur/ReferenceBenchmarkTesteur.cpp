@@ -0,0 +1,153 @@
+/**
+ * \file ReferenceBenchmarkTesteur.cpp
+ * \brief Test unitaire de la lecture et de la comparaison des résultats de bancs d'essai.
+ *
+ * À tester :
+ *         Resultats lireDocument(std::istream& p_json);
+ *         std::map<std::string, Mesures> lireResultats(std::istream& p_json);
+ *         std::vector<std::string> comparerContextes(const Contexte& p_reference, const Contexte& p_nouveau);
+ *         std::vector<Verdict> comparer(const std::map<std::string, Mesures>& p_reference,
+ *                                       const std::map<std::string, Mesures>& p_nouvelle,
+ *                                       const Seuils& p_seuils);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ReferenceBenchmark.h"
+#include <sstream>
+#include <stdexcept>
+
+using namespace banc;
+using namespace std;
+
+namespace
+{
+/**
+ * \brief Sortie JSON réduite de Google Benchmark : deux répétitions d'un banc,
+ *        leur agrégat, et un banc en erreur
+ */
+const char* const DOCUMENT = R"({
+  "context": {
+    "host_name": "banc-01",
+    "num_cpus": 8,
+    "caches": [{"type": "Data", "level": 1}],
+    "load_avg": [0.5, 0.25, 0.125],
+    "library_build_type": "release",
+    "type_compilation": "release"
+  },
+  "benchmarks": [
+    {"name": "BM_A/8", "run_name": "BM_A/8", "run_type": "iteration", "repetitions": 2,
+     "real_time": 1.5, "cpu_time": 1.25, "time_unit": "us"},
+    {"name": "BM_A/8", "run_name": "BM_A/8", "run_type": "iteration", "repetitions": 2,
+     "real_time": 2.5, "cpu_time": 2.0, "time_unit": "us"},
+    {"name": "BM_A/8_median", "run_name": "BM_A/8", "run_type": "aggregate",
+     "real_time": 2.0, "cpu_time": 1.625, "time_unit": "us"},
+    {"name": "BM_B", "run_name": "BM_B", "run_type": "iteration", "error_occurred": true,
+     "error_message": "\"echec\"", "real_time": 0, "cpu_time": 0, "time_unit": "ns"}
+  ]
+})";
+} //namespace
+
+
+/**
+ * \brief Test de la fonction Resultats lireDocument(std::istream& p_json);
+ *     Cas valides : le contexte est lu ; seules les répétitions sans erreur
+ *                   sont retenues, converties en nanosecondes ; un contexte
+ *                   absent laisse les champs vides.
+ *     Cas invalides : aucun
+ */
+TEST(ReferenceBenchmark, lireDocument_SortieGoogleBenchmark_ContexteEtRepetitions)
+{
+  istringstream json(DOCUMENT);
+  Resultats resultats = lireDocument (json);
+  ASSERT_EQ("banc-01", resultats.contexte.hote);
+  ASSERT_EQ(8, resultats.contexte.nombreCpus);
+  ASSERT_EQ("release", resultats.contexte.typeBibliotheque);
+  ASSERT_EQ("release", resultats.contexte.typeCompilation);
+
+  ASSERT_EQ(1u, resultats.bancs.size ());
+  const Mesures& mesures = resultats.bancs.at ("BM_A/8");
+  ASSERT_EQ((vector<double> {1500, 2500}), mesures.tempsReel);
+  ASSERT_EQ((vector<double> {1250, 2000}), mesures.tempsCpu);
+
+  istringstream sansContexte(R"({"benchmarks": []})");
+  Resultats vide = lireDocument (sansContexte);
+  ASSERT_EQ(0, vide.contexte.nombreCpus);
+  ASSERT_TRUE(vide.contexte.typeCompilation.empty ());
+  ASSERT_TRUE(vide.bancs.empty ());
+}
+
+
+/**
+ * \brief Test de la fonction std::map<std::string, Mesures> lireResultats(std::istream& p_json);
+ *     Cas valide : les mesures sont celles de lireDocument.
+ *     Cas invalides : un JSON tronqué, un document sans tableau "benchmarks"
+ *                     ou un banc sans durée sont refusés.
+ */
+TEST(ReferenceBenchmark, lireResultats_DocumentValide_MemesMesures)
+{
+  istringstream json(DOCUMENT);
+  ASSERT_EQ((vector<double> {1500, 2500}), lireResultats (json).at ("BM_A/8").tempsReel);
+}
+
+TEST(ReferenceBenchmark, lireResultats_DocumentInvalide_Exception)
+{
+  istringstream tronque(R"({"benchmarks": [{"name": "BM_A")");
+  ASSERT_THROW(lireResultats (tronque), runtime_error);
+  istringstream sansBancs(R"({"context": {}})");
+  ASSERT_THROW(lireResultats (sansBancs), runtime_error);
+  istringstream sansDuree(R"({"benchmarks": [{"name": "BM_A", "run_type": "iteration"}]})");
+  ASSERT_THROW(lireResultats (sansDuree), runtime_error);
+}
+
+
+/**
+ * \brief Test de la fonction std::vector<std::string> comparerContextes(const Contexte& p_reference, const Contexte& p_nouveau);
+ *     Cas valides : des contextes identiques, ou qui ne diffèrent que par
+ *                   l'hôte, concordent.
+ *     Cas invalides : un nombre de processeurs ou un type de compilation
+ *                     différent, ou inconnu, est relevé.
+ */
+TEST(ReferenceBenchmark, comparerContextes_MemesConditions_Concordent)
+{
+  Contexte reference {"banc-01", 8, "release", "release"};
+  Contexte nouveau = reference;
+  nouveau.hote = "banc-02";
+  ASSERT_TRUE(comparerContextes (reference, nouveau).empty ());
+}
+
+TEST(ReferenceBenchmark, comparerContextes_ConditionsDifferentes_Relevees)
+{
+  Contexte reference {"banc-01", 8, "release", "release"};
+  Contexte nouveau = reference;
+  nouveau.nombreCpus = 1;
+  nouveau.typeCompilation = "debug";
+  ASSERT_EQ(2u, comparerContextes (reference, nouveau).size ());
+
+  Contexte ancien = reference;
+  ancien.typeCompilation.clear ();
+  vector<string> differences = comparerContextes (ancien, reference);
+  ASSERT_EQ(1u, differences.size ());
+  ASSERT_NE(string::npos, differences[0].find ("inconnu"));
+}
+
+
+/**
+ * \brief Test de la fonction std::vector<Verdict> comparer(...);
+ *     Cas valides : un banc nettement plus lent régresse, un banc identique
+ *                   est stable ; un banc nouveau ou disparu est signalé.
+ *     Cas invalides : aucun
+ */
+TEST(ReferenceBenchmark, comparer_BancPlusLent_Regression)
+{
+  Mesures rapide {{100, 101, 99, 100, 102, 98, 100, 101, 99}, {}};
+  Mesures lent {{150, 151, 149, 150, 152, 148, 150, 151, 149}, {}};
+  map<string, Mesures> reference {{"BM_A", rapide}, {"BM_B", rapide}, {"BM_C", rapide}};
+  map<string, Mesures> nouvelle {{"BM_A", lent}, {"BM_B", rapide}, {"BM_D", rapide}};
+  vector<Verdict> verdicts = comparer (reference, nouvelle, Seuils());
+  ASSERT_EQ(4u, verdicts.size ());
+  ASSERT_EQ(Etat::Regression, verdicts[0].etat);
+  ASSERT_EQ(Etat::Stable, verdicts[1].etat);
+  ASSERT_EQ(Etat::Absent, verdicts[2].etat);
+  ASSERT_EQ(Etat::Nouveau, verdicts[3].etat);
+}
@@ -0,0 +1,478 @@
+/**
+ * \file SourcesBenchmark.cpp
+ * \brief Mesures de référence des opérations courantes de la bibliothèque Sources.
+ *
+ * Les bancs de Client sont paramétrés par la taille du portefeuille
+ * (1 à 4096 comptes) pour rendre visible le coût des parcours linéaires.
+ * Les contrats restent au niveau Complet, comme dans les testeurs.
+ * Chaque banc rapporte aussi ses allocations et octets alloués par itération
+ * (allocs/iter, octets/iter), comptés par ComptabiliteAllocations.h.
+ *
+ * À mesurer :
+ *         void Client::ajouterCompte(const Compte& p_nouveauCompte);
+ *         void Client::supprimerCompte(int p_noCompte);
+ *         std::string Client::reqReleves() const;
+ *         Client(const Client& p_client);
+ *         double Cheque::calculerInteret() const;
+ *         double Epargne::calculerInteret() const;
+ *         Date(); Date(int p_jour, int p_mois, int p_annee);
+ *         void Date::ajouteNbJour(int p_nbjour);
+ *         int Date::operator-(const Date& p_date) const;
+ *         std::string Date::reqDateFormatee() const;
+ *         bool validerFormatNom(const std::string& p_nom);
+ *         bool validerFormatDate(const std::string& p_date);
+ *         bool validerFormatNumero(const std::string& p_numero);
+ *         bool validerFormatFichier(std::istream& p_is);
+ *         void IndexNoms::ajouter(const std::string& p_nom, const std::string& p_prenom, int p_noFolio);
+ *         std::vector<int> IndexNoms::rechercherExact(std::string_view p_nom, std::string_view p_prenom) const;
+ *         std::vector<int> IndexNoms::rechercherPrefixe(std::string_view p_prefixeNom, std::size_t p_maximum) const;
+ *         bool util::normaliserNumero(std::string_view p_numero, std::uint64_t& p_cle);
+ *         std::vector<int> IndexTelephones::rechercher(std::string_view p_telephone) const;
+ *         std::vector<int> IndexOrdonne::rechercherIntervalle(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum) const;
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include "Cheque.h"
+#include "Client.h"
+#include "ComptabiliteAllocations.h"
+#include "ContexteBenchmark.h"
+#include "Date.h"
+#include "Epargne.h"
+#include "IndexNoms.h"
+#include "IndexOrdonne.h"
+#include "IndexTelephones.h"
+#include "validationFormat.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+/**
+ * \brief Rapporte les allocations du fil faites entre sa construction et sa
+ *        destruction, ramenées au nombre d'itérations du banc
+ */
+class CompteurAllocations
+{
+public:
+  explicit CompteurAllocations (benchmark::State& p_etat)
+    : m_etat(p_etat), m_depart(metriques::reqAllocationsFil ()) { }
+
+  ~CompteurAllocations ()
+  {
+    const metriques::Allocations fin = metriques::reqAllocationsFil ();
+    m_etat.counters["allocs/iter"] = benchmark::Counter (
+            static_cast<double> (fin.allocations - m_depart.allocations), benchmark::Counter::kAvgIterations);
+    m_etat.counters["octets/iter"] = benchmark::Counter (
+            static_cast<double> (fin.octets - m_depart.octets), benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  benchmark::State& m_etat;
+  const metriques::Allocations m_depart;
+};
+
+
+/**
+ * \brief Portefeuille alterné de comptes chèque et épargne numérotés de 1 à p_nombreComptes
+ */
+Client
+clientAvecComptes (int p_nombreComptes)
+{
+  Client client(1000, "Jean", "Marie", "418 567-4213", util::Date(2, 3, 1980));
+  for (int no = 1; no <= p_nombreComptes; ++no)
+    {
+      if (no % 2 == 0)
+        {
+          client.ajouterCompte (Cheque(no, 10, 250, 4, "Loyer", 1));
+        }
+      else
+        {
+          client.ajouterCompte (Epargne(no, 1.5, 1000, "Etudes"));
+        }
+    }
+  return client;
+}
+
+
+/**
+ * \brief Nom synthétique accentué et reproductible du client p_rang
+ */
+string
+nomSynthetique (size_t p_rang)
+{
+  static const char* const SYLLABES[] = {"Tré", "bla", "Cô", "té", "ga", "gnon", "Roy", "ber", "Léo", "nard",
+                                         "Pel", "le", "tier", "Bé", "lan", "ger"};
+  string nom;
+  for (size_t reste = p_rang + 16; reste != 0; reste /= 16)
+    {
+      nom += SYLLABES[reste % 16];
+    }
+  return nom;
+}
+
+
+const IndexNoms&
+indexNoms (size_t p_nombre)
+{
+  static IndexNoms index;
+  for (size_t rang = index.reqNombreEntrees (); rang < p_nombre; ++rang)
+    {
+      index.ajouter (nomSynthetique (rang), "Jean", static_cast<int> (rang));
+    }
+  return index;
+}
+} //namespace
+
+
+static void
+BM_Client_AjouterSupprimerCompte (benchmark::State& p_etat)
+{
+  const int nombreComptes = static_cast<int> (p_etat.range (0));
+  Client client = clientAvecComptes (nombreComptes);
+  Epargne epargne(nombreComptes + 1, 1.5, 100, "Etudes");
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      client.ajouterCompte (epargne);
+      client.supprimerCompte (nombreComptes + 1);
+    }
+  p_etat.SetComplexityN (nombreComptes);
+}
+BENCHMARK(BM_Client_AjouterSupprimerCompte)->RangeMultiplier (8)->Range (1, 4096)->Complexity ();
+
+
+static void
+BM_Client_ReqReleves (benchmark::State& p_etat)
+{
+  const int nombreComptes = static_cast<int> (p_etat.range (0));
+  Client client = clientAvecComptes (nombreComptes);
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      string releves = client.reqReleves ();
+      benchmark::DoNotOptimize (releves);
+    }
+  p_etat.SetComplexityN (nombreComptes);
+  p_etat.SetItemsProcessed (p_etat.iterations () * nombreComptes);
+}
+BENCHMARK(BM_Client_ReqReleves)->RangeMultiplier (8)->Range (1, 4096)->Complexity ();
+
+
+static void
+BM_Client_Copie (benchmark::State& p_etat)
+{
+  const int nombreComptes = static_cast<int> (p_etat.range (0));
+  Client client = clientAvecComptes (nombreComptes);
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      Client copie(client);
+      benchmark::DoNotOptimize (copie);
+    }
+  p_etat.SetComplexityN (nombreComptes);
+  p_etat.SetItemsProcessed (p_etat.iterations () * nombreComptes);
+}
+BENCHMARK(BM_Client_Copie)->RangeMultiplier (8)->Range (1, 4096)->Complexity ();
+
+
+/**
+ * \brief Copie puis modification d'un seul compte : le tableau des pointeurs
+ *        est recopié, mais seul le compte modifié est cloné
+ */
+static void
+BM_Client_CopieEtModification (benchmark::State& p_etat)
+{
+  const int nombreComptes = static_cast<int> (p_etat.range (0));
+  Client client = clientAvecComptes (nombreComptes);
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      Client copie(client);
+      copie.reqCompte (1).asgSolde (1);
+      benchmark::DoNotOptimize (copie);
+    }
+  p_etat.SetComplexityN (nombreComptes);
+}
+BENCHMARK(BM_Client_CopieEtModification)->RangeMultiplier (8)->Range (1, 4096)->Complexity ();
+
+
+static void
+BM_Cheque_CalculerInteret (benchmark::State& p_etat)
+{
+  Cheque cheque(1, 10, -250, 4, "Loyer", 1);
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (cheque.calculerInteret ());
+    }
+}
+BENCHMARK(BM_Cheque_CalculerInteret);
+
+
+static void
+BM_Epargne_CalculerInteret (benchmark::State& p_etat)
+{
+  Epargne epargne(1, 1.5, 1500, "Etudes");
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (epargne.calculerInteret ());
+    }
+}
+BENCHMARK(BM_Epargne_CalculerInteret);
+
+
+static void
+BM_Date_ConstructionAujourdhui (benchmark::State& p_etat)
+{
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      util::Date date;
+      benchmark::DoNotOptimize (date);
+    }
+}
+BENCHMARK(BM_Date_ConstructionAujourdhui);
+
+
+static void
+BM_Date_ConstructionParametres (benchmark::State& p_etat)
+{
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      util::Date date(29, 2, 2000);
+      benchmark::DoNotOptimize (date);
+    }
+}
+BENCHMARK(BM_Date_ConstructionParametres);
+
+
+static void
+BM_Date_AjouteNbJour (benchmark::State& p_etat)
+{
+  const int nombreJours = static_cast<int> (p_etat.range (0));
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      util::Date date(1, 1, 2000);
+      date.ajouteNbJour (nombreJours);
+      benchmark::DoNotOptimize (date);
+    }
+}
+BENCHMARK(BM_Date_AjouteNbJour)->Arg (1)->Arg (365)->Arg (10000);
+
+
+static void
+BM_Date_Difference (benchmark::State& p_etat)
+{
+  util::Date debut(2, 3, 1980);
+  util::Date fin(31, 12, 2024);
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (fin - debut);
+    }
+}
+BENCHMARK(BM_Date_Difference);
+
+
+static void
+BM_Date_ReqDateFormatee (benchmark::State& p_etat)
+{
+  util::Date date(2, 3, 1980);
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      string texte = date.reqDateFormatee ();
+      benchmark::DoNotOptimize (texte);
+    }
+}
+BENCHMARK(BM_Date_ReqDateFormatee);
+
+
+static void
+BM_Validation_FormatNom (benchmark::State& p_etat)
+{
+  const string nom = "Jean-Marie Tremblay";
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (util::validerFormatNom (nom));
+    }
+}
+BENCHMARK(BM_Validation_FormatNom);
+
+
+static void
+BM_Validation_FormatDate (benchmark::State& p_etat)
+{
+  const string date = "02 03 1980";
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (util::validerFormatDate (date));
+    }
+}
+BENCHMARK(BM_Validation_FormatDate);
+
+
+static void
+BM_Validation_FormatNumero (benchmark::State& p_etat)
+{
+  const string numero = "418 567-4213";
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (util::validerFormatNumero (numero));
+    }
+}
+BENCHMARK(BM_Validation_FormatNumero);
+
+
+static void
+BM_Validation_FormatFichier (benchmark::State& p_etat)
+{
+  const string contenu = "Tremblay\nJean\n02 03 1980\n";
+  CompteurAllocations allocations(p_etat);
+  for (auto _ : p_etat)
+    {
+      istringstream is(contenu);
+      benchmark::DoNotOptimize (util::validerFormatFichier (is));
+    }
+}
+BENCHMARK(BM_Validation_FormatFichier);
+
+
+static void
+BM_IndexNoms_Ajouter (benchmark::State& p_etat)
+{
+  const size_t nombre = static_cast<size_t> (p_etat.range (0));
+  for (auto _ : p_etat)
+    {
+      IndexNoms index;
+      for (size_t rang = 0; rang < nombre; ++rang)
+        {
+          index.ajouter (nomSynthetique (rang), "Jean", static_cast<int> (rang));
+        }
+      benchmark::DoNotOptimize (index.reqNombreEntrees ());
+    }
+  p_etat.SetItemsProcessed (p_etat.iterations () * nombre);
+}
+BENCHMARK(BM_IndexNoms_Ajouter)->Arg (1000000)->Iterations (1)->Unit (benchmark::kMillisecond);
+
+
+static void
+BM_IndexNoms_RechercherExact (benchmark::State& p_etat)
+{
+  const IndexNoms& index = indexNoms (1000000);
+  size_t rang = 0;
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (index.rechercherExact (nomSynthetique (rang)));
+      rang = (rang + 7919) % 1000000;
+    }
+}
+BENCHMARK(BM_IndexNoms_RechercherExact);
+
+
+static void
+BM_IndexNoms_RechercherPrefixe (benchmark::State& p_etat)
+{
+  const IndexNoms& index = indexNoms (1000000);
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (index.rechercherPrefixe ("tregnonle", 50));
+    }
+}
+BENCHMARK(BM_IndexNoms_RechercherPrefixe);
+
+
+static void
+BM_Validation_NormaliserNumero (benchmark::State& p_etat)
+{
+  uint64_t cle = 0;
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (util::normaliserNumero ("(418) 555-1234", cle));
+      benchmark::DoNotOptimize (cle);
+    }
+}
+BENCHMARK(BM_Validation_NormaliserNumero);
+
+
+static void
+BM_IndexTelephones_Rechercher (benchmark::State& p_etat)
+{
+  const int64_t nombre = 1000000;
+  static IndexTelephones index;
+  for (int64_t rang = static_cast<int64_t> (index.reqNombreEntrees ()); rang < nombre; ++rang)
+    {
+      index.ajouter (to_string (4180000000LL + rang * 7919), static_cast<int> (rang));
+    }
+  int64_t rang = 0;
+  char numero[16];
+  for (auto _ : p_etat)
+    {
+      snprintf (numero, sizeof (numero), "%lld", static_cast<long long> (4180000000LL + rang * 7919));
+      benchmark::DoNotOptimize (index.rechercher (numero));
+      rang = (rang + 104729) % nombre;
+    }
+}
+BENCHMARK(BM_IndexTelephones_Rechercher);
+
+
+/**
+ * \brief Rapport des clients nés en 1983 parmi un million : par l'index
+ *        ordonné, puis en comparaison par un parcours complet suivi d'un tri
+ */
+static void
+BM_IndexOrdonne_RechercherIntervalle (benchmark::State& p_etat)
+{
+  const int nombre = 1000000;
+  static IndexOrdonne index;
+  for (int rang = static_cast<int> (index.reqNombreEntrees ()); rang < nombre; ++rang)
+    {
+      const int jour = (rang * 7919) % (60 * 365);
+      index.ajouter ((1950 + jour / 365) * 10000 + (jour % 365 / 31 + 1) * 100 + jour % 31 + 1, rang);
+    }
+  for (auto _ : p_etat)
+    {
+      benchmark::DoNotOptimize (index.rechercherIntervalle (19830101, 19831231));
+    }
+}
+BENCHMARK(BM_IndexOrdonne_RechercherIntervalle)->Unit (benchmark::kMicrosecond);
+
+
+static void
+BM_IndexOrdonne_ParcoursEtTri (benchmark::State& p_etat)
+{
+  const int nombre = 1000000;
+  static vector<pair<int64_t, int>> clients;
+  for (int rang = static_cast<int> (clients.size ()); rang < nombre; ++rang)
+    {
+      const int jour = (rang * 7919) % (60 * 365);
+      clients.emplace_back ((1950 + jour / 365) * 10000 + (jour % 365 / 31 + 1) * 100 + jour % 31 + 1, rang);
+    }
+  for (auto _ : p_etat)
+    {
+      vector<pair<int64_t, int>> retenus;
+      for (const auto& client : clients)
+        {
+          if (client.first >= 19830101 && client.first <= 19831231)
+            {
+              retenus.push_back (client);
+            }
+        }
+      sort (retenus.begin (), retenus.end ());
+      benchmark::DoNotOptimize (retenus.data ());
+    }
+}
+BENCHMARK(BM_IndexOrdonne_ParcoursEtTri)->Unit (benchmark::kMicrosecond);
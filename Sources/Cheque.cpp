@@ -8,6 +8,8 @@
 #include"ContratException.h"
 #include"Date.h"
 #include"Compte.h"
+#include"Metriques.h"
+#include"Trace.h"
 #include<memory>
 #include<sstream>
 
@@ -129,6 +131,7 @@ void Cheque::asgNombreTransactions(int p_nombreTransactions)
  */
 double Cheque::calculerInteret() const
 {
+  MESURER(CompteCalculerInteret);
   if (reqSolde()>=0)
     {
       return 0;
@@ -163,6 +166,8 @@ double Cheque::calculerInteret() const
  */
 std::string Cheque::reqCompteFormate()  const
 {
+  MESURER(CompteReqCompteFormate);
+  TRACE_SCOPE("Cheque::reqCompteFormate");
   ostringstream os;
   os<<"Compte Cheque"<<endl;
   os<<Compte::reqCompteFormate ();
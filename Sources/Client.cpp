@@ -5,19 +5,41 @@
  * \version 1.0
  */
 #include"Client.h"
+#include"ArenaComptes.h"
 #include"ContratException.h"
+#include"Metriques.h"
+#include"Trace.h"
 #include"Compte.h"
 #include"Date.h"
 #include"validationFormat.h"
 #include "CompteException.h"
 #include<sstream>
 #include <algorithm>
+#include <atomic>
 
 
 using namespace std;
 
 namespace bancaire
 {
+namespace
+{
+/**
+ * \brief Confie un compte à un shared_ptr dont le bloc de contrôle est pris,
+ *        comme le compte, dans l'arène active s'il y en a une
+ * \param[in] p_compte le compte à partager
+ * \return le pointeur partagé qui possède désormais le compte
+ */
+shared_ptr<Compte>
+partager (unique_ptr<Compte> p_compte)
+{
+  // en cas d'échec d'allocation, le constructeur détruit lui-même le compte
+  Compte* compte = p_compte.release ();
+  return shared_ptr<Compte>(compte, default_delete<Compte>(), ArenaComptes::Allocateur<Compte>());
+}
+} //namespace
+
+
 /**
  * \brief Constructeur de la classe Client
  *        On construit un objet Client à partir de valeurs passées en paramètres.
@@ -60,21 +82,18 @@ Client::Client(int p_noFolio, const std::string& p_nom, const std::string& p_pre
 /**
  * \brief Constructeur copie de la classe Client
  *        On réalise une copie à partir d'un objet Client en paramètre.
- *        Les attributs sont assignés seulement si les renseignements 
- *        fournis sont considérés comme valides.
- *        Autrement, une erreur de précondition est générée.
+ *        Le portefeuille n'est pas cloné : il est partagé, puis copié à
+ *        l'écriture par celui des deux clients qui le modifie.
  * \param[in] p_client est un objet Client qui représente un client
  * \post La copie a été réalisée à partir des attributs de l'objet Client passé en paramètre
  */
 Client::Client(const Client& p_client) : m_noFolio(p_client.m_noFolio), 
         m_nom(p_client.m_nom), m_prenom(p_client.m_prenom), 
-        m_telephone(p_client.m_telephone),m_dateNaissance(p_client.m_dateNaissance)
+        m_telephone(p_client.m_telephone),m_dateNaissance(p_client.m_dateNaissance),
+        m_comptes(p_client.m_comptes)
 {
-  
-  for(const auto& element : p_client.m_comptes)
-    {
-      m_comptes.push_back (element->clone());
-    }
+  MESURER(ClientCopie);
+  TRACE_SCOPE("Client::Client(const Client&)");
   
   POSTCONDITION(m_noFolio==p_client.m_noFolio);
   POSTCONDITION(m_nom==p_client.m_nom);
@@ -84,13 +103,31 @@ Client::Client(const Client& p_client) : m_noFolio(p_client.m_noFolio),
   
   INVARIANTS();
 }
+/**
+ * \brief Constructeur de déplacement de la classe Client
+ *        Les comptes sont transférés sans être clonés ; l'objet source
+ *        ne doit plus être utilisé que pour être détruit ou réassigné.
+ * \param[in] p_client est un objet Client dont on prend les ressources
+ */
+Client::Client(Client&& p_client) noexcept = default;
+
+
+/**
+ * \brief Destructeur de la classe Client
+ *        Les comptes du portefeuille sont détruits en bloc, sans revérifier
+ *        leurs invariants : chaque mutation les a déjà vérifiés.
+ */
+Client::~Client()
+{
+  viderComptes ();
+}
+
+
 /**
  * \brief Opérateur copie de la classe Client
  *        On surcharge l'opérateur "=" pour permettre une copie avec "="
  *        à partir d'un objet Client en paramètre.
- *        Les attributs sont assignés seulement si les renseignements 
- *        fournis sont considérés comme valides.
- *        Autrement, une erreur de précondition est générée.
+ *        Le portefeuille est partagé, comme pour le constructeur copie.
  * \param[in] p_client est un objet Client qui représente un client
  * \post La copie a été réalisée à partir des attributs de l'objet Client passé en paramètre
  */
@@ -103,12 +140,10 @@ Client& Client::operator=(const Client& p_client)
       m_prenom = p_client.m_prenom;
       m_telephone = p_client.m_telephone;
       m_dateNaissance = p_client.m_dateNaissance;
-      m_comptes.clear ();
-      
-      for(const auto& element : p_client.m_comptes)
-        {
-          m_comptes.push_back (element->clone());
-        }
+      {
+        contrat::SuspensionInvariants suspension;
+        m_comptes = p_client.m_comptes;
+      }
       
   POSTCONDITION(m_noFolio==p_client.m_noFolio);
   POSTCONDITION(m_nom==p_client.m_nom);
@@ -124,6 +159,14 @@ Client& Client::operator=(const Client& p_client)
 }
 
 
+/**
+ * \brief Opérateur de déplacement de la classe Client
+ *        Les comptes sont transférés sans être clonés.
+ * \param[in] p_client est un objet Client dont on prend les ressources
+ */
+Client& Client::operator=(Client&& p_client) noexcept = default;
+
+
 /**
  * \brief Retourne le numéro du folio du client
  * \return un entier qui représente le numéro du folio
@@ -180,7 +223,71 @@ const util::Date& Client::reqDateNaissance() const
  */
 size_t Client::reqComptes() const
 {
-  return m_comptes.size();
+  return reqPortefeuille ().size();
+}
+
+
+/**
+ * \brief Retourne un compte du client à partir de son numéro
+ * \param[in] p_noCompte Le numéro du compte recherché.
+ * \return une référence constante vers le compte
+ * \exception CompteAbsentException Levée si aucun compte ne correspond au numéro fourni.
+ */
+const Compte& Client::reqCompte(int p_noCompte) const
+{
+  MESURER(ClientReqCompte);
+  for (const auto& compte : reqPortefeuille ())
+    {
+      if(compte->reqNoCompte()== p_noCompte)
+        {
+          return *compte;
+        }
+    }
+  throw CompteAbsentException("Il n'existe aucun compte avec le numero "+ to_string(p_noCompte));
+}
+
+
+/**
+ * \brief Retourne un compte modifiable du client à partir de son numéro
+ *        Si le compte est partagé avec une copie du client, il est d'abord
+ *        cloné : seul ce compte l'est, les autres restent partagés.
+ * \param[in] p_noCompte Le numéro du compte recherché.
+ * \return une référence vers le compte, qui n'appartient qu'à ce client
+ * \exception CompteAbsentException Levée si aucun compte ne correspond au numéro fourni.
+ */
+Compte& Client::reqCompte(int p_noCompte)
+{
+  const Compte& trouve = static_cast<const Client&>(*this).reqCompte (p_noCompte);
+  Portefeuille& comptes = reqPortefeuilleModifiable ();
+  auto compte = find_if (comptes.begin (), comptes.end (), [&trouve] (const shared_ptr<Compte>& p_compte)
+  {
+    return p_compte.get () == &trouve;
+  });
+  if (compte->use_count () > 1)
+    {
+      *compte = partager (trouve.clone ());
+    }
+  else
+    {
+      // use_count est une lecture relâchée : la barrière ordonne la mutation
+      // après la libération par un autre fil du dernier autre propriétaire.
+      atomic_thread_fence (memory_order_acquire);
+    }
+  return **compte;
+}
+
+
+/**
+ * \brief Présente chaque compte du client, dans l'ordre du portefeuille
+ *        Destinée aux traitements qui lisent tout le portefeuille (index, requêtes).
+ * \param[in] p_visiteur la fonction appelée pour chaque compte
+ */
+void Client::parcourirComptes(const std::function<void(const Compte&)>& p_visiteur) const
+{
+  for (const auto& compte : reqPortefeuille ())
+    {
+      p_visiteur (*compte);
+    }
 }
 
 
@@ -207,17 +314,85 @@ bool Client::operator<(const Client& p_client) const
  */
 void Client::ajouterCompte(const Compte& p_nouveauCompte)
 { 
-  if(!compteEstDejaPresent (p_nouveauCompte.reqNoCompte ()))
+  if(try_ajouterCompte (p_nouveauCompte) == ResultatCompte::CompteDejaPresent)
     {
-      m_comptes.push_back (p_nouveauCompte.clone ());
+      throw CompteDejaPresentException("Il existe deja un compte avec le numero "+ to_string(p_nouveauCompte.reqNoCompte ()));
     }
-  else
+}
+
+
+/**
+ * \brief Ajoute un nouveau compte au portefeuille du client sans lever d'exception.
+ * 
+ * Variante de ajouterCompte pour les traitements en lot : un refus ne coûte
+ * ni construction de message ni déroulement de pile.
+ * 
+ * \param[in] p_nouveauCompte Le compte à ajouter.
+ * \return ResultatCompte::Succes, ou ResultatCompte::CompteDejaPresent si un compte
+ *         avec ce numéro est déjà présent (le portefeuille est alors inchangé).
+ * \post Le compte est présent dans le portefeuille du client après l'exécution de la méthode.
+ */
+ResultatCompte Client::try_ajouterCompte(const Compte& p_nouveauCompte)
+{
+  MESURER(ClientAjouterCompte);
+  if(compteEstDejaPresent (p_nouveauCompte.reqNoCompte ()))
     {
-      throw CompteDejaPresentException("Il existe deja un compte avec le numero "+ to_string(p_nouveauCompte.reqNoCompte ()));
+      return ResultatCompte::CompteDejaPresent;
     }
+  reqPortefeuilleModifiable ().push_back (partager (p_nouveauCompte.clone ()));
   
   POSTCONDITION(compteEstDejaPresent (p_nouveauCompte.reqNoCompte ()));
   INVARIANTS();
+  
+  return ResultatCompte::Succes;
+}
+
+
+/**
+ * \brief Ajoute d'un seul coup un ensemble de comptes déjà construits au portefeuille.
+ * 
+ * Destinée à la reconstruction de gros portefeuilles (récupération, chargement) :
+ * les comptes sont transférés sans clone, les doublons sont détectés par un tri
+ * des numéros plutôt que par une recherche par compte, et l'invariant du client
+ * n'est vérifié qu'une fois pour tout le bloc.
+ * 
+ * \param[in] p_comptes Les comptes à ajouter, dans l'ordre du portefeuille.
+ * \exception CompteDejaPresentException Levée si un numéro est en double dans le bloc
+ *            ou déjà présent dans le portefeuille ; le portefeuille est alors inchangé.
+ * \post Tous les comptes du bloc sont présents dans le portefeuille du client.
+ */
+void Client::ajouterComptesEnBloc(std::vector<std::unique_ptr<Compte>> p_comptes)
+{
+  MESURER(ClientAjouterComptesEnBloc);
+  TRACE_SCOPE("Client::ajouterComptesEnBloc");
+  TRACE_COUNT("comptes en bloc", p_comptes.size ());
+  vector<int> numeros;
+  numeros.reserve (reqPortefeuille ().size () + p_comptes.size ());
+  for (const auto& compte : reqPortefeuille ())
+    {
+      numeros.push_back (compte->reqNoCompte ());
+    }
+  for (const auto& compte : p_comptes)
+    {
+      numeros.push_back (compte->reqNoCompte ());
+    }
+  sort (numeros.begin (), numeros.end ());
+  auto doublon = adjacent_find (numeros.begin (), numeros.end ());
+  if (doublon != numeros.end ())
+    {
+      throw CompteDejaPresentException("Il existe deja un compte avec le numero "+ to_string(*doublon));
+    }
+
+  const size_t tailleAttendue = numeros.size ();
+  Portefeuille& comptes = reqPortefeuilleModifiable ();
+  comptes.reserve (tailleAttendue);
+  for (auto& compte : p_comptes)
+    {
+      comptes.push_back (partager (move (compte)));
+    }
+
+  POSTCONDITION(reqComptes () == tailleAttendue);
+  INVARIANTS();
 }
 
 
@@ -233,19 +408,65 @@ void Client::ajouterCompte(const Compte& p_nouveauCompte)
  */
 void Client::supprimerCompte(int p_noCompte)
 {
-  vector<unique_ptr<Compte>>::iterator it;  
-  for (it = m_comptes.begin(); it != m_comptes.end(); ++it)
+  if(try_supprimerCompte (p_noCompte) == ResultatCompte::CompteAbsent)
+    {
+      throw CompteAbsentException("Vous ne pouvez pas supprimer un compte qui n'existe pas");
+    }
+}
+
+
+/**
+ * \brief Supprime un compte du portefeuille du client sans lever d'exception.
+ * 
+ * \param[in] p_noCompte Le numéro du compte à supprimer.
+ * \return ResultatCompte::Succes, ou ResultatCompte::CompteAbsent si aucun compte
+ *         ne correspond au numéro fourni.
+ * \post Aucun compte du portefeuille du client ne possède le numéro spécifié après l'exécution de la méthode.
+ */
+ResultatCompte Client::try_supprimerCompte(int p_noCompte)
+{
+  MESURER(ClientSupprimerCompte);
+  if(!compteEstDejaPresent (p_noCompte))
+    {
+      return ResultatCompte::CompteAbsent;
+    }
+  Portefeuille& comptes = reqPortefeuilleModifiable ();
+  Portefeuille::iterator it;  
+  for (it = comptes.begin(); it != comptes.end(); ++it)
     {
       if((*it)->reqNoCompte()== p_noCompte)
         {
-          m_comptes.erase (it);
-          return;
+          comptes.erase (it);
+          
+          POSTCONDITION(!compteEstDejaPresent (p_noCompte));
+          INVARIANTS();
+          
+          return ResultatCompte::Succes;
         }
     }
-   throw CompteAbsentException("Vous ne pouvez pas supprimer un compte qui n'existe pas");
+  return ResultatCompte::CompteAbsent;
+}
 
-  POSTCONDITION(!compteEstDejaPresent (p_noCompte));
-  INVARIANTS();
+
+/**
+ * \brief Détruit d'un coup tous les comptes du portefeuille du client.
+ * 
+ * Les invariants des comptes ne sont pas revérifiés pendant leur destruction,
+ * et les comptes construits dans une ArenaComptes ne rendent leur mémoire
+ * qu'au moment où l'arène entière est libérée. Un portefeuille ou un compte
+ * encore partagé avec une copie du client n'est pas détruit.
+ * 
+ * \post Le portefeuille du client est vide.
+ */
+void Client::viderComptes()
+{
+  MESURER(ClientViderComptes);
+  {
+    contrat::SuspensionInvariants suspension;
+    m_comptes.reset ();
+  }
+  
+  POSTCONDITION(reqComptes () == 0);
 }
 
 
@@ -256,6 +477,7 @@ void Client::supprimerCompte(int p_noCompte)
  */
 std::string Client::reqClientFormate() const
 {
+  MESURER(ClientReqClientFormate);
   ostringstream os;
   os<<"Client no de folio : "<<reqNoFolio ()<<endl;
   os<<reqPrenom ()<<" "<<reqNom ()<<endl;
@@ -272,11 +494,14 @@ std::string Client::reqClientFormate() const
  */
 std::string Client::reqReleves() const
 { 
+  MESURER(ClientReqReleves);
+  TRACE_SCOPE("Client::reqReleves");
   ostringstream os;
   os<<reqClientFormate();
-  for (size_t i =0; i< m_comptes.size (); i++)
+  const Portefeuille& comptes = reqPortefeuille ();
+  for (size_t i =0; i< comptes.size (); i++)
     {
-       os<<m_comptes[i]->reqCompteFormate();
+       os<<comptes[i]->reqCompteFormate();
     }
   return os.str();
 }
@@ -294,8 +519,9 @@ std::string Client::reqReleves() const
 bool Client::compteEstDejaPresent(int p_noCompte) const
 { 
   bool present = false;
-  vector<unique_ptr<Compte>>::const_iterator it;
-  for (it = m_comptes.begin(); it != m_comptes.end(); ++it)
+  Portefeuille::const_iterator it;
+  const Portefeuille& comptes = reqPortefeuille ();
+  for (it = comptes.begin(); it != comptes.end(); ++it)
     {
       if((*it)->reqNoCompte()== p_noCompte)
         {
@@ -306,6 +532,44 @@ bool Client::compteEstDejaPresent(int p_noCompte) const
   return present;
 }
 
+/**
+ * \brief Retourne le portefeuille du client en lecture
+ *        Un client sans portefeuille lit un portefeuille vide commun, qui
+ *        n'est jamais partagé par compteur de références ni modifié.
+ * \return une référence constante vers le portefeuille
+ */
+const Client::Portefeuille& Client::reqPortefeuille() const
+{
+  static const Portefeuille vide;
+  return m_comptes ? *m_comptes : vide;
+}
+
+
+/**
+ * \brief Retourne le portefeuille du client, créé d'abord s'il n'en a pas, ou
+ *        copié s'il est partagé avec une copie du client ; les comptes
+ *        eux-mêmes restent partagés.
+ * \return une référence vers le portefeuille, qui n'appartient qu'à ce client
+ */
+Client::Portefeuille& Client::reqPortefeuilleModifiable()
+{
+  if (!m_comptes)
+    {
+      m_comptes = allocate_shared<Portefeuille>(ArenaComptes::Allocateur<Portefeuille>());
+    }
+  else if (m_comptes.use_count () > 1)
+    {
+      m_comptes = allocate_shared<Portefeuille>(ArenaComptes::Allocateur<Portefeuille>(), *m_comptes);
+    }
+  else
+    {
+      // Voir reqCompte : le portefeuille a pu être libéré par un autre fil.
+      atomic_thread_fence (memory_order_acquire);
+    }
+  return *m_comptes;
+}
+
+
 /**
  * \brief Teste les invariants de la classe Client. 
  * \invariant m_noFolio doit correspondre à un entier dans l'intervalle [1000, 10000[
@@ -8,8 +8,11 @@
 #define CLIENT_H
 #include<string>
 #include"Compte.h"
+#include"CompteException.h"
 #include"Date.h"
 #include<vector>
+#include<functional>
+#include<memory>
 
 namespace bancaire
 {
@@ -24,6 +27,21 @@ namespace bancaire
  * Elle est liée à la classe Compte par une relation de composition et fournit
  * un ensemble de méthodes qui permettent, entre autres, d'ajouter un nouveau
  * compte, d'accéder à ses renseignements personnels, relevés, etc.
+ *
+ * Les copies d'un client partagent son portefeuille : la copie ne coûte
+ * qu'un compteur de références. Le portefeuille et ses comptes sont copiés à
+ * l'écriture ; une mutation ne recopie que le tableau des pointeurs et clone
+ * seulement le compte modifié, les autres restant partagés. Un client sans
+ * compte n'a pas de portefeuille du tout : le copier ne touche aucun compteur.
+ * Les blocs de contrôle des comptes et des portefeuilles passent par
+ * ArenaComptes::allouer, et sont donc pris dans l'arène d'une Portee active.
+ *
+ * Contrat de fils : un même objet Client n'est pas synchronisé, mais des
+ * copies distinctes peuvent être lues et modifiées par des fils différents,
+ * et détruites dans n'importe quel fil, sans autre précaution. Un compte ou
+ * un portefeuille n'est modifié en place que lorsque ce client en est le seul
+ * propriétaire ; une barrière d'acquisition ordonne alors la mutation après
+ * la libération des autres copies.
  */
 class Client
 {
@@ -31,7 +49,10 @@ public:
   Client(int p_noFolio, const std::string& p_nom, const std::string& p_prenom,
          const std::string& p_telephone, const util::Date& p_dateNaissance);
   Client(const Client& p_client);
+  Client(Client&& p_client) noexcept;
+  ~Client();
   Client& operator=(const Client& p_client);
+  Client& operator=(Client&& p_client) noexcept;
   
   //accesseurs
   int reqNoFolio() const;
@@ -42,9 +63,16 @@ public:
   
   //methodes
   size_t reqComptes() const;
+  const Compte& reqCompte(int p_noCompte) const;
+  Compte& reqCompte(int p_noCompte);
+  void parcourirComptes(const std::function<void(const Compte&)>& p_visiteur) const;
   bool operator<(const Client& p_client) const; 
   void ajouterCompte(const Compte& p_nouveauCompte);
+  [[nodiscard]] ResultatCompte try_ajouterCompte(const Compte& p_nouveauCompte);
+  void ajouterComptesEnBloc(std::vector<std::unique_ptr<Compte>> p_comptes);
   void supprimerCompte(int p_noCompte);
+  [[nodiscard]] ResultatCompte try_supprimerCompte(int p_noCompte);
+  void viderComptes();
   std::string reqClientFormate() const;  
   std::string reqReleves() const;  
   
@@ -56,7 +84,10 @@ private:
   std::string m_prenom;
   std::string m_telephone;
   util::Date m_dateNaissance;
-  std::vector<std::unique_ptr<Compte>> m_comptes;
+  typedef std::vector<std::shared_ptr<Compte>> Portefeuille;
+  std::shared_ptr<Portefeuille> m_comptes;
+  const Portefeuille& reqPortefeuille() const;
+  Portefeuille& reqPortefeuilleModifiable();
   bool compteEstDejaPresent(int p_noCompte) const;
   void verifieInvariant() const;
 };
@@ -0,0 +1,37 @@
+/**
+ * \file ClientException.cpp
+ * \brief Implantation de la classe ClientException et de ses héritiers
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "ClientException.h"
+
+using namespace std;
+
+
+/**
+ * \brief Constructeur de la classe de base ClientException
+ * \param p_raison chaîne de caractères représentant la raison de l'erreur
+ */
+ClientException::ClientException(const std::string& p_raison): 
+                std::runtime_error(p_raison){}
+
+
+/**
+ * \brief Constructeur de la classe ClientDejaPresentException en initialisant la classe de base ClientException.
+ *        La classe représente des erreurs liees a l'ajout d'un client
+ *        avec un numero de folio deja present dans la banque.
+ * \param p_raison chaîne de caractères représentant la raison de l'erreur
+ */
+ClientDejaPresentException::ClientDejaPresentException(const std::string& p_raison):
+                            ClientException(p_raison){}
+
+
+/**
+ * \brief Constructeur de la classe ClientAbsentException en initialisant la classe de base ClientException.
+ *        La classe représente des erreurs liees a la requete pour acceder a un client
+ *        qui n'existe pas dans la banque.
+ * \param p_raison chaîne de caractères représentant la raison de l'erreur
+ */
+ClientAbsentException::ClientAbsentException(const std::string& p_raison):
+                       ClientException(p_raison){}
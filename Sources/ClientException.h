@@ -0,0 +1,64 @@
+/**
+ * \file ClientException.h qui contient l'interface de la classe ClientException et de ses héritiers.
+ * \brief Hiérarchie de classe pour la gestion des erreurs liées aux clients d'une banque.
+ *
+ * Ces classes constituent la hiérarchie pour la gestion de 
+ * l’exception liée aux clients. Elle maintient les données nécessaires à
+ * la sauvegarde des renseignements de l'erreur.
+ *
+ * <pre>
+ * Classes:
+ * std::runtime_error              Classe de base des exceptions a l'execution d'une requete.
+ * ClientException:                Classe de base des exceptions de client.
+ * ClientDejaPresentException:     Classe de gestion des erreurs d'existence de Client.
+ * ClientAbsentException:          Classe de gestion des erreurs d'absence de Client.
+ * 
+ * </pre>
+ * 
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+
+#ifndef CLIENTEXCEPTION_H
+#define CLIENTEXCEPTION_H
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * \class ClientException
+ * \brief Classe de base des exceptions de client.
+ */
+class ClientException : public std::runtime_error
+{
+  public:
+    ClientException(const std::string& p_raison);
+    ~ClientException() throw() {};
+};
+
+/**
+ * \class ClientDejaPresentException
+ * \brief Classe pour la gestion des erreurs de client deja present.
+ */
+
+class ClientDejaPresentException : public ClientException
+{
+public:
+  ClientDejaPresentException(const std::string& p_raison);
+};
+
+
+/**
+ * \class ClientAbsentException
+ * \brief Classe pour la gestion des erreurs de client absent
+ */
+
+class ClientAbsentException : public ClientException
+{
+public:
+  ClientAbsentException(const std::string& p_raison);
+};
+
+
+#endif /* CLIENTEXCEPTION_H */
+
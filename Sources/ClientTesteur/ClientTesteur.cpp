@@ -12,6 +12,13 @@
  *          const std::string& reqPrenom() const; 
  *          const std::string& reqTelephone() const;
  *          const util::Date& reqDateNaissance() const;
+ *          const Compte& reqCompte(int p_noCompte) const;
+ *          Compte& reqCompte(int p_noCompte);
+ *          void ajouterComptesEnBloc(std::vector<std::unique_ptr<Compte>> p_comptes);
+ *          ResultatCompte try_ajouterCompte(const Compte& p_nouveauCompte);
+ *          ResultatCompte try_supprimerCompte(int p_noCompte);
+ *          void viderComptes();
+ *          void parcourirComptes(const std::function<void(const Compte&)>& p_visiteur) const;
  *
  */
 
@@ -317,3 +324,172 @@ TEST_F(ClientTest2, supprimerCompte_CompteNonExistant_CompteAbsentException)
   ASSERT_THROW(f_client.supprimerCompte (5400), CompteAbsentException)
                 <<"Echec du test de CompteAbsentException, y'a bien un compte existant.";
 }
+
+
+/**
+ * \brief Test de la méthode const Compte& reqCompte(int p_noCompte) const;
+ *        Cas valide : reqCompte_CompteExistant — retourne le compte ayant ce numéro.
+ *        Cas invalide : reqCompte_CompteNonExistant — lève une CompteAbsentException.
+ */
+TEST_F(ClientTest2, reqCompte_CompteExistant_CompteRetourne)
+{
+  f_client.ajouterCompte (unCompte);
+  f_client.ajouterCompte (unCheque);
+  ASSERT_EQ(unCheque.reqCompteFormate (), f_client.reqCompte (1280).reqCompteFormate ());
+  
+  f_client.reqCompte (1000).asgSolde (300);
+  ASSERT_EQ(300, f_client.reqCompte (1000).reqSolde ());
+}
+
+TEST_F(ClientTest2, reqCompte_CompteNonExistant_CompteAbsentException)
+{
+  ASSERT_THROW(f_client.reqCompte (5400), CompteAbsentException);
+}
+
+
+/**
+ * \brief Test de la méthode void ajouterComptesEnBloc(std::vector<std::unique_ptr<Compte>> p_comptes);
+ *        Cas valide : ajouterComptesEnBloc_ComptesDistincts — tous les comptes sont ajoutés dans l'ordre.
+ *        Cas invalide : ajouterComptesEnBloc_Doublon — lève une CompteDejaPresentException
+ *                       et laisse le portefeuille inchangé.
+ */
+TEST_F(ClientTest2, ajouterComptesEnBloc_ComptesDistincts_ComptesAjoutes)
+{
+  f_client2.ajouterCompte (unCheque);
+  vector<unique_ptr<Compte>> comptes;
+  comptes.push_back (unCompte.clone ());
+  comptes.push_back (make_unique<Epargne>(1001, 1.5, 50, "Voyage"));
+  f_client2.ajouterComptesEnBloc (move (comptes));
+  
+  ASSERT_EQ(3, f_client2.reqComptes ());
+  ostringstream os;
+  os<<f_client2.reqClientFormate ();
+  os<<unCheque.reqCompteFormate ();
+  os<<unCompte.reqCompteFormate ();
+  os<<Epargne(1001, 1.5, 50, "Voyage").reqCompteFormate ();
+  ASSERT_EQ(os.str (), f_client2.reqReleves ());
+}
+
+TEST_F(ClientTest2, ajouterComptesEnBloc_Doublon_CompteDejaPresentException)
+{
+  f_client2.ajouterCompte (unCompte);
+  vector<unique_ptr<Compte>> comptes;
+  comptes.push_back (unCheque.clone ());
+  comptes.push_back (unCompte.clone ());
+  ASSERT_THROW(f_client2.ajouterComptesEnBloc (move (comptes)), CompteDejaPresentException);
+  ASSERT_EQ(1, f_client2.reqComptes ());
+}
+
+
+/**
+ * \brief Test des méthodes ResultatCompte try_ajouterCompte(const Compte& p_nouveauCompte);
+ *        et ResultatCompte try_supprimerCompte(int p_noCompte);
+ *        Cas valides : l'ajout et la suppression d'un compte retournent Succes.
+ *        Cas invalides : un compte déjà présent retourne CompteDejaPresent,
+ *                        un compte absent retourne CompteAbsent, sans exception.
+ */
+TEST_F(ClientTest2, try_ajouterCompte_CompteValide_Succes)
+{
+  ASSERT_EQ(ResultatCompte::Succes, f_client2.try_ajouterCompte (unCompte));
+  ASSERT_EQ(1, f_client2.reqComptes ());
+}
+
+TEST_F(ClientTest2, try_ajouterCompte_CompteDejaPresent_CodeCompteDejaPresent)
+{
+  f_client2.ajouterCompte (unCompte);
+  ASSERT_EQ(ResultatCompte::CompteDejaPresent, f_client2.try_ajouterCompte (unCompte));
+  ASSERT_EQ(1, f_client2.reqComptes ());
+}
+
+TEST_F(ClientTest2, try_supprimerCompte_CompteExistant_Succes)
+{
+  f_client.ajouterCompte (unCheque);
+  ASSERT_EQ(ResultatCompte::Succes, f_client.try_supprimerCompte (unCheque.reqNoCompte ()));
+  ASSERT_EQ(0, f_client.reqComptes ());
+}
+
+TEST_F(ClientTest2, try_supprimerCompte_CompteNonExistant_CodeCompteAbsent)
+{
+  ASSERT_EQ(ResultatCompte::CompteAbsent, f_client.try_supprimerCompte (5400));
+}
+
+
+/**
+ * \brief Test de la méthode void viderComptes();
+ *        Cas valide : tous les comptes sont détruits et le client reste utilisable.
+ *        Cas invalide : aucun
+ */
+TEST_F(ClientTest2, viderComptes_PortefeuilleRempli_PortefeuilleVide)
+{
+  f_client.ajouterCompte (unCheque);
+  f_client.ajouterCompte (unCompte);
+  f_client.viderComptes ();
+  ASSERT_EQ(0, f_client.reqComptes ());
+  ASSERT_EQ(ResultatCompte::Succes, f_client.try_ajouterCompte (unCheque));
+}
+
+
+/**
+ * \brief Test de la méthode void parcourirComptes(const std::function<void(const Compte&)>& p_visiteur) const;
+ *        Cas valide : chaque compte est présenté une fois, dans l'ordre d'ajout.
+ *        Cas invalide : aucun
+ */
+TEST_F(ClientTest2, parcourirComptes_PortefeuilleRempli_ComptesDansLOrdre)
+{
+  f_client.ajouterCompte (unCheque);
+  f_client.ajouterCompte (unCompte);
+  vector<int> numeros;
+  f_client.parcourirComptes ([&numeros] (const Compte& p_compte)
+  {
+    numeros.push_back (p_compte.reqNoCompte ());
+  });
+  ASSERT_EQ((vector<int> {unCheque.reqNoCompte (), unCompte.reqNoCompte ()}), numeros);
+}
+
+
+/**
+ * \brief Test du partage copie à l'écriture entre Client(const Client& p_client)
+ *        et Compte& reqCompte(int p_noCompte);
+ *     Cas valides : une copie partage les comptes ; modifier un compte de la
+ *                   copie ne clone que ce compte et ne touche pas l'original.
+ *     Cas invalide : aucun
+ */
+TEST_F(ClientTest2, reqCompte_CopieModifiee_SeulCompteModifieClone)
+{
+  f_client.ajouterCompte (unCompte);
+  f_client.ajouterCompte (unCheque);
+  Client copie(f_client);
+  ASSERT_EQ(&static_cast<const Client&> (f_client).reqCompte (1000), &static_cast<const Client&> (copie).reqCompte (1000));
+
+  copie.reqCompte (1000).asgSolde (10);
+  ASSERT_EQ(10, copie.reqCompte (1000).reqSolde ());
+  ASSERT_EQ(25000, static_cast<const Client&> (f_client).reqCompte (1000).reqSolde ());
+  ASSERT_NE(&static_cast<const Client&> (f_client).reqCompte (1000),
+            &static_cast<const Client&> (copie).reqCompte (1000));
+  ASSERT_EQ(&static_cast<const Client&> (f_client).reqCompte (1280),
+            &static_cast<const Client&> (copie).reqCompte (1280));
+}
+
+
+/**
+ * \brief Test du partage copie à l'écriture par les mutations du portefeuille
+ *     Cas valides : ajouter, supprimer ou vider les comptes d'une copie, ou y
+ *                   assigner un autre client, laisse l'original intact.
+ *     Cas invalide : aucun
+ */
+TEST_F(ClientTest2, ajouterCompte_CopiePartagee_OriginalIntact)
+{
+  f_client.ajouterCompte (unCompte);
+  Client copie(f_client);
+  copie.ajouterCompte (unCheque);
+  copie.supprimerCompte (1000);
+  ASSERT_EQ(1u, copie.reqComptes ());
+  ASSERT_EQ(1u, f_client.reqComptes ());
+  ASSERT_NO_THROW(f_client.reqCompte (1000));
+
+  Client assigne = f_client;
+  assigne.viderComptes ();
+  assigne = copie;
+  ASSERT_EQ(1u, f_client.reqComptes ());
+  ASSERT_NO_THROW(static_cast<const Client&> (assigne).reqCompte (1280));
+}
@@ -0,0 +1,109 @@
+/**
+ * \file ComptabiliteAllocations.h
+ * \brief Remplacement facultatif des opérateurs globaux new et delete qui compte
+ *        les allocations du fil et les attribue à l'opération mesurée en cours.
+ *
+ * Ce fichier définit les opérateurs globaux : il doit être inclus dans une seule
+ * unité de traduction du programme, typiquement celle qui contient main() ou le
+ * banc d'essai. Les programmes qui ne l'incluent pas gardent les opérateurs de
+ * la bibliothèque standard et ne paient rien.
+ *
+ * Les comptes par opération ne sont tenus que si la mesure est active
+ * (metriques::asgActives) ; les totaux du fil (metriques::reqAllocationsFil)
+ * le sont toujours. Les variantes alignées (C++17) ne sont pas remplacées.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef COMPTABILITEALLOCATIONS_H
+#define COMPTABILITEALLOCATIONS_H
+
+#include "Metriques.h"
+#include <cstdlib>
+#include <new>
+
+void*
+operator new (std::size_t p_taille)
+{
+  void* p = std::malloc (p_taille == 0 ? 1 : p_taille);
+  if (p == nullptr)
+    {
+      throw std::bad_alloc ();
+    }
+  metriques::compterAllocation (p_taille);
+  return p;
+}
+
+
+void*
+operator new[] (std::size_t p_taille)
+{
+  return ::operator new (p_taille);
+}
+
+
+void*
+operator new (std::size_t p_taille, const std::nothrow_t&) noexcept
+{
+  void* p = std::malloc (p_taille == 0 ? 1 : p_taille);
+  if (p != nullptr)
+    {
+      metriques::compterAllocation (p_taille);
+    }
+  return p;
+}
+
+
+void*
+operator new[] (std::size_t p_taille, const std::nothrow_t& p_nothrow) noexcept
+{
+  return ::operator new (p_taille, p_nothrow);
+}
+
+
+void
+operator delete (void* p_ptr) noexcept
+{
+  if (p_ptr != nullptr)
+    {
+      metriques::compterLiberation ();
+      std::free (p_ptr);
+    }
+}
+
+
+void
+operator delete[] (void* p_ptr) noexcept
+{
+  ::operator delete (p_ptr);
+}
+
+
+void
+operator delete (void* p_ptr, std::size_t) noexcept
+{
+  ::operator delete (p_ptr);
+}
+
+
+void
+operator delete[] (void* p_ptr, std::size_t) noexcept
+{
+  ::operator delete (p_ptr);
+}
+
+
+void
+operator delete (void* p_ptr, const std::nothrow_t&) noexcept
+{
+  ::operator delete (p_ptr);
+}
+
+
+void
+operator delete[] (void* p_ptr, const std::nothrow_t&) noexcept
+{
+  ::operator delete (p_ptr);
+}
+
+#endif /* COMPTABILITEALLOCATIONS_H */
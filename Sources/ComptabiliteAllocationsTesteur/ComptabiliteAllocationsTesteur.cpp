@@ -0,0 +1,146 @@
+/**
+ * \file ComptabiliteAllocationsTesteur.cpp
+ * \brief Test unitaire de l'attribution des allocations aux opérations mesurées.
+ *
+ * À tester :
+ *         void* operator new(std::size_t p_taille);
+ *         void operator delete(void* p_ptr) noexcept;
+ *         Allocations reqAllocationsFil();
+ *         std::vector<Statistiques> capturer();
+ *         std::string exporterTexte();
+ *         std::string exporterJson();
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ComptabiliteAllocations.h"
+#include "Client.h"
+#include "Epargne.h"
+#include <memory>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+const metriques::Statistiques*
+trouver (const vector<metriques::Statistiques>& p_statistiques, metriques::Operation p_operation)
+{
+  for (const auto& stat : p_statistiques)
+    {
+      if (stat.operation == p_operation)
+        {
+          return &stat;
+        }
+    }
+  return nullptr;
+}
+} //namespace
+
+
+/**
+ * \brief Création d'une fixture qui part de compteurs vides et désactive la mesure à la fin
+ */
+class ComptabiliteAllocationsTest : public ::testing::Test
+{
+public:
+  ComptabiliteAllocationsTest():
+  f_client(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983)),
+  f_epargne(1, 1.5, 100.0, "Etudes")
+  {
+    metriques::reinitialiser ();
+  }
+
+  ~ComptabiliteAllocationsTest()
+  {
+    metriques::asgActives (false);
+  }
+
+  Client f_client;
+  Epargne f_epargne;
+};
+
+
+/**
+ * \brief Test de la méthode Allocations reqAllocationsFil();
+ *     Cas valide : les totaux du fil suivent new et delete, mesure active ou non.
+ *     Cas invalide : aucun
+ */
+TEST_F(ComptabiliteAllocationsTest, reqAllocationsFil_NewDelete_TotauxDuFil)
+{
+  const metriques::Allocations avant = metriques::reqAllocationsFil ();
+  unique_ptr<int[]> tableau(new int[100]);
+  tableau.reset ();
+  const metriques::Allocations apres = metriques::reqAllocationsFil ();
+
+  ASSERT_EQ(avant.allocations + 1, apres.allocations);
+  ASSERT_EQ(avant.octets + 100 * sizeof (int), apres.octets);
+  ASSERT_EQ(avant.liberations + 1, apres.liberations);
+  ASSERT_TRUE(metriques::reqComptabiliteAllocations ());
+}
+
+
+/**
+ * \brief Test de l'attribution des allocations par std::vector<Statistiques> capturer();
+ *     Cas valides : les allocations d'ajouterCompte lui sont attribuées, celles
+ *                   des opérations imbriquées vont à l'opération la plus interne,
+ *                   et calculerInteret n'alloue pas.
+ *     Cas invalide : aucune attribution quand la mesure est désactivée.
+ */
+TEST_F(ComptabiliteAllocationsTest, capturer_AjouterCompte_AllocationsAttribuees)
+{
+  metriques::asgActives (true);
+  f_client.ajouterCompte (f_epargne);
+  f_client.reqCompte (1).calculerInteret ();
+  metriques::asgActives (false);
+
+  auto statistiques = metriques::capturer ();
+  const metriques::Statistiques* ajout = trouver (statistiques, metriques::Operation::ClientAjouterCompte);
+  ASSERT_NE(nullptr, ajout);
+  ASSERT_GE(ajout->allocations, 1u);
+  ASSERT_GE(ajout->octets, sizeof (Epargne));
+  const metriques::Statistiques* interet = trouver (statistiques, metriques::Operation::CompteCalculerInteret);
+  ASSERT_NE(nullptr, interet);
+  ASSERT_EQ(0u, interet->allocations);
+}
+
+TEST_F(ComptabiliteAllocationsTest, capturer_OperationsImbriquees_AttribueesAuPlusInterne)
+{
+  f_client.ajouterCompte (f_epargne);
+  metriques::asgActives (true);
+  f_client.reqReleves ();
+  metriques::asgActives (false);
+
+  auto statistiques = metriques::capturer ();
+  const metriques::Statistiques* formate = trouver (statistiques, metriques::Operation::CompteReqCompteFormate);
+  ASSERT_NE(nullptr, formate);
+  ASSERT_GE(formate->allocations, 1u);
+  const metriques::Statistiques* releves = trouver (statistiques, metriques::Operation::ClientReqReleves);
+  ASSERT_NE(nullptr, releves);
+  ASSERT_GE(releves->allocations, 1u);
+}
+
+TEST_F(ComptabiliteAllocationsTest, capturer_MesureDesactivee_AucuneAttribution)
+{
+  f_client.ajouterCompte (f_epargne);
+  ASSERT_TRUE(metriques::capturer ().empty ());
+}
+
+
+/**
+ * \brief Test des méthodes std::string exporterTexte(); et std::string exporterJson();
+ *     Cas valide : les exports présentent les allocations par opération.
+ *     Cas invalide : aucun
+ */
+TEST_F(ComptabiliteAllocationsTest, exporter_AllocationsComptees_PresentesDansLesExports)
+{
+  metriques::asgActives (true);
+  f_client.ajouterCompte (f_epargne);
+  metriques::asgActives (false);
+
+  ASSERT_NE(string::npos, metriques::exporterTexte ().find ("Allocs/appel"));
+  string json = metriques::exporterJson ();
+  ASSERT_NE(string::npos, json.find ("\"allocations\":"));
+  ASSERT_NE(string::npos, json.find ("\"octets\":"));
+  ASSERT_NE(string::npos, json.find ("\"liberations\":"));
+}
@@ -5,8 +5,10 @@
  * \version 1.0
  */
 #include"Compte.h"
+#include"ArenaComptes.h"
 #include"ContratException.h"
 #include"Date.h"
+#include"Metriques.h"
 #include<memory>
 #include<sstream>
 
@@ -67,6 +69,28 @@ Compte::~Compte()
 }
 
 
+/**
+ * \brief Alloue la mémoire d'un compte (Cheque, Epargne, ...)
+ *        Dans une ArenaComptes::Portee, le compte est pris dans l'arène active.
+ * \param[in] p_taille la taille de l'objet à construire
+ * \return l'adresse de l'objet
+ */
+void* Compte::operator new(std::size_t p_taille)
+{
+  return ArenaComptes::allouer (p_taille);
+}
+
+
+/**
+ * \brief Libère la mémoire d'un compte
+ * \param[in] p_compte l'adresse de l'objet détruit
+ */
+void Compte::operator delete(void* p_compte) noexcept
+{
+  ArenaComptes::liberer (p_compte);
+}
+
+
 /**
  * \brief Retourne le numéro d'un compte du client
  * \return un entier qui représente le numéro du compte
@@ -125,6 +149,7 @@ const util::Date& Compte::reqDateOuverture() const
  */
 void Compte::asgTauxInteret(double p_tauxInteret)
 {
+  MESURER(CompteAsgTauxInteret);
   PRECONDITION(p_tauxInteret>=0 && p_tauxInteret<=100); 
   
   m_tauxInteret = p_tauxInteret;
@@ -142,6 +167,7 @@ void Compte::asgTauxInteret(double p_tauxInteret)
  */
 void Compte::asgSolde(double p_solde)
 {
+  MESURER(CompteAsgSolde);
   m_solde = p_solde;
   
   POSTCONDITION(m_solde==p_solde);
@@ -157,7 +183,8 @@ void Compte::asgSolde(double p_solde)
  */
 void Compte::asgDescription(const std::string& p_description)
 {
-  PRECONDITION(!(p_description.empty()))
+  MESURER(CompteAsgDescription);
+  PRECONDITION(!(p_description.empty()));
           
   m_description = p_description;
   
@@ -202,7 +229,7 @@ std::string Compte::reqCompteFormate() const
 void Compte::verifieInvariant() const
 {
   INVARIANT(m_noCompte>0);
-  INVARIANT(m_tauxInteret>=0 && m_tauxInteret<=100)
+  INVARIANT(m_tauxInteret>=0 && m_tauxInteret<=100);
   INVARIANT(!(m_description.empty()));
 }
 
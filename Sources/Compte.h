@@ -31,6 +31,9 @@ public:
   Compte(int p_noCompte, double p_tauxInteret, double p_solde, 
          const std::string& p_description, const util::Date& p_dateOuverture=util::Date()); 
   virtual ~Compte();
+
+  static void* operator new(std::size_t p_taille);
+  static void operator delete(void* p_compte) noexcept;
   
   //accesseurs
   int reqNoCompte() const;
@@ -15,6 +15,7 @@
  * CompteException:                Classe de base des exceptions de compte.
  * CompteDejaPresentException:     Classe de gestion des erreurs d'existence de Compte.
  * CompteAbsentException:          Classe de gestion des erreurs d'absence de Compte.
+ * ResultatCompte:                 Code d'erreur équivalent, pour les appels sans exception.
  * 
  * Attributs:
  *      std::string  m_raison:     La raison de l'echec a l'execution d'une requete.
@@ -66,5 +67,18 @@ public:
 };
 
 
+/**
+ * \enum ResultatCompte
+ * \brief Résultat d'une requête sur un compte, pour les variantes qui ne lèvent pas
+ *        d'exception. Chaque code d'erreur correspond à une exception ci-dessus.
+ */
+enum class ResultatCompte
+{
+  Succes,
+  CompteDejaPresent,   ///< équivaut à CompteDejaPresentException
+  CompteAbsent         ///< équivaut à CompteAbsentException
+};
+
+
 #endif /* COMPTEEXCEPTION_H */
 
@@ -230,4 +230,39 @@ TEST_F(Comptebase, reqCompteFormate_valide)
   os<<"Solde : "<<f_compte.reqSolde ()<<" $"<<endl;
   
   ASSERT_EQ (os.str(), f_compte.reqCompteFormate ());
-}
\ No newline at end of file
+}
+
+
+/**
+ * \brief Test des niveaux de vérification des contrats (contrat::asgNiveau)
+ *     Cas valides : au niveau Aucun, une valeur hors contrat n'est pas refusée ;
+ *                   au niveau Preconditions, les préconditions restent vérifiées ;
+ *                   au niveau InvariantsEchantillonnes, les vérifications restent actives.
+ *     Cas invalides : une fréquence d'échantillonnage nulle est refusée.
+ */
+TEST(CompteTest, niveauContrat_Aucun_PreconditionIgnoree)
+{
+  contrat::asgNiveau (contrat::Niveau::Aucun);
+  CompteDeTest unCompte(128500, 13, 250000, "Projet");
+  unCompte.asgTauxInteret (150);
+  contrat::asgNiveau (contrat::Niveau::Complet);
+  ASSERT_EQ(150, unCompte.reqTauxInteret ());
+  unCompte.asgTauxInteret (13);
+}
+
+TEST(CompteTest, niveauContrat_Preconditions_PreconditionException)
+{
+  contrat::asgNiveau (contrat::Niveau::Preconditions);
+  CompteDeTest unCompte(128500, 13, 250000, "Projet");
+  EXPECT_THROW(unCompte.asgTauxInteret (150), PreconditionException);
+  contrat::asgNiveau (contrat::Niveau::InvariantsEchantillonnes, 1);
+  EXPECT_THROW(unCompte.asgTauxInteret (-1), PreconditionException);
+  contrat::asgNiveau (contrat::Niveau::Complet);
+}
+
+TEST(CompteTest, niveauContrat_FrequenceNulle_Exception)
+{
+  ASSERT_THROW(contrat::asgNiveau (contrat::Niveau::InvariantsEchantillonnes, 0), invalid_argument);
+  ASSERT_EQ(contrat::Niveau::Complet, contrat::reqNiveau ());
+}
+
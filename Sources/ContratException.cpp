@@ -5,6 +5,7 @@
  * \version v3.0 révisée balises Doxygen C++ normes
  */
 #include "ContratException.h"
+#include "JournalContrat.h"
 #include <sstream>
 #include <iostream>
 
@@ -40,6 +41,25 @@ std::string ContratException::reqTexteException () const
 }
 
 
+/**
+ * \brief Signale la violation selon le mode choisi par contrat::asgSignalement :
+ *        affichage immédiat sur la console, ou copie dans l'anneau des violations
+ *        sans construction de texte ni entrée-sortie.
+ * \param p_message le type d'erreur de contrat
+ */
+void ContratException::signaler (const char* p_message) const
+{
+  if (contrat::reqSignalement () == contrat::Signalement::Anneau)
+    {
+      contrat::consignerViolation (p_message, m_fichier, m_ligne, m_expression);
+    }
+  else
+    {
+      cout << reqTexteException ()<<endl;
+    }
+}
+
+
 /**
  * \brief Constructeur de la classe AssertionException \n
  *    	Le constructeur public AssertionException(...)initialise
@@ -55,7 +75,7 @@ AssertionException::AssertionException (const std::string& p_fichier, unsigned i
                                         const std::string& p_expression)
 : ContratException (p_fichier, p_ligne, p_expression, "ERREUR D'ASSERTION") 
 {
-  cout << reqTexteException ()<<endl;
+  signaler ("ERREUR D'ASSERTION");
 }
 
 
@@ -70,7 +90,7 @@ PreconditionException::PreconditionException (const std::string& p_fichier, unsi
                                               const std::string& p_expression)
 : ContratException (p_fichier, p_ligne, p_expression, "ERREUR DE PRECONDITION") 
 {
-  cout << reqTexteException ()<<endl;
+  signaler ("ERREUR DE PRECONDITION");
 }
 
 
@@ -85,7 +105,7 @@ PostconditionException::PostconditionException (const std::string& p_fichier, un
                                                 const std::string& p_expression)
 : ContratException (p_fichier, p_ligne, p_expression, "ERREUR DE POSTCONDITION") 
 {
-  cout << reqTexteException ()<<endl;
+  signaler ("ERREUR DE POSTCONDITION");
 }
 
 
@@ -100,5 +120,49 @@ InvariantException::InvariantException (const std::string& p_fichier, unsigned i
                                         const std::string& p_expression)
 : ContratException (p_fichier, p_ligne, p_expression, "ERREUR D'INVARIANT") 
 {
-  cout << reqTexteException ()<<endl;
+  signaler ("ERREUR D'INVARIANT");
+}
+
+
+namespace contrat
+{
+/**
+ * \brief Choisit le niveau de vérification des contrats pour tout le processus
+ * \param[in] p_niveau le niveau de vérification à appliquer
+ * \param[in] p_frequenceEchantillon pour InvariantsEchantillonnes, un appel
+ *            d'INVARIANTS sur p_frequenceEchantillon est vérifié dans chaque fil
+ * \exception std::invalid_argument si p_frequenceEchantillon est nul
+ */
+void
+asgNiveau (Niveau p_niveau, unsigned p_frequenceEchantillon)
+{
+  if (p_frequenceEchantillon == 0)
+    {
+      throw std::invalid_argument ("La frequence d'echantillonnage doit etre positive");
+    }
+  Reglage::frequenceEchantillon.store (p_frequenceEchantillon, std::memory_order_relaxed);
+  Reglage::niveau.store (p_niveau, std::memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne le niveau de vérification des contrats en vigueur
+ * \return le niveau courant
+ */
+Niveau
+reqNiveau ()
+{
+  return Reglage::niveau.load (std::memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne la fréquence d'échantillonnage des invariants
+ * \return un invariant vérifié sur cette valeur au niveau InvariantsEchantillonnes
+ */
+unsigned
+reqFrequenceEchantillon ()
+{
+  return Reglage::frequenceEchantillon.load (std::memory_order_relaxed);
 }
+} // namespace contrat
@@ -9,6 +9,16 @@
  *
  * En release, définir la constante NDEBUG pour désactiver les Macros
  *
+ * Hors NDEBUG, ou si CONTRAT_NIVEAU_EXECUTION est défini, le niveau de
+ * vérification se choisit à l'exécution avec contrat::asgNiveau :
+ * Aucun, Preconditions (préconditions seulement), InvariantsEchantillonnes
+ * (préconditions et un appel d'INVARIANTS sur N) ou Complet (par défaut).
+ * Ainsi, une version de production compilée avec NDEBUG et
+ * CONTRAT_NIVEAU_EXECUTION garde une protection partielle à faible coût.
+ *
+ * Les violations sont affichées sur la console à leur construction, ou
+ * consignées dans un anneau en mémoire (voir JournalContrat.h).
+ *
  * <pre>
  * Classes:
  * std::logic_error        Classe de base des exceptions logiques
@@ -35,6 +45,7 @@
 #ifndef CONTRATEXCEPTION_H_DEJA_INCLU
 #define CONTRATEXCEPTION_H_DEJA_INCLU
 
+#include <atomic>
 #include <string>
 #include <stdexcept>
 
@@ -52,6 +63,9 @@ public:
   ;
   std::string reqTexteException () const;
 
+protected:
+  void signaler (const char* p_message) const;
+
 private:
   std::string m_expression;
   std::string m_fichier;
@@ -105,32 +119,111 @@ public:
 };
 
 
+namespace contrat
+{
+/**
+ * \enum Niveau
+ * \brief Niveaux de vérification des contrats, du moins coûteux au plus complet.
+ */
+enum class Niveau : unsigned char
+{
+  Aucun,
+  Preconditions,
+  InvariantsEchantillonnes,
+  Complet
+};
+
+/**
+ * \brief Réglage global du niveau de vérification, lu à chaque macro.
+ */
+struct Reglage
+{
+  static inline std::atomic<Niveau> niveau {Niveau::Complet};
+  static inline std::atomic<unsigned> frequenceEchantillon {64};
+  static inline thread_local unsigned invariantsSuspendus {0};
+};
+
+/**
+ * \class SuspensionInvariants
+ * \brief Suspend INVARIANTS dans le fil courant pendant la durée de vie de l'objet.
+ *
+ * Sert aux destructions en bloc d'objets dont les invariants ont déjà été
+ * vérifiés à chaque mutation (par exemple les comptes d'un portefeuille).
+ */
+class SuspensionInvariants
+{
+public:
+  SuspensionInvariants () { ++Reglage::invariantsSuspendus; }
+  ~SuspensionInvariants () { --Reglage::invariantsSuspendus; }
+  SuspensionInvariants (const SuspensionInvariants&) = delete;
+  SuspensionInvariants& operator= (const SuspensionInvariants&) = delete;
+};
+
+void asgNiveau(Niveau p_niveau, unsigned p_frequenceEchantillon=64);
+Niveau reqNiveau();
+unsigned reqFrequenceEchantillon();
+
+
+inline bool
+preconditionsActives ()
+{
+  return Reglage::niveau.load (std::memory_order_relaxed) >= Niveau::Preconditions;
+}
+
+
+inline bool
+postconditionsActives ()
+{
+  return Reglage::niveau.load (std::memory_order_relaxed) == Niveau::Complet;
+}
+
+
+inline bool
+invariantsActifs ()
+{
+  if (Reglage::invariantsSuspendus != 0)
+    {
+      return false;
+    }
+  Niveau niveau = Reglage::niveau.load (std::memory_order_relaxed);
+  if (niveau == Niveau::InvariantsEchantillonnes)
+    {
+      thread_local unsigned compteur = 0;
+      return ++compteur % Reglage::frequenceEchantillon.load (std::memory_order_relaxed) == 0;
+    }
+  return niveau == Niveau::Complet;
+}
+} // namespace contrat
+
+
 // --- Définition des macros de contrôle de la théorie du contrat
+// Chaque macro forme une seule instruction, qui attend son point-virgule :
+// elle peut suivre un if ou un else sans accolades.
 
-#if !defined(NDEBUG)
-// --- Mode debug
+#if !defined(NDEBUG) || defined(CONTRAT_NIVEAU_EXECUTION)
+// --- Mode debug, ou niveau choisi à l'exécution
 
 #define INVARIANTS() \
-      verifieInvariant()
+      do { if (contrat::invariantsActifs ()) verifieInvariant (); } while (0)
 
 #define ASSERTION(f)     \
-      if (!(f)) throw AssertionException(__FILE__,__LINE__, #f);
+      do { if (contrat::postconditionsActives () && !(f)) throw AssertionException(__FILE__,__LINE__, #f); } while (0)
 #define PRECONDITION(f)  \
-      if (!(f)) throw PreconditionException(__FILE__, __LINE__, #f);
+      do { if (contrat::preconditionsActives () && !(f)) throw PreconditionException(__FILE__, __LINE__, #f); } while (0)
 #define POSTCONDITION(f) \
-      if (!(f)) throw PostconditionException(__FILE__, __LINE__, #f);
+      do { if (contrat::postconditionsActives () && !(f)) throw PostconditionException(__FILE__, __LINE__, #f); } while (0)
 #define INVARIANT(f)   \
-      if (!(f)) throw InvariantException(__FILE__,__LINE__, #f);
+      do { if (!(f)) throw InvariantException(__FILE__,__LINE__, #f); } while (0)
 
 // --- LE MODE RELEASE
 #else
 
-#define PRECONDITION(f);
-#define POSTCONDITION(f);
-#define INVARIANTS();
-#define INVARIANT(f);
-#define ASSERTION(f);
+#define PRECONDITION(f) do { } while (0)
+#define POSTCONDITION(f) do { } while (0)
+#define INVARIANTS() do { } while (0)
+#define INVARIANT(f) do { } while (0)
+#define ASSERTION(f) do { } while (0)
 
-#endif  // --- if !defined (NDEBUG)
+#endif  // --- if !defined (NDEBUG) || defined (CONTRAT_NIVEAU_EXECUTION)
 #endif  // --- ifndef CONTRATEXCEPTION_H_DEJA_INCLU
 
@@ -0,0 +1,611 @@
+/**
+ * \file EcrivainAsynchrone.cpp
+ * \brief Implantation de la classe EcrivainAsynchrone
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "EcrivainAsynchrone.h"
+#include "ContratException.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define BANCAIRE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+using namespace std;
+
+namespace bancaire
+{
+#if defined(BANCAIRE_IO_URING)
+/**
+ * \class EcrivainAsynchrone::AnneauIoUring
+ * \brief Accès minimal à io_uring par appels système directs (sans liburing).
+ *
+ * N'est utilisé que par le fil d'écriture, aucune synchronisation n'est requise
+ * autre que les barrières imposées par le partage des anneaux avec le noyau.
+ * Après l'échec d'un appel système, l'anneau est défaillant et doit être
+ * abandonné ; soumettreEtAttendre ne rend toutefois la main qu'une fois
+ * retirées les entrées que le noyau n'a pas prises et reçues les complétions
+ * de toutes celles qu'il a prises : aucun tampon n'est alors encore lu.
+ */
+class EcrivainAsynchrone::AnneauIoUring
+{
+public:
+  /**
+   * \brief Résultat d'une entrée que le noyau n'a jamais prise
+   */
+  static constexpr int NON_SOUMISE = INT_MIN;
+
+  static unique_ptr<AnneauIoUring>
+  creer (unsigned p_entrees)
+  {
+    io_uring_params parametres {};
+    int descripteur = static_cast<int> (::syscall (__NR_io_uring_setup, p_entrees, &parametres));
+    if (descripteur < 0)
+      {
+        return nullptr; // noyau trop ancien ou io_uring interdit : repli sur pwrite
+      }
+    unique_ptr<AnneauIoUring> anneau(new AnneauIoUring(descripteur, parametres));
+    if (!anneau->projeter ())
+      {
+        return nullptr;
+      }
+    return anneau;
+  }
+
+  ~AnneauIoUring ()
+  {
+    if (m_sqes != MAP_FAILED)
+      {
+        ::munmap (m_sqes, m_tailleSqes);
+      }
+    if (m_cq != MAP_FAILED && m_cq != m_sq)
+      {
+        ::munmap (m_cq, m_tailleCq);
+      }
+    if (m_sq != MAP_FAILED)
+      {
+        ::munmap (m_sq, m_tailleSq);
+      }
+    ::close (m_descripteur);
+  }
+
+  void
+  preparer (uint8_t p_code, int p_descripteur, const char* p_donnees, size_t p_taille,
+            uint64_t p_position, uint64_t p_identifiant)
+  {
+    unsigned queue = *m_sqQueue;
+    unsigned indice = queue & *m_sqMasque;
+    io_uring_sqe& sqe = m_sqes[indice];
+    sqe = io_uring_sqe {};
+    sqe.opcode = p_code;
+    sqe.fd = p_descripteur;
+    sqe.addr = reinterpret_cast<uint64_t> (p_donnees);
+    sqe.len = static_cast<uint32_t> (p_taille);
+    sqe.off = p_position;
+    if (p_code == IORING_OP_FSYNC)
+      {
+        sqe.fsync_flags = IORING_FSYNC_DATASYNC;
+      }
+    sqe.user_data = p_identifiant;
+    m_sqTableau[indice] = indice;
+    __atomic_store_n (m_sqQueue, queue + 1, __ATOMIC_RELEASE);
+    ++m_aSoumettre;
+  }
+
+  bool
+  estDefaillant () const
+  {
+    return m_defaillant;
+  }
+
+  /**
+   * \brief Soumet les entrées préparées et attend leurs complétions
+   *        Si la soumission échoue en cours de route, les entrées que le noyau
+   *        n'a pas prises sont retirées de l'anneau et gardent NON_SOUMISE. Si
+   *        l'attente elle-même échoue, les complétions restantes sont guettées
+   *        dans l'anneau sans appel io_uring_enter : une entrée soumise écrit
+   *        peut-être encore son tampon, elle ne doit être ni rejouée ni libérée.
+   * \param[out] p_resultats résultat de chaque entrée, indexé par identifiant ;
+   *             les entrées non soumises reçoivent NON_SOUMISE
+   * \return 0 ou le code errno du premier io_uring_enter en échec
+   */
+  int
+  soumettreEtAttendre (vector<int>& p_resultats)
+  {
+    int erreur = 0;
+    unsigned soumises = 0;
+    while (soumises < m_aSoumettre)
+      {
+        int n = static_cast<int> (::syscall (__NR_io_uring_enter, m_descripteur,
+                                             m_aSoumettre - soumises, 0, 0, nullptr, 0));
+        if (n < 0)
+          {
+            if (errno == EINTR || errno == EAGAIN)
+              {
+                continue;
+              }
+            erreur = errno;
+            m_defaillant = true;
+            break;
+          }
+        soumises += static_cast<unsigned> (n);
+      }
+    if (soumises < m_aSoumettre)
+      {
+        // le noyau ne lit l'anneau de soumission que dans io_uring_enter : ramener
+        // la queue sur sa tête retire les entrées qu'il n'a pas prises
+        for (unsigned tete = __atomic_load_n (m_sqTete, __ATOMIC_ACQUIRE); tete != *m_sqQueue; ++tete)
+          {
+            p_resultats[m_sqes[tete & *m_sqMasque].user_data] = NON_SOUMISE;
+          }
+        __atomic_store_n (m_sqQueue, __atomic_load_n (m_sqTete, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+      }
+    m_aSoumettre = 0;
+
+    const unsigned attendues = soumises;
+    unsigned recues = 0;
+    while (recues < attendues)
+      {
+        unsigned tete = *m_cqTete;
+        unsigned queue = __atomic_load_n (m_cqQueue, __ATOMIC_ACQUIRE);
+        if (tete == queue)
+          {
+            if (m_defaillant)
+              {
+                // plus d'attente dans le noyau : les complétions arrivent quand même
+                this_thread::sleep_for (chrono::milliseconds(1));
+                continue;
+              }
+            int n = static_cast<int> (::syscall (__NR_io_uring_enter, m_descripteur, 0, 1,
+                                                 IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (n < 0 && errno != EINTR && errno != EAGAIN)
+              {
+                erreur = erreur != 0 ? erreur : errno;
+                m_defaillant = true;
+              }
+            continue;
+          }
+        for (; tete != queue; ++tete, ++recues)
+          {
+            const io_uring_cqe& cqe = m_cqes[tete & *m_cqMasque];
+            p_resultats[cqe.user_data] = cqe.res;
+          }
+        __atomic_store_n (m_cqTete, tete, __ATOMIC_RELEASE);
+      }
+    return erreur;
+  }
+
+private:
+  AnneauIoUring (int p_descripteur, const io_uring_params& p_parametres) :
+  m_descripteur (p_descripteur), m_parametres (p_parametres) { }
+
+  bool
+  projeter ()
+  {
+    m_tailleSq = m_parametres.sq_off.array + m_parametres.sq_entries * sizeof (unsigned);
+    m_tailleCq = m_parametres.cq_off.cqes + m_parametres.cq_entries * sizeof (io_uring_cqe);
+    const bool projectionUnique = m_parametres.features & IORING_FEAT_SINGLE_MMAP;
+    if (projectionUnique)
+      {
+        m_tailleSq = m_tailleCq = max (m_tailleSq, m_tailleCq);
+      }
+    m_sq = ::mmap (nullptr, m_tailleSq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   m_descripteur, IORING_OFF_SQ_RING);
+    if (m_sq == MAP_FAILED)
+      {
+        return false;
+      }
+    m_cq = projectionUnique ? m_sq
+            : ::mmap (nullptr, m_tailleCq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      m_descripteur, IORING_OFF_CQ_RING);
+    if (m_cq == MAP_FAILED)
+      {
+        return false;
+      }
+    m_tailleSqes = m_parametres.sq_entries * sizeof (io_uring_sqe);
+    void* sqes = ::mmap (nullptr, m_tailleSqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         m_descripteur, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+      {
+        return false;
+      }
+    m_sqes = static_cast<io_uring_sqe*> (sqes);
+
+    char* sq = static_cast<char*> (m_sq);
+    char* cq = static_cast<char*> (m_cq);
+    m_sqTete = reinterpret_cast<unsigned*> (sq + m_parametres.sq_off.head);
+    m_sqQueue = reinterpret_cast<unsigned*> (sq + m_parametres.sq_off.tail);
+    m_sqMasque = reinterpret_cast<unsigned*> (sq + m_parametres.sq_off.ring_mask);
+    m_sqTableau = reinterpret_cast<unsigned*> (sq + m_parametres.sq_off.array);
+    m_cqTete = reinterpret_cast<unsigned*> (cq + m_parametres.cq_off.head);
+    m_cqQueue = reinterpret_cast<unsigned*> (cq + m_parametres.cq_off.tail);
+    m_cqMasque = reinterpret_cast<unsigned*> (cq + m_parametres.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*> (cq + m_parametres.cq_off.cqes);
+    return true;
+  }
+
+  int m_descripteur;
+  io_uring_params m_parametres;
+  void* m_sq = MAP_FAILED;
+  void* m_cq = MAP_FAILED;
+  io_uring_sqe* m_sqes = static_cast<io_uring_sqe*> (MAP_FAILED);
+  size_t m_tailleSq = 0;
+  size_t m_tailleCq = 0;
+  size_t m_tailleSqes = 0;
+  unsigned* m_sqTete = nullptr;
+  unsigned* m_sqQueue = nullptr;
+  unsigned* m_sqMasque = nullptr;
+  unsigned* m_sqTableau = nullptr;
+  unsigned* m_cqTete = nullptr;
+  unsigned* m_cqQueue = nullptr;
+  unsigned* m_cqMasque = nullptr;
+  io_uring_cqe* m_cqes = nullptr;
+  unsigned m_aSoumettre = 0;
+  bool m_defaillant = false;
+};
+#else
+/**
+ * \brief Sans en-tête io_uring, l'écrivain utilise toujours pwrite/fdatasync.
+ */
+class EcrivainAsynchrone::AnneauIoUring
+{
+public:
+  bool
+  estDefaillant () const
+  {
+    return false;
+  }
+};
+#endif
+
+
+/**
+ * \brief Constructeur de la classe EcrivainAsynchrone
+ *        Démarre le fil d'écriture. io_uring est utilisé s'il est permis et
+ *        disponible, sinon les requêtes sont exécutées par pwrite/fdatasync.
+ * \param[in] p_profondeur nombre maximal de requêtes soumises ensemble au noyau
+ * \param[in] p_permettreIoUring faux pour forcer le repli sur pwrite
+ * \pre p_profondeur doit être supérieur à zéro
+ */
+EcrivainAsynchrone::EcrivainAsynchrone(unsigned p_profondeur, bool p_permettreIoUring):
+        m_profondeur(p_profondeur), m_utiliseIoUring(false), m_enCours(0), m_arret(false)
+{
+  PRECONDITION(p_profondeur>0);
+
+#if defined(BANCAIRE_IO_URING)
+  if (p_permettreIoUring)
+    {
+      m_anneau = AnneauIoUring::creer (p_profondeur);
+      m_utiliseIoUring = m_anneau != nullptr;
+    }
+#else
+  (void) p_permettreIoUring;
+#endif
+  m_ecrivain = thread(&EcrivainAsynchrone::boucleEcriture, this);
+}
+
+
+/**
+ * \brief Destructeur de la classe EcrivainAsynchrone
+ *        Toutes les requêtes déjà soumises sont exécutées avant l'arrêt.
+ */
+EcrivainAsynchrone::~EcrivainAsynchrone()
+{
+  {
+    lock_guard<mutex> verrou(m_mutex);
+    m_arret = true;
+  }
+  m_conditionTravail.notify_one ();
+  m_ecrivain.join ();
+}
+
+
+/**
+ * \brief Indique si les requêtes passent par io_uring
+ *        L'écrivain se replie sur pwrite si l'anneau devient défaillant.
+ * \return vrai si io_uring est utilisé, faux si l'écrivain utilise pwrite
+ */
+bool EcrivainAsynchrone::reqUtiliseIoUring() const
+{
+  return m_utiliseIoUring.load ();
+}
+
+
+/**
+ * \brief Retourne le nombre maximal de requêtes soumises ensemble
+ * \return un entier qui représente la profondeur de la file de soumission
+ */
+unsigned EcrivainAsynchrone::reqProfondeur() const
+{
+  return m_profondeur;
+}
+
+
+/**
+ * \brief Confie l'écriture d'un tampon à une position donnée d'un fichier
+ *        L'appelant ne bloque pas ; le tampon appartient à l'écrivain jusqu'à la fin.
+ * \param[in] p_descripteur descripteur du fichier, ouvert sans O_APPEND
+ * \param[in] p_position position d'écriture dans le fichier
+ * \param[in] p_tampon données à écrire
+ * \param[in] p_rappel appelé par le fil d'écriture une fois l'écriture terminée
+ * \pre p_descripteur doit être un descripteur valide
+ */
+void EcrivainAsynchrone::ecrire(int p_descripteur, std::uint64_t p_position, std::string p_tampon,
+                                Rappel p_rappel)
+{
+  PRECONDITION(p_descripteur>=0);
+  soumettreRequete (Requete {false, p_descripteur, p_position, move (p_tampon), move (p_rappel)});
+}
+
+
+/**
+ * \brief Confie la synchronisation (fdatasync) d'un fichier
+ *        La synchronisation suit toutes les écritures soumises avant elle.
+ * \param[in] p_descripteur descripteur du fichier
+ * \param[in] p_rappel appelé par le fil d'écriture une fois les données durables
+ * \pre p_descripteur doit être un descripteur valide
+ */
+void EcrivainAsynchrone::synchroniser(int p_descripteur, Rappel p_rappel)
+{
+  PRECONDITION(p_descripteur>=0);
+  soumettreRequete (Requete {true, p_descripteur, 0, string(), move (p_rappel)});
+}
+
+
+/**
+ * \brief Attend que toutes les requêtes soumises jusqu'ici soient terminées
+ */
+void EcrivainAsynchrone::attendre()
+{
+  unique_lock<mutex> verrou(m_mutex);
+  m_conditionTermine.wait (verrou, [this] { return m_requetes.empty () && m_enCours == 0; });
+}
+
+
+/**
+ * \brief Ajoute une requête à la file et réveille le fil d'écriture
+ * \param[in] p_requete la requête à exécuter
+ */
+void EcrivainAsynchrone::soumettreRequete(Requete&& p_requete)
+{
+  {
+    lock_guard<mutex> verrou(m_mutex);
+    m_requetes.push_back (move (p_requete));
+  }
+  m_conditionTravail.notify_one ();
+}
+
+
+/**
+ * \brief Boucle du fil d'écriture
+ *        Un lot regroupe les écritures consécutives jusqu'à la première
+ *        synchronisation incluse, dans la limite de la profondeur.
+ */
+void EcrivainAsynchrone::boucleEcriture()
+{
+  deque<Requete> lot;
+  unique_lock<mutex> verrou(m_mutex);
+  for (;;)
+    {
+      m_conditionTravail.wait (verrou, [this] { return m_arret || !m_requetes.empty (); });
+      if (m_requetes.empty ())
+        {
+          return;
+        }
+      while (!m_requetes.empty () && lot.size () < m_profondeur)
+        {
+          bool synchronisation = m_requetes.front ().synchronisation;
+          lot.push_back (move (m_requetes.front ()));
+          m_requetes.pop_front ();
+          if (synchronisation)
+            {
+              break;
+            }
+        }
+      m_enCours = lot.size ();
+      verrou.unlock ();
+
+      if (m_anneau)
+        {
+          executerParAnneau (lot);
+          if (m_anneau->estDefaillant ())
+            {
+              m_anneau.reset ();
+              m_utiliseIoUring = false;
+            }
+        }
+      else
+        {
+          executerParAppels (lot);
+        }
+      lot.clear ();
+
+      verrou.lock ();
+      m_enCours = 0;
+      if (m_requetes.empty ())
+        {
+          m_conditionTermine.notify_all ();
+        }
+    }
+}
+
+
+/**
+ * \brief Exécute un lot par io_uring : les écritures en parallèle, puis la
+ *        synchronisation finale éventuelle une fois les écritures complètes.
+ *        Seules les requêtes que le noyau n'a pas prises, ou qu'il a refusées
+ *        sans rien écrire, sont reprises par appels directs.
+ * \param[in,out] p_lot les requêtes du lot, dans l'ordre de soumission
+ */
+void EcrivainAsynchrone::executerParAnneau(std::deque<Requete>& p_lot)
+{
+#if defined(BANCAIRE_IO_URING)
+  vector<int> resultats(p_lot.size (), 0);
+  const size_t nombreEcritures = p_lot.back ().synchronisation ? p_lot.size () - 1 : p_lot.size ();
+
+  for (size_t i = 0; i < nombreEcritures; ++i)
+    {
+      const Requete& requete = p_lot[i];
+      m_anneau->preparer (IORING_OP_WRITE, requete.descripteur, requete.tampon.data (),
+                          requete.tampon.size (), requete.position, i);
+    }
+  if (nombreEcritures > 0)
+    {
+      m_anneau->soumettreEtAttendre (resultats);
+    }
+
+  for (size_t i = 0; i < nombreEcritures; ++i)
+    {
+      Requete& requete = p_lot[i];
+      if (resultats[i] == AnneauIoUring::NON_SOUMISE || resultats[i] == -EINVAL
+          || resultats[i] == -EOPNOTSUPP)
+        {
+          resultats[i] = executerDirectement (requete);
+        }
+      else if (resultats[i] < 0)
+        {
+          resultats[i] = -resultats[i];
+        }
+      else if (static_cast<size_t> (resultats[i]) < requete.tampon.size ())
+        {
+          // écriture partielle : on complète directement le reste du tampon
+          requete.tampon.erase (0, static_cast<size_t> (resultats[i]));
+          requete.position += static_cast<uint64_t> (resultats[i]);
+          resultats[i] = executerDirectement (requete);
+        }
+      else
+        {
+          resultats[i] = 0;
+        }
+    }
+
+  if (nombreEcritures < p_lot.size ())
+    {
+      Requete& synchronisation = p_lot.back ();
+      size_t indice = p_lot.size () - 1;
+      if (m_anneau->estDefaillant ())
+        {
+          resultats[indice] = executerDirectement (synchronisation);
+        }
+      else
+        {
+          m_anneau->preparer (IORING_OP_FSYNC, synchronisation.descripteur, nullptr, 0, 0, indice);
+          m_anneau->soumettreEtAttendre (resultats);
+          if (resultats[indice] == AnneauIoUring::NON_SOUMISE)
+            {
+              resultats[indice] = executerDirectement (synchronisation);
+            }
+          else
+            {
+              resultats[indice] = -resultats[indice];
+            }
+        }
+    }
+
+  for (size_t i = 0; i < p_lot.size (); ++i)
+    {
+      const int resultat = terminer (p_lot[i], resultats[i]);
+      if (p_lot[i].rappel)
+        {
+          p_lot[i].rappel (resultat);
+        }
+    }
+#else
+  (void) p_lot;
+#endif
+}
+
+
+/**
+ * \brief Exécute un lot par appels système bloquants, dans l'ordre de soumission
+ * \param[in,out] p_lot les requêtes du lot
+ */
+void EcrivainAsynchrone::executerParAppels(std::deque<Requete>& p_lot)
+{
+  for (const Requete& requete : p_lot)
+    {
+      const int resultat = terminer (requete, executerDirectement (requete));
+      if (requete.rappel)
+        {
+          requete.rappel (resultat);
+        }
+    }
+}
+
+
+/**
+ * \brief Établit le résultat rapporté d'une requête exécutée
+ *        La première écriture en échec sur un descripteur est retenue jusqu'à
+ *        sa prochaine synchronisation, qui la rapporte si elle-même réussit :
+ *        une synchronisation ne rend durable que des écritures réussies, même
+ *        si elles appartenaient à un lot précédent.
+ * \param[in] p_requete la requête exécutée
+ * \param[in] p_resultat 0 ou le code errno de son exécution
+ * \return le code à passer au rappel de la requête
+ */
+int EcrivainAsynchrone::terminer(const Requete& p_requete, int p_resultat)
+{
+  if (!p_requete.synchronisation)
+    {
+      if (p_resultat != 0)
+        {
+          m_erreursEcriture.emplace (p_requete.descripteur, p_resultat);
+        }
+      return p_resultat;
+    }
+  auto erreur = m_erreursEcriture.find (p_requete.descripteur);
+  if (erreur != m_erreursEcriture.end ())
+    {
+      if (p_resultat == 0)
+        {
+          p_resultat = erreur->second;
+        }
+      m_erreursEcriture.erase (erreur);
+    }
+  return p_resultat;
+}
+
+
+/**
+ * \brief Exécute une requête par appels système bloquants (pwrite ou fdatasync)
+ * \param[in] p_requete la requête à exécuter
+ * \return 0 en cas de succès, sinon le code errno de l'échec
+ */
+int EcrivainAsynchrone::executerDirectement(const Requete& p_requete)
+{
+  if (p_requete.synchronisation)
+    {
+      return ::fdatasync (p_requete.descripteur) == 0 ? 0 : errno;
+    }
+  const char* courant = p_requete.tampon.data ();
+  size_t restant = p_requete.tampon.size ();
+  off_t position = static_cast<off_t> (p_requete.position);
+  while (restant > 0)
+    {
+      ssize_t ecrit = ::pwrite (p_requete.descripteur, courant, restant, position);
+      if (ecrit < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          return errno;
+        }
+      courant += ecrit;
+      position += ecrit;
+      restant -= static_cast<size_t> (ecrit);
+    }
+  return 0;
+}
+
+} //namespace bancaire
@@ -0,0 +1,92 @@
+/**
+ * \file EcrivainAsynchrone.h
+ * \brief Fichier qui contient l'interface de la classe EcrivainAsynchrone.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef ECRIVAINASYNCHRONE_H
+#define ECRIVAINASYNCHRONE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace bancaire
+{
+/**
+ * \class EcrivainAsynchrone
+ * \brief Effectue les écritures de persistance hors du fil de l'appelant.
+ *
+ * Les appelants confient un tampon (segment de journal, page d'instantané) et
+ * poursuivent immédiatement ; un fil dédié soumet les écritures par io_uring
+ * lorsque le noyau le permet, ou par pwrite/fdatasync autrement. Les écritures
+ * soumises entre deux synchronisations peuvent s'exécuter dans n'importe quel
+ * ordre et ne doivent donc pas se chevaucher ; une synchronisation n'est
+ * lancée qu'une fois terminées toutes les écritures qui la précèdent, et les
+ * rappels sont appelés dans l'ordre de soumission.
+ * Le rappel reçoit 0 en cas de succès ou le code errno de l'échec. Une
+ * synchronisation ne réussit que si toutes les écritures sur le même
+ * descripteur depuis la synchronisation précédente ont réussi : elle reçoit
+ * sinon le code de la première écriture en échec.
+ */
+class EcrivainAsynchrone
+{
+public:
+  using Rappel = std::function<void(int)>;
+
+  explicit EcrivainAsynchrone(unsigned p_profondeur=64, bool p_permettreIoUring=true);
+  ~EcrivainAsynchrone();
+  EcrivainAsynchrone(const EcrivainAsynchrone&)=delete;
+  EcrivainAsynchrone& operator=(const EcrivainAsynchrone&)=delete;
+
+  //accesseurs
+  bool reqUtiliseIoUring() const;
+  unsigned reqProfondeur() const;
+
+  //methodes
+  void ecrire(int p_descripteur, std::uint64_t p_position, std::string p_tampon,
+              Rappel p_rappel=Rappel());
+  void synchroniser(int p_descripteur, Rappel p_rappel=Rappel());
+  void attendre();
+
+private:
+  struct Requete
+  {
+    bool synchronisation;
+    int descripteur;
+    std::uint64_t position;
+    std::string tampon;
+    Rappel rappel;
+  };
+  class AnneauIoUring;
+
+  void soumettreRequete(Requete&& p_requete);
+  void boucleEcriture();
+  void executerParAnneau(std::deque<Requete>& p_lot);
+  void executerParAppels(std::deque<Requete>& p_lot);
+  static int executerDirectement(const Requete& p_requete);
+  int terminer(const Requete& p_requete, int p_resultat);
+
+  const unsigned m_profondeur;
+  std::unique_ptr<AnneauIoUring> m_anneau;
+  std::atomic<bool> m_utiliseIoUring;
+  std::unordered_map<int, int> m_erreursEcriture;
+
+  std::mutex m_mutex;
+  std::condition_variable m_conditionTravail;
+  std::condition_variable m_conditionTermine;
+  std::deque<Requete> m_requetes;
+  std::size_t m_enCours;
+  bool m_arret;
+  std::thread m_ecrivain;
+};
+} //namespace bancaire
+
+#endif /* ECRIVAINASYNCHRONE_H */
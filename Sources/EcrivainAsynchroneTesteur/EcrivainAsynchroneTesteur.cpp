@@ -0,0 +1,143 @@
+/**
+ * \file EcrivainAsynchroneTesteur.cpp
+ * \brief Test unitaire de la classe EcrivainAsynchrone.
+ *
+ * À tester :
+ *         EcrivainAsynchrone(unsigned p_profondeur, bool p_permettreIoUring);
+ *         void ecrire(int p_descripteur, std::uint64_t p_position, std::string p_tampon,
+ *                     Rappel p_rappel);
+ *         void synchroniser(int p_descripteur, Rappel p_rappel);
+ *         void attendre();
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "EcrivainAsynchrone.h"
+#include "ContratException.h"
+#include <atomic>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Fixture qui ouvre un fichier temporaire pour les écritures
+ */
+class EcrivainAsynchroneTest : public ::testing::TestWithParam<bool>
+{
+public:
+  EcrivainAsynchroneTest():
+  chemin("/tmp/EcrivainAsynchroneTesteur_" + to_string (::getpid ()) + ".donnees"),
+  descripteur(::open (chemin.c_str (), O_RDWR | O_CREAT | O_TRUNC, 0644)) { }
+
+  ~EcrivainAsynchroneTest()
+  {
+    ::close (descripteur);
+    remove (chemin.c_str ());
+  }
+
+  string lireFichier() const
+  {
+    ifstream fichier(chemin, ios::binary);
+    ostringstream os;
+    os << fichier.rdbuf ();
+    return os.str ();
+  }
+
+  string chemin;
+  int descripteur;
+};
+
+
+/**
+ * \brief Test du constructeur
+ *     Cas valides : le repli sur pwrite est respecté lorsque io_uring est refusé.
+ *     Cas invalides : une profondeur nulle est refusée.
+ */
+TEST(EcrivainAsynchroneConstructeurTest, constructeur_IoUringRefuse_ReplisurPwrite)
+{
+  EcrivainAsynchrone ecrivain(8, false);
+  ASSERT_FALSE(ecrivain.reqUtiliseIoUring ());
+  ASSERT_EQ(8u, ecrivain.reqProfondeur ());
+}
+
+TEST(EcrivainAsynchroneConstructeurTest, constructeur_ProfondeurNulle_PreconditionException)
+{
+  ASSERT_THROW(EcrivainAsynchrone ecrivain(0), PreconditionException);
+}
+
+
+/**
+ * \brief Test des méthodes ecrire, synchroniser et attendre
+ *     Cas valides : des pages écrites à des positions arbitraires se retrouvent
+ *                   dans le fichier, et chaque rappel est appelé avec succès,
+ *                   par io_uring comme par pwrite.
+ *     Cas invalides : une écriture sur un descripteur fermé rapporte l'erreur.
+ */
+TEST_P(EcrivainAsynchroneTest, ecrire_PagesDesordonnees_FichierComplet)
+{
+  EcrivainAsynchrone ecrivain(4, GetParam ());
+  atomic<int> succes(0);
+  auto rappel = [&succes] (int p_erreur)
+    {
+      if (p_erreur == 0)
+        {
+          ++succes;
+        }
+    };
+  for (int page = 9; page >= 0; --page)
+    {
+      ecrivain.ecrire (descripteur, page * 4, string(4, static_cast<char> ('a' + page)), rappel);
+    }
+  ecrivain.synchroniser (descripteur, rappel);
+  ecrivain.attendre ();
+
+  ASSERT_EQ(11, succes.load ());
+  ASSERT_EQ("aaaabbbbccccddddeeeeffffgggghhhhiiiijjjj", lireFichier ());
+}
+
+TEST_P(EcrivainAsynchroneTest, ecrire_DescripteurFerme_ErreurRapportee)
+{
+  EcrivainAsynchrone ecrivain(4, GetParam ());
+  int fd = ::open (chemin.c_str (), O_RDONLY);
+  ::close (fd);
+  int erreur = 0;
+  ecrivain.ecrire (fd, 0, "x", [&erreur] (int p_erreur) { erreur = p_erreur; });
+  ecrivain.attendre ();
+  ASSERT_NE(0, erreur);
+}
+
+
+
+/**
+ * \brief Test de la méthode synchroniser après une écriture en échec
+ *     Cas valides : une synchronisation réussie suivante rapporte encore
+ *                   l'échec d'une écriture, même d'un lot précédent ; l'échec
+ *                   n'est rapporté qu'une fois.
+ *     Cas invalides : une écriture sur un descripteur en lecture seule échoue.
+ */
+TEST_P(EcrivainAsynchroneTest, synchroniser_EcritureEchouee_ErreurRapportee)
+{
+  EcrivainAsynchrone ecrivain(2, GetParam ());
+  int lectureSeule = ::open (chemin.c_str (), O_RDONLY);
+  int erreurEcriture = 0;
+  int erreurSynchronisation = 0;
+  int erreurSuivante = -1;
+  ecrivain.ecrire (lectureSeule, 0, "a");
+  ecrivain.ecrire (lectureSeule, 1, "b", [&erreurEcriture] (int p_erreur) { erreurEcriture = p_erreur; });
+  ecrivain.ecrire (lectureSeule, 2, "c");
+  ecrivain.synchroniser (lectureSeule, [&erreurSynchronisation] (int p_erreur) { erreurSynchronisation = p_erreur; });
+  ecrivain.synchroniser (lectureSeule, [&erreurSuivante] (int p_erreur) { erreurSuivante = p_erreur; });
+  ecrivain.attendre ();
+  ::close (lectureSeule);
+
+  ASSERT_NE(0, erreurEcriture);
+  ASSERT_EQ(erreurEcriture, erreurSynchronisation);
+  ASSERT_EQ(0, erreurSuivante);
+}
+
+INSTANTIATE_TEST_SUITE_P(IoUringEtPwrite, EcrivainAsynchroneTest, ::testing::Bool ());
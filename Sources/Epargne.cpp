@@ -8,6 +8,8 @@
 #include"ContratException.h"
 #include"Compte.h"
 #include"Date.h"
+#include"Metriques.h"
+#include"Trace.h"
 #include<sstream>
 #include<memory>
 
@@ -91,6 +93,7 @@ void Epargne::asgSolde(double p_solde)
  */
 double Epargne::calculerInteret() const
 {
+  MESURER(CompteCalculerInteret);
   return reqSolde()*(reqTauxInteret()/100);
 }
 
@@ -111,6 +114,8 @@ std::unique_ptr<Compte> Epargne::clone() const
  */
 std::string Epargne::reqCompteFormate() const
 {
+  MESURER(CompteReqCompteFormate);
+  TRACE_SCOPE("Epargne::reqCompteFormate");
   ostringstream os;
   os<<"Compte Epargne"<<endl;
   os<<Compte::reqCompteFormate ();
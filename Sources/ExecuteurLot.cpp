@@ -0,0 +1,289 @@
+/**
+ * \file ExecuteurLot.cpp
+ * \brief Implantation de la classe ExecuteurLot
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "ExecuteurLot.h"
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <future>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Découpe une ligne en champs séparés par '|', sans copie
+ */
+class Champs
+{
+public:
+  explicit Champs (string_view p_ligne) : m_reste(p_ligne), m_epuise(false) { }
+
+  bool suivant (string_view& p_champ)
+  {
+    if (m_epuise)
+      {
+        return false;
+      }
+    size_t separateur = m_reste.find ('|');
+    p_champ = m_reste.substr (0, separateur);
+    if (separateur == string_view::npos)
+      {
+        m_epuise = true;
+      }
+    else
+      {
+        m_reste.remove_prefix (separateur + 1);
+      }
+    return true;
+  }
+
+  bool termine () const
+  {
+    return m_epuise;
+  }
+
+private:
+  string_view m_reste;
+  bool m_epuise;
+};
+
+
+template <typename T>
+bool
+lireNombre (Champs& p_champs, T& p_valeur)
+{
+  string_view champ;
+  if (!p_champs.suivant (champ) || champ.empty ())
+    {
+      return false;
+    }
+  const char* fin = champ.data () + champ.size ();
+  from_chars_result resultat = from_chars (champ.data (), fin, p_valeur);
+  return resultat.ec == errc () && resultat.ptr == fin;
+}
+
+
+bool
+lireTexte (Champs& p_champs, string& p_texte)
+{
+  string_view champ;
+  if (!p_champs.suivant (champ))
+    {
+      return false;
+    }
+  p_texte.assign (champ.data (), champ.size ());
+  return true;
+}
+
+
+/**
+ * \brief Lit une date au format jj mm aaaa
+ */
+bool
+lireDate (Champs& p_champs, EnregistrementJournal& p_operation)
+{
+  string_view champ;
+  if (!p_champs.suivant (champ) || champ.size () != 10 || champ[2] != ' ' || champ[5] != ' ')
+    {
+      return false;
+    }
+  const char* debut = champ.data ();
+  return from_chars (debut, debut + 2, p_operation.jour).ptr == debut + 2
+          && from_chars (debut + 3, debut + 5, p_operation.mois).ptr == debut + 5
+          && from_chars (debut + 6, debut + 10, p_operation.annee).ptr == debut + 10;
+}
+
+
+/**
+ * \brief Attend la durabilité d'une opération et compte son échec éventuel
+ * \param[in,out] p_attente le numéro de la ligne et le futur rendu par Banque::executer
+ * \param[in,out] p_bilan le décompte auquel une erreur de journal est ajoutée
+ * \param[in] p_erreurs le flux où signaler l'erreur, ou nullptr
+ */
+void
+constaterDurabilite (pair<size_t, future<void>>& p_attente, BilanLot& p_bilan, ostream* p_erreurs)
+{
+  try
+    {
+      p_attente.second.get ();
+    }
+  catch (const exception& erreur)
+    {
+      ++p_bilan.erreurs;
+      if (p_erreurs != nullptr)
+        {
+          *p_erreurs << "ligne " << p_attente.first << " : journal : " << erreur.what () << endl;
+        }
+    }
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe ExecuteurLot
+ * \param[in] p_banque la banque sur laquelle les scripts sont exécutés
+ */
+ExecuteurLot::ExecuteurLot(Banque& p_banque) : m_banque(p_banque) { }
+
+
+/**
+ * \brief Exécute toutes les opérations d'un script
+ *
+ * Les opérations passent par Banque::executer : elles sont journalisées si un
+ * journal est attaché à la banque. Le futur de chacune est conservé jusqu'à ce
+ * qu'elle soit durable : ceux qui sont prêts sont relevés au fil du script, les
+ * autres à la fin, et chaque opération que le journal n'a pas pu écrire est
+ * signalée et comptée parmi les erreurs.
+ *
+ * \param[in] p_script le flux qui contient le script
+ * \param[in] p_erreurs le flux où signaler les lignes rejetées, ou nullptr
+ * \return le décompte des lignes lues, des opérations exécutées et des erreurs
+ */
+BilanLot ExecuteurLot::executer(std::istream& p_script, std::ostream* p_erreurs)
+{
+  BilanLot bilan;
+  string ligne;
+  EnregistrementJournal operation;
+  deque<pair<size_t, future<void>>> enAttente;
+  while (getline (p_script, ligne))
+    {
+      ++bilan.lignes;
+      string_view vue(ligne);
+      if (!vue.empty () && vue.back () == '\r')
+        {
+          vue.remove_suffix (1);
+        }
+      if (vue.empty () || vue.front () == '#')
+        {
+          continue;
+        }
+      if (!analyserLigne (vue, operation))
+        {
+          ++bilan.erreurs;
+          if (p_erreurs != nullptr)
+            {
+              *p_erreurs << "ligne " << bilan.lignes << " : syntaxe invalide" << endl;
+            }
+          continue;
+        }
+      if (!validerEnregistrement (operation))
+        {
+          ++bilan.erreurs;
+          if (p_erreurs != nullptr)
+            {
+              *p_erreurs << "ligne " << bilan.lignes << " : operation invalide" << endl;
+            }
+          continue;
+        }
+      try
+        {
+          enAttente.emplace_back (bilan.lignes, m_banque.executer (operation));
+          ++bilan.executees;
+        }
+      catch (const exception& erreur)
+        {
+          ++bilan.erreurs;
+          if (p_erreurs != nullptr)
+            {
+              *p_erreurs << "ligne " << bilan.lignes << " : " << erreur.what () << endl;
+            }
+        }
+      while (!enAttente.empty ()
+             && enAttente.front ().second.wait_for (chrono::seconds(0)) == future_status::ready)
+        {
+          constaterDurabilite (enAttente.front (), bilan, p_erreurs);
+          enAttente.pop_front ();
+        }
+    }
+
+  for (auto& attente : enAttente)
+    {
+      constaterDurabilite (attente, bilan, p_erreurs);
+    }
+  return bilan;
+}
+
+
+/**
+ * \brief Traduit une ligne de script en opération
+ *
+ * Seule la syntaxe est vérifiée ici ; executer soumet ensuite l'opération à
+ * validerEnregistrement (folio, format du nom, date, taux, ...), car les
+ * contrats de Client, Cheque et Epargne disparaissent avec NDEBUG.
+ *
+ * \param[in] p_ligne la ligne, sans fin de ligne
+ * \param[out] p_operation l'opération décrite, dont les chaînes sont réutilisées
+ * \return vrai si la ligne est une opération bien formée
+ */
+bool ExecuteurLot::analyserLigne(std::string_view p_ligne, EnregistrementJournal& p_operation)
+{
+  Champs champs(p_ligne);
+  string_view commande;
+  champs.suivant (commande);
+  bool valide = false;
+
+  if (commande == "CLIENT")
+    {
+      p_operation.type = TypeOperation::AjoutClient;
+      valide = lireNombre (champs, p_operation.noFolio) && lireTexte (champs, p_operation.nom)
+              && lireTexte (champs, p_operation.prenom) && lireTexte (champs, p_operation.telephone)
+              && lireDate (champs, p_operation);
+    }
+  else if (commande == "CHEQUE")
+    {
+      p_operation.type = TypeOperation::AjoutCheque;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte)
+              && lireTexte (champs, p_operation.description) && lireNombre (champs, p_operation.tauxInteret)
+              && lireNombre (champs, p_operation.solde) && lireNombre (champs, p_operation.nombreTransactions)
+              && lireNombre (champs, p_operation.tauxInteretMinimum);
+    }
+  else if (commande == "EPARGNE")
+    {
+      p_operation.type = TypeOperation::AjoutEpargne;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte)
+              && lireTexte (champs, p_operation.description) && lireNombre (champs, p_operation.tauxInteret)
+              && lireNombre (champs, p_operation.solde);
+    }
+  else if (commande == "SUPPRIMER")
+    {
+      p_operation.type = TypeOperation::SuppressionCompte;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte);
+    }
+  else if (commande == "SOLDE")
+    {
+      p_operation.type = TypeOperation::AsgSolde;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte)
+              && lireNombre (champs, p_operation.solde);
+    }
+  else if (commande == "TAUX")
+    {
+      p_operation.type = TypeOperation::AsgTauxInteret;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte)
+              && lireNombre (champs, p_operation.tauxInteret);
+    }
+  else if (commande == "TRANSACTIONS")
+    {
+      p_operation.type = TypeOperation::AsgNombreTransactions;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte)
+              && lireNombre (champs, p_operation.nombreTransactions);
+    }
+  else if (commande == "DESCRIPTION")
+    {
+      p_operation.type = TypeOperation::AsgDescription;
+      valide = lireNombre (champs, p_operation.noFolio) && lireNombre (champs, p_operation.noCompte)
+              && lireTexte (champs, p_operation.description);
+    }
+
+  return valide && champs.termine ();
+}
+
+} //namespace bancaire
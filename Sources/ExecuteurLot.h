@@ -0,0 +1,69 @@
+/**
+ * \file ExecuteurLot.h
+ * \brief Fichier qui contient l'interface de la classe ExecuteurLot.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef EXECUTEURLOT_H
+#define EXECUTEURLOT_H
+
+#include "Banque.h"
+#include "Journal.h"
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+namespace bancaire
+{
+/**
+ * \struct BilanLot
+ * \brief Décompte d'une exécution en lot
+ */
+struct BilanLot
+{
+  std::size_t lignes = 0;
+  std::size_t executees = 0;
+  std::size_t erreurs = 0;
+};
+
+/**
+ * \class ExecuteurLot
+ * \brief Exécute sur une Banque, sans dialogue, les opérations d'un script.
+ *
+ * Pendant non interactif des fonctions de FonctionsEntree : chaque ligne du
+ * script décrit une opération complète, dont les champs sont séparés par '|'.
+ *
+ *     CLIENT|folio|nom|prenom|telephone|jj mm aaaa
+ *     CHEQUE|folio|noCompte|description|taux|solde|transactions|tauxMinimum
+ *     EPARGNE|folio|noCompte|description|taux|solde
+ *     SUPPRIMER|folio|noCompte
+ *     SOLDE|folio|noCompte|solde
+ *     TAUX|folio|noCompte|taux
+ *     TRANSACTIONS|folio|noCompte|transactions
+ *     DESCRIPTION|folio|noCompte|description
+ *
+ * Les lignes vides et celles qui commencent par '#' sont ignorées. Les nombres
+ * sont lus par std::from_chars, et la ligne comme l'enregistrement sont
+ * réutilisés d'une ligne à l'autre : un script de plusieurs centaines de
+ * milliers d'opérations n'alloue presque rien. Une ligne mal formée, qui
+ * enfreint les règles de saisie de FonctionsEntree (validerEnregistrement) ou
+ * qui est refusée par la banque est signalée avec son numéro et comptée, puis
+ * l'exécution continue.
+ */
+class ExecuteurLot
+{
+public:
+  explicit ExecuteurLot(Banque& p_banque);
+
+  //methodes
+  BilanLot executer(std::istream& p_script, std::ostream* p_erreurs = nullptr);
+  static bool analyserLigne(std::string_view p_ligne, EnregistrementJournal& p_operation);
+
+private:
+  Banque& m_banque;
+};
+
+} //namespace bancaire
+
+#endif /* EXECUTEURLOT_H */
@@ -0,0 +1,171 @@
+/**
+ * \file ExecuteurLotTesteur.cpp
+ * \brief Test unitaire de la classe ExecuteurLot.
+ *
+ * À tester :
+ *         BilanLot executer(std::istream& p_script, std::ostream* p_erreurs);
+ *         static bool analyserLigne(std::string_view p_ligne, EnregistrementJournal& p_operation);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ExecuteurLot.h"
+#include "Cheque.h"
+#include "GroupeValidation.h"
+#include <sstream>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Test de la méthode static bool analyserLigne(std::string_view p_ligne, EnregistrementJournal& p_operation);
+ *     Cas valides : chaque champ de la ligne est rangé dans l'opération.
+ *     Cas invalides : commande inconnue, nombre mal formé, champ manquant ou en trop.
+ */
+TEST(ExecuteurLot, analyserLigne_LigneCheque_ChampsLus)
+{
+  EnregistrementJournal operation;
+  ASSERT_TRUE(ExecuteurLot::analyserLigne ("CHEQUE|2000|12|Loyer du mois|2.5|-150.25|10|1.5", operation));
+  ASSERT_EQ(TypeOperation::AjoutCheque, operation.type);
+  ASSERT_EQ(2000, operation.noFolio);
+  ASSERT_EQ(12, operation.noCompte);
+  ASSERT_EQ("Loyer du mois", operation.description);
+  ASSERT_DOUBLE_EQ(2.5, operation.tauxInteret);
+  ASSERT_DOUBLE_EQ(-150.25, operation.solde);
+  ASSERT_EQ(10, operation.nombreTransactions);
+  ASSERT_DOUBLE_EQ(1.5, operation.tauxInteretMinimum);
+}
+
+TEST(ExecuteurLot, analyserLigne_LigneClient_DateLue)
+{
+  EnregistrementJournal operation;
+  ASSERT_TRUE(ExecuteurLot::analyserLigne ("CLIENT|2000|Ancelotti|Carlo|590 234-0342|20 01 1983", operation));
+  ASSERT_EQ(TypeOperation::AjoutClient, operation.type);
+  ASSERT_EQ("Ancelotti", operation.nom);
+  ASSERT_EQ("590 234-0342", operation.telephone);
+  ASSERT_EQ(20, operation.jour);
+  ASSERT_EQ(1, operation.mois);
+  ASSERT_EQ(1983, operation.annee);
+}
+
+TEST(ExecuteurLot, analyserLigne_LignesMalFormees_Refusees)
+{
+  EnregistrementJournal operation;
+  ASSERT_FALSE(ExecuteurLot::analyserLigne ("VIREMENT|2000|1", operation));
+  ASSERT_FALSE(ExecuteurLot::analyserLigne ("SOLDE|2000|1|12,5", operation));
+  ASSERT_FALSE(ExecuteurLot::analyserLigne ("SOLDE|2000|1", operation));
+  ASSERT_FALSE(ExecuteurLot::analyserLigne ("SOLDE|2000|1|12|3", operation));
+  ASSERT_FALSE(ExecuteurLot::analyserLigne ("SUPPRIMER|2000|", operation));
+  ASSERT_FALSE(ExecuteurLot::analyserLigne ("CLIENT|2000|Ancelotti|Carlo|590 234-0342|20/01/1983", operation));
+}
+
+
+/**
+ * \brief Test de la méthode BilanLot executer(std::istream& p_script, std::ostream* p_erreurs);
+ *     Cas valides : les opérations du script sont appliquées à la banque,
+ *                   les commentaires et lignes vides sont ignorés.
+ *     Cas invalides : les lignes mal formées, hors des règles de saisie
+ *                     (folio, nom, date, téléphone, taux) ou refusées par la
+ *                     banque sont signalées avec leur numéro, sans arrêter le lot ;
+ *                     chaque opération que le journal ne peut pas écrire est
+ *                     comptée, quel que soit son lot.
+ */
+TEST(ExecuteurLot, executer_ScriptValide_OperationsAppliquees)
+{
+  Banque banque;
+  istringstream script("# population\n"
+                       "CLIENT|2000|Ancelotti|Carlo|590 234-0342|20 01 1983\r\n"
+                       "CHEQUE|2000|1|Loyer|2|100|5|1\n"
+                       "EPARGNE|2000|2|Etudes|1.5|500\n"
+                       "\n"
+                       "SOLDE|2000|1|250\n"
+                       "TRANSACTIONS|2000|1|8\n"
+                       "SUPPRIMER|2000|2\n");
+  BilanLot bilan = ExecuteurLot(banque).executer (script);
+
+  ASSERT_EQ(8u, bilan.lignes);
+  ASSERT_EQ(6u, bilan.executees);
+  ASSERT_EQ(0u, bilan.erreurs);
+  const Client& client = banque.reqClient (2000);
+  ASSERT_EQ(1u, client.reqComptes ());
+  ASSERT_DOUBLE_EQ(250, client.reqCompte (1).reqSolde ());
+  ASSERT_EQ(8, dynamic_cast<const Cheque&> (client.reqCompte (1)).reqNombreTransactions ());
+}
+
+TEST(ExecuteurLot, executer_LignesRejetees_SignaleesEtLotPoursuivi)
+{
+  Banque banque;
+  istringstream script("CLIENT|2000|Ancelotti|Carlo|590 234-0342|20 01 1983\n"
+                       "EPARGNE|2000|1|Etudes|1.5|500\n"
+                       "EPARGNE|2000|1|Etudes|1.5|500\n"
+                       "SOLDE|2000|un|500\n"
+                       "SOLDE|2000|1|750\n");
+  ostringstream erreurs;
+  BilanLot bilan = ExecuteurLot(banque).executer (script, &erreurs);
+
+  ASSERT_EQ(3u, bilan.executees);
+  ASSERT_EQ(2u, bilan.erreurs);
+  ASSERT_NE(string::npos, erreurs.str ().find ("ligne 3 : "));
+  ASSERT_NE(string::npos, erreurs.str ().find ("ligne 4 : syntaxe invalide"));
+  ASSERT_DOUBLE_EQ(750, banque.reqClient (2000).reqCompte (1).reqSolde ());
+}
+
+TEST(ExecuteurLot, executer_ReglesDeSaisieEnfreintes_LignesRefusees)
+{
+  Banque banque;
+  istringstream script("CLIENT|999|Ancelotti|Carlo|590 234-0342|20 01 1983\n"
+                       "CLIENT|2000|Ancelotti1|Carlo|590 234-0342|20 01 1983\n"
+                       "CLIENT|2000|Ancelotti|Carlo|590 234-0342|31 02 1983\n"
+                       "CLIENT|2000|Ancelotti|Carlo||20 01 1983\n"
+                       "CLIENT|2000|Ancelotti|Carlo|590 234-0342|20 01 1983\n"
+                       "EPARGNE|2000|1|Etudes|5|500\n"
+                       "SOLDE|10000|1|500\n");
+  ostringstream erreurs;
+  BilanLot bilan = ExecuteurLot(banque).executer (script, &erreurs);
+
+  ASSERT_EQ(1u, bilan.executees);
+  ASSERT_EQ(6u, bilan.erreurs);
+  ASSERT_NE(string::npos, erreurs.str ().find ("ligne 1 : operation invalide"));
+  ASSERT_NE(string::npos, erreurs.str ().find ("ligne 7 : operation invalide"));
+  ASSERT_EQ(0u, banque.reqClient (2000).reqComptes ());
+}
+
+TEST(ExecuteurLot, executer_MutationIncompatibleAvecLeCompte_LigneRefusee)
+{
+  Banque banque;
+  istringstream script("CLIENT|1000|Ancelotti|Carlo|590 234-0342|20 01 1983\n"
+                       "EPARGNE|1000|2|Etudes|1.5|500\n"
+                       "TRANSACTIONS|1000|2|5\n"
+                       "SOLDE|1000|2|-50\n");
+  ostringstream erreurs;
+  BilanLot bilan = ExecuteurLot(banque).executer (script, &erreurs);
+
+  ASSERT_EQ(2u, bilan.executees);
+  ASSERT_EQ(2u, bilan.erreurs);
+  ASSERT_NE(string::npos, erreurs.str ().find ("ligne 3 : Le nombre de transactions"));
+  ASSERT_NE(string::npos, erreurs.str ().find ("ligne 4 : Le solde d'un compte epargne"));
+  ASSERT_DOUBLE_EQ(500, banque.reqClient (1000).reqCompte (2).reqSolde ());
+}
+
+TEST(ExecuteurLot, executer_JournalEnEchec_ChaqueLotCompte)
+{
+  Banque banque;
+  istringstream script("CLIENT|1000|Ancelotti|Carlo|590 234-0342|20 01 1983\n"
+                       "EPARGNE|1000|2|Etudes|1.5|500\n"
+                       "SOLDE|1000|2|750\n");
+  ostringstream erreurs;
+  BilanLot bilan;
+  {
+    GroupeValidation journal("/dev/full", 1, chrono::microseconds(0));
+    banque.asgJournal (&journal);
+    bilan = ExecuteurLot(banque).executer (script, &erreurs);
+    banque.asgJournal (nullptr);
+  }
+
+  ASSERT_EQ(3u, bilan.executees);
+  ASSERT_EQ(3u, bilan.erreurs);
+  for (const char* ligne : {"ligne 1 : journal : ", "ligne 2 : journal : ", "ligne 3 : journal : "})
+    {
+      ASSERT_NE(string::npos, erreurs.str ().find (ligne));
+    }
+}
@@ -0,0 +1,458 @@
+/**
+ * \file GenerateurCharge.cpp
+ * \brief Implantation de la classe GenerateurCharge
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "GenerateurCharge.h"
+#include "Cheque.h"
+#include "ContratException.h"
+#include "Date.h"
+#include "Epargne.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+const int FOLIO_MINIMUM = 1000;
+const size_t NOMBRE_FOLIOS = 9000;
+const size_t COMPTES_PAR_CLIENT_MOYEN = 4;
+
+const char* const PRENOMS[] = {"Jean", "Marie", "Louis", "Sophie", "Pierre", "Julie", "Marc", "Nathalie",
+                               "Luc", "Isabelle", "Paul", "Chantal", "Andre", "Sylvie", "Michel", "Claire",
+                               "Olivier", "Camille", "Francois", "Anne", "Etienne", "Lea", "Gabriel", "Emma"};
+const char* const NOMS[] = {"Tremblay", "Gagnon", "Roy", "Cote", "Bouchard", "Gauthier", "Morin", "Lavoie",
+                            "Fortin", "Gagne", "Ouellet", "Pelletier", "Belanger", "Levesque", "Bergeron",
+                            "Leblanc", "Paquette", "Girard", "Simard", "Boucher", "Caron", "Beaulieu",
+                            "Cloutier", "Dube"};
+const char* const INDICATIFS[] = {"418", "581", "367", "514", "438", "450", "819", "873"};
+const char* const DESCRIPTIONS_CHEQUE[] = {"Courant", "Loyer", "Voyage", "Epicerie"};
+const char* const DESCRIPTIONS_EPARGNE[] = {"Etudes", "Retraite", "Urgence", "Projet"};
+const float TAUX_MINIMUMS_CHEQUE[] = {0.5f, 1.0f, 1.5f, 2.0f};
+
+template<typename T, size_t N>
+constexpr size_t
+taille (const T (&)[N])
+{
+  return N;
+}
+
+
+/**
+ * \brief Étape de splitmix64, utilisée comme générateur et pour dériver les graines
+ */
+uint64_t
+melanger (uint64_t& p_etat)
+{
+  uint64_t z = (p_etat += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+
+/**
+ * \brief Moitié haute du produit de deux entiers de 64 bits
+ *        Calculée sur des moitiés de 32 bits, sans entier de 128 bits : le
+ *        résultat est exact et identique sur tous les compilateurs.
+ */
+uint64_t
+produitHaut (uint64_t p_gauche, uint64_t p_droite)
+{
+  const uint64_t gaucheBas = p_gauche & 0xFFFFFFFFu;
+  const uint64_t gaucheHaut = p_gauche >> 32;
+  const uint64_t droiteBas = p_droite & 0xFFFFFFFFu;
+  const uint64_t droiteHaut = p_droite >> 32;
+
+  const uint64_t basBas = gaucheBas * droiteBas;
+  const uint64_t hautBas = gaucheHaut * droiteBas;
+  const uint64_t basHaut = gaucheBas * droiteHaut;
+  const uint64_t milieu = (basBas >> 32) + (hautBas & 0xFFFFFFFFu) + basHaut;
+  return gaucheHaut * droiteHaut + (hautBas >> 32) + (milieu >> 32);
+}
+
+
+double
+arrondirCents (double p_montant)
+{
+  return round (p_montant * 100.0) / 100.0;
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe GenerateurCharge
+ *        Les folios et le nombre de comptes de chaque client sont fixés ici.
+ * \param[in] p_parametres les réglages de la charge
+ * \pre p_parametres.nombreComptes doit être supérieur à zéro
+ * \pre p_parametres.exposantZipf ne doit pas être négatif
+ * \pre les proportions doivent être dans [0, 1] et leur somme ne pas dépasser 1
+ */
+GenerateurCharge::GenerateurCharge(const ParametresCharge& p_parametres):
+        m_parametres(p_parametres), m_etat(p_parametres.graine), m_populationGeneree(false)
+{
+  PRECONDITION(p_parametres.nombreComptes>0);
+  PRECONDITION(p_parametres.exposantZipf>=0);
+  PRECONDITION(p_parametres.proportionCheques>=0 && p_parametres.proportionCheques<=1);
+  PRECONDITION(p_parametres.proportionDepots>=0 && p_parametres.proportionRetraits>=0
+               && p_parametres.proportionTaux>=0);
+  PRECONDITION(p_parametres.proportionDepots + p_parametres.proportionRetraits
+               + p_parametres.proportionTaux<=1);
+
+  repartirComptes ();
+
+  POSTCONDITION(m_folios.size ()==m_comptesParClient.size ());
+}
+
+
+/**
+ * \brief Retourne les réglages de la charge
+ * \return les paramètres fournis au constructeur
+ */
+const ParametresCharge& GenerateurCharge::reqParametres() const
+{
+  return m_parametres;
+}
+
+
+/**
+ * \brief Retourne le nombre de clients de la population
+ * \return un size_t qui représente le nombre de clients
+ */
+std::size_t GenerateurCharge::reqNombreClients() const
+{
+  return m_folios.size ();
+}
+
+
+/**
+ * \brief Retourne le nombre de comptes qui n'ont pas été supprimés par les opérations
+ * \return un size_t qui représente le nombre de comptes actifs
+ */
+std::size_t GenerateurCharge::reqNombreComptesActifs() const
+{
+  return m_comptes.size ();
+}
+
+
+/**
+ * \brief Produit la population : chaque client suivi de ses comptes, par folio croissant
+ *        Rappeler cette méthode reproduit la même population et recommence
+ *        le flot d'opérations au début.
+ * \param[in] p_consommateur reçoit chaque enregistrement dans l'ordre
+ */
+void GenerateurCharge::genererPopulation(const Consommateur& p_consommateur)
+{
+  uint64_t derivation = m_parametres.graine;
+  m_etat = melanger (derivation);
+  m_comptes.clear ();
+  m_comptes.reserve (m_parametres.nombreComptes);
+
+  for (size_t i = 0; i < m_folios.size (); ++i)
+    {
+      p_consommateur (genererClient (m_folios[i]));
+      for (int32_t noCompte = 1; noCompte <= m_comptesParClient[i]; ++noCompte)
+        {
+          p_consommateur (genererCompte (m_folios[i], noCompte));
+        }
+    }
+  m_populationGeneree = true;
+
+  POSTCONDITION(m_comptes.size ()==m_parametres.nombreComptes);
+}
+
+
+/**
+ * \brief Produit un flot de dépôts, retraits, changements de taux et suppressions
+ *        sur les comptes actifs de la population.
+ * \param[in] p_nombre le nombre d'opérations demandées
+ * \param[in] p_consommateur reçoit chaque opération dans l'ordre
+ * \return le nombre d'opérations produites, moindre que p_nombre seulement si
+ *         tous les comptes ont été supprimés
+ * \pre la population doit avoir été générée
+ */
+std::size_t GenerateurCharge::genererOperations(std::size_t p_nombre, const Consommateur& p_consommateur)
+{
+  PRECONDITION(m_populationGeneree);
+
+  const double seuilRetraits = m_parametres.proportionDepots + m_parametres.proportionRetraits;
+  const double seuilTaux = seuilRetraits + m_parametres.proportionTaux;
+  EnregistrementJournal operation;
+  size_t produites = 0;
+  for (; produites < p_nombre && !m_comptes.empty (); ++produites)
+    {
+      const double tirage = tirerReel ();
+      const size_t indice = tirerEntier (m_comptes.size ());
+      CompteCharge& compte = m_comptes[indice];
+      operation.noFolio = compte.noFolio;
+      operation.noCompte = compte.noCompte;
+
+      if (tirage < seuilRetraits)
+        {
+          double montant = arrondirCents (1 + tirerReel () * 1000);
+          if (tirage >= m_parametres.proportionDepots)
+            {
+              montant = compte.estCheque ? -montant : -min (montant, compte.solde);
+            }
+          compte.solde = arrondirCents (compte.solde + montant);
+          operation.type = TypeOperation::AsgSolde;
+          operation.solde = compte.solde;
+        }
+      else if (tirage < seuilTaux)
+        {
+          operation.type = TypeOperation::AsgTauxInteret;
+          operation.tauxInteret = compte.estCheque
+                  ? compte.tauxInteretMinimum + static_cast<double> (tirerEntier (81)) / 10.0
+                  : static_cast<double> (1 + tirerEntier (35)) / 10.0;
+        }
+      else
+        {
+          operation.type = TypeOperation::SuppressionCompte;
+          m_comptes[indice] = m_comptes.back ();
+          m_comptes.pop_back ();
+        }
+      p_consommateur (operation);
+    }
+  return produites;
+}
+
+
+/**
+ * \brief Construit directement la Banque qui correspond à la population
+ *        Les portefeuilles sont remplis en bloc, ce qui reste linéaire même
+ *        pour les plus gros clients.
+ * \return la banque peuplée, sans journal associé
+ */
+Banque GenerateurCharge::construireBanque()
+{
+  TRACE_SCOPE("GenerateurCharge::construireBanque");
+  Banque banque;
+  EnregistrementJournal creation;
+  vector<unique_ptr<Compte>> comptes;
+  bool clientEnCours = false;
+
+  auto terminerClient = [&] ()
+  {
+    if (clientEnCours)
+      {
+        Client client(creation.noFolio, creation.nom, creation.prenom, creation.telephone,
+                      util::Date(creation.jour, creation.mois, creation.annee));
+        client.ajouterComptesEnBloc (move (comptes));
+        banque.ajouterClient (move (client));
+        comptes.clear ();
+      }
+  };
+
+  genererPopulation ([&] (const EnregistrementJournal& p_enregistrement)
+  {
+    switch (p_enregistrement.type)
+      {
+      case TypeOperation::AjoutClient:
+        terminerClient ();
+        creation = p_enregistrement;
+        clientEnCours = true;
+        break;
+      case TypeOperation::AjoutCheque:
+        comptes.push_back (make_unique<Cheque>(p_enregistrement.noCompte,
+                                               p_enregistrement.nombreTransactions,
+                                               p_enregistrement.solde, p_enregistrement.tauxInteret,
+                                               p_enregistrement.description,
+                                               p_enregistrement.tauxInteretMinimum));
+        break;
+      default:
+        comptes.push_back (make_unique<Epargne>(p_enregistrement.noCompte,
+                                                p_enregistrement.tauxInteret,
+                                                p_enregistrement.solde,
+                                                p_enregistrement.description));
+        break;
+      }
+  });
+  terminerClient ();
+  return banque;
+}
+
+
+/**
+ * \brief Tire un entier pseudo-aléatoire de 64 bits
+ */
+std::uint64_t GenerateurCharge::tirer()
+{
+  return melanger (m_etat);
+}
+
+
+/**
+ * \brief Tire un réel uniforme dans [0, 1)
+ */
+double GenerateurCharge::tirerReel()
+{
+  return static_cast<double> (tirer () >> 11) * 0x1.0p-53;
+}
+
+
+/**
+ * \brief Tire un entier uniforme dans [0, p_borne)
+ *        Réduction multiplicative de Lemire, sans rejet : le biais, au plus
+ *        p_borne / 2^64, est négligeable pour les bornes d'un banc d'essai.
+ */
+std::uint64_t GenerateurCharge::tirerEntier(std::uint64_t p_borne)
+{
+  return produitHaut (tirer (), p_borne);
+}
+
+
+/**
+ * \brief Choisit les folios des clients et leur nombre de comptes
+ *        Le client de rang r reçoit un compte, plus une part des comptes
+ *        restants proportionnelle à 1 / r^exposantZipf. Les rangs sont
+ *        ensuite distribués au hasard entre les folios.
+ */
+void GenerateurCharge::repartirComptes()
+{
+  const size_t nombreComptes = m_parametres.nombreComptes;
+  const size_t nombreClients = min (NOMBRE_FOLIOS, max<size_t> (1, nombreComptes / COMPTES_PAR_CLIENT_MOYEN));
+
+  vector<double> poids(nombreClients);
+  double total = 0;
+  for (size_t rang = 0; rang < nombreClients; ++rang)
+    {
+      poids[rang] = pow (static_cast<double> (rang + 1), -m_parametres.exposantZipf);
+      total += poids[rang];
+    }
+
+  const size_t restants = nombreComptes - nombreClients;
+  m_comptesParClient.assign (nombreClients, 1);
+  size_t attribues = nombreClients;
+  for (size_t rang = 0; rang < nombreClients; ++rang)
+    {
+      size_t part = static_cast<size_t> (static_cast<double> (restants) * poids[rang] / total);
+      m_comptesParClient[rang] += static_cast<int32_t> (part);
+      attribues += part;
+    }
+  for (size_t rang = 0; attribues < nombreComptes; ++rang, ++attribues)
+    {
+      ++m_comptesParClient[rang % nombreClients];
+    }
+
+  vector<int32_t> folios(NOMBRE_FOLIOS);
+  for (size_t i = 0; i < NOMBRE_FOLIOS; ++i)
+    {
+      folios[i] = FOLIO_MINIMUM + static_cast<int32_t> (i);
+    }
+  for (size_t i = NOMBRE_FOLIOS - 1; i > 0; --i)
+    {
+      swap (folios[i], folios[tirerEntier (i + 1)]);
+    }
+  folios.resize (nombreClients);
+
+  // Les clients sont émis par folio croissant, chacun avec le nombre de comptes de son rang.
+  vector<size_t> ordre(nombreClients);
+  for (size_t i = 0; i < nombreClients; ++i)
+    {
+      ordre[i] = i;
+    }
+  sort (ordre.begin (), ordre.end (), [&] (size_t p_a, size_t p_b)
+  {
+    return folios[p_a] < folios[p_b];
+  });
+  m_folios.resize (nombreClients);
+  vector<int32_t> comptesParRang = move (m_comptesParClient);
+  m_comptesParClient.resize (nombreClients);
+  for (size_t i = 0; i < nombreClients; ++i)
+    {
+      m_folios[i] = folios[ordre[i]];
+      m_comptesParClient[i] = comptesParRang[ordre[i]];
+    }
+}
+
+
+/**
+ * \brief Produit l'enregistrement de création d'un client valide
+ */
+EnregistrementJournal GenerateurCharge::genererClient(int p_noFolio)
+{
+  EnregistrementJournal client;
+  client.type = TypeOperation::AjoutClient;
+  client.noFolio = p_noFolio;
+  client.noCompte = 0;
+  client.nombreTransactions = 0;
+  client.solde = 0;
+  client.tauxInteret = 0;
+  client.tauxInteretMinimum = 0;
+
+  client.prenom = PRENOMS[tirerEntier (taille (PRENOMS))];
+  if (tirerEntier (10) == 0)
+    {
+      client.prenom += string ("-") + PRENOMS[tirerEntier (taille (PRENOMS))];
+    }
+  client.nom = NOMS[tirerEntier (taille (NOMS))];
+
+  client.telephone = INDICATIFS[tirerEntier (taille (INDICATIFS))];
+  client.telephone += ' ';
+  client.telephone += static_cast<char> ('2' + tirerEntier (8));
+  for (int chiffre = 0; chiffre < 6; ++chiffre)
+    {
+      if (chiffre == 2)
+        {
+          client.telephone += '-';
+        }
+      client.telephone += static_cast<char> ('0' + tirerEntier (10));
+    }
+
+  do
+    {
+      client.annee = 1930 + static_cast<int> (tirerEntier (76));
+      client.mois = 1 + static_cast<int> (tirerEntier (12));
+      client.jour = 1 + static_cast<int> (tirerEntier (31));
+    }
+  while (!util::Date::validerDate (client.jour, client.mois, client.annee));
+  return client;
+}
+
+
+/**
+ * \brief Produit l'enregistrement d'ouverture d'un compte valide et le retient
+ *        parmi les comptes actifs
+ */
+EnregistrementJournal GenerateurCharge::genererCompte(int p_noFolio, int p_noCompte)
+{
+  EnregistrementJournal compte;
+  compte.noFolio = p_noFolio;
+  compte.noCompte = p_noCompte;
+  compte.jour = 0;
+  compte.mois = 0;
+  compte.annee = 0;
+
+  const bool estCheque = tirerReel () < m_parametres.proportionCheques;
+  const double echelle = tirerReel ();
+  if (estCheque)
+    {
+      const float tauxMinimum = TAUX_MINIMUMS_CHEQUE[tirerEntier (taille (TAUX_MINIMUMS_CHEQUE))];
+      compte.type = TypeOperation::AjoutCheque;
+      compte.nombreTransactions = static_cast<int> (tirerEntier (41));
+      compte.tauxInteretMinimum = tauxMinimum;
+      compte.tauxInteret = tauxMinimum + static_cast<double> (tirerEntier (81)) / 10.0;
+      compte.solde = arrondirCents (echelle * echelle * 20000 - 500);
+      compte.description = DESCRIPTIONS_CHEQUE[tirerEntier (taille (DESCRIPTIONS_CHEQUE))];
+      m_comptes.push_back (CompteCharge {compte.solde, p_noFolio, p_noCompte, tauxMinimum, true});
+    }
+  else
+    {
+      compte.type = TypeOperation::AjoutEpargne;
+      compte.nombreTransactions = 0;
+      compte.tauxInteretMinimum = 0;
+      compte.tauxInteret = static_cast<double> (1 + tirerEntier (35)) / 10.0;
+      compte.solde = arrondirCents (echelle * echelle * 50000);
+      compte.description = DESCRIPTIONS_EPARGNE[tirerEntier (taille (DESCRIPTIONS_EPARGNE))];
+      m_comptes.push_back (CompteCharge {compte.solde, p_noFolio, p_noCompte, 0.0f, false});
+    }
+  return compte;
+}
+
+} //namespace bancaire
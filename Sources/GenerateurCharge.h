@@ -0,0 +1,106 @@
+/**
+ * \file GenerateurCharge.h
+ * \brief Fichier qui contient l'interface de la classe GenerateurCharge.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef GENERATEURCHARGE_H
+#define GENERATEURCHARGE_H
+
+#include "Banque.h"
+#include "Journal.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \brief Échelles de référence des bancs d'essai et des tests de charge
+ */
+const std::size_t ECHELLE_PETITE = 10000;
+const std::size_t ECHELLE_MOYENNE = 1000000;
+const std::size_t ECHELLE_GRANDE = 10000000;
+
+/**
+ * \struct ParametresCharge
+ * \brief Réglages d'une charge synthétique ; la même graine donne toujours la même charge.
+ *
+ * Les proportions d'opérations non attribuées aux dépôts, retraits et
+ * changements de taux vont aux suppressions de comptes.
+ */
+struct ParametresCharge
+{
+  std::uint64_t graine = 1;
+  std::size_t nombreComptes = ECHELLE_PETITE;
+  double exposantZipf = 1.1;
+  double proportionCheques = 0.5;
+  double proportionDepots = 0.4;
+  double proportionRetraits = 0.3;
+  double proportionTaux = 0.2;
+};
+
+/**
+ * \class GenerateurCharge
+ * \brief Produit une population de clients et un flot d'opérations reproductibles.
+ *
+ * La population est décrite par des enregistrements du journal (AjoutClient,
+ * AjoutCheque, AjoutEpargne) et les opérations par des mutations (AsgSolde
+ * pour les dépôts et retraits, AsgTauxInteret, SuppressionCompte), que l'on
+ * peut appliquer à une Banque, journaliser ou encoder. Toutes les données
+ * respectent les contrats de Client, Cheque et Epargne.
+ *
+ * Les folios étant limités à [1000, 9999], au plus 9000 clients se partagent
+ * les comptes ; le nombre de comptes d'un client suit une loi de Zipf sur son
+ * rang, chaque client en ayant au moins un. Le générateur pseudo-aléatoire et
+ * les tirages sont implantés ici pour que la charge ne dépende pas de la
+ * bibliothèque standard utilisée.
+ */
+class GenerateurCharge
+{
+public:
+  typedef std::function<void(const EnregistrementJournal&)> Consommateur;
+
+  explicit GenerateurCharge(const ParametresCharge& p_parametres);
+
+  //accesseurs
+  const ParametresCharge& reqParametres() const;
+  std::size_t reqNombreClients() const;
+  std::size_t reqNombreComptesActifs() const;
+
+  //methodes
+  void genererPopulation(const Consommateur& p_consommateur);
+  std::size_t genererOperations(std::size_t p_nombre, const Consommateur& p_consommateur);
+  Banque construireBanque();
+
+private:
+  /**
+   * \brief Compte vivant de la population, pour choisir la cible des opérations
+   */
+  struct CompteCharge
+  {
+    double solde;
+    std::int32_t noFolio;
+    std::int32_t noCompte;
+    float tauxInteretMinimum;
+    bool estCheque;
+  };
+
+  std::uint64_t tirer();
+  double tirerReel();
+  std::uint64_t tirerEntier(std::uint64_t p_borne);
+  void repartirComptes();
+  EnregistrementJournal genererClient(int p_noFolio);
+  EnregistrementJournal genererCompte(int p_noFolio, int p_noCompte);
+
+  ParametresCharge m_parametres;
+  std::uint64_t m_etat;
+  std::vector<std::int32_t> m_folios;
+  std::vector<std::int32_t> m_comptesParClient;
+  std::vector<CompteCharge> m_comptes;
+  bool m_populationGeneree;
+};
+} //namespace bancaire
+
+#endif /* GENERATEURCHARGE_H */
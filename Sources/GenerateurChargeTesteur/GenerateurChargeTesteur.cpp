@@ -0,0 +1,163 @@
+/**
+ * \file GenerateurChargeTesteur.cpp
+ * \brief Test unitaire de la classe GenerateurCharge.
+ *
+ * À tester :
+ *         GenerateurCharge(const ParametresCharge& p_parametres);
+ *         void genererPopulation(const Consommateur& p_consommateur);
+ *         std::size_t genererOperations(std::size_t p_nombre, const Consommateur& p_consommateur);
+ *         Banque construireBanque();
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "GenerateurCharge.h"
+#include "ContratException.h"
+#include "Journal.h"
+#include <algorithm>
+#include <map>
+#include <string>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+/**
+ * \brief Encode la population puis p_nombreOperations opérations d'un générateur
+ */
+string
+encoderCharge (const ParametresCharge& p_parametres, size_t p_nombreOperations)
+{
+  GenerateurCharge generateur(p_parametres);
+  string charge;
+  auto encoder = [&] (const EnregistrementJournal& p_enregistrement)
+  {
+    encoderEnregistrement (p_enregistrement, charge);
+  };
+  generateur.genererPopulation (encoder);
+  generateur.genererOperations (p_nombreOperations, encoder);
+  return charge;
+}
+
+
+ParametresCharge
+parametres (uint64_t p_graine, size_t p_nombreComptes)
+{
+  ParametresCharge parametres;
+  parametres.graine = p_graine;
+  parametres.nombreComptes = p_nombreComptes;
+  return parametres;
+}
+} //namespace
+
+
+/**
+ * \brief Test du constructeur
+ *     Cas valide : les comptes sont répartis entre des clients, au moins un chacun.
+ *     Cas invalides : aucun compte, proportions d'opérations supérieures à 1.
+ */
+TEST(GenerateurCharge, constructeur_ParametresValides_ClientsRepartis)
+{
+  GenerateurCharge generateur(parametres (7, ECHELLE_PETITE));
+  ASSERT_GT(generateur.reqNombreClients (), 0u);
+  ASSERT_LE(generateur.reqNombreClients (), 9000u);
+  ASSERT_EQ(0u, generateur.reqNombreComptesActifs ());
+}
+
+TEST(GenerateurCharge, constructeur_ParametresInvalides_PreconditionException)
+{
+  ASSERT_THROW(GenerateurCharge(parametres (7, 0)), PreconditionException);
+  ParametresCharge proportions = parametres (7, 100);
+  proportions.proportionTaux = 0.5;
+  ASSERT_THROW(GenerateurCharge generateur(proportions), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la reproductibilité
+ *     Cas valides : la même graine donne les mêmes enregistrements, octet pour octet ;
+ *                   une autre graine donne une autre charge.
+ *     Cas invalide : aucun
+ */
+TEST(GenerateurCharge, genererPopulation_MemeGraine_ChargeIdentique)
+{
+  ASSERT_EQ(encoderCharge (parametres (42, 2000), 5000), encoderCharge (parametres (42, 2000), 5000));
+  ASSERT_NE(encoderCharge (parametres (42, 2000), 5000), encoderCharge (parametres (43, 2000), 5000));
+}
+
+
+/**
+ * \brief Test de la méthode void genererPopulation(const Consommateur& p_consommateur);
+ *     Cas valides : le nombre de comptes demandé est produit, et la répartition
+ *                   est fortement asymétrique (loi de Zipf).
+ *     Cas invalide : aucun
+ */
+TEST(GenerateurCharge, genererPopulation_Zipf_ComptesRepartisAsymetriquement)
+{
+  GenerateurCharge generateur(parametres (3, ECHELLE_PETITE));
+  map<int, size_t> comptesParClient;
+  size_t nombreClients = 0;
+  generateur.genererPopulation ([&] (const EnregistrementJournal& p_enregistrement)
+  {
+    if (p_enregistrement.type == TypeOperation::AjoutClient)
+      {
+        ++nombreClients;
+      }
+    else
+      {
+        ++comptesParClient[p_enregistrement.noFolio];
+      }
+  });
+
+  ASSERT_EQ(generateur.reqNombreClients (), nombreClients);
+  ASSERT_EQ(nombreClients, comptesParClient.size ());
+  ASSERT_EQ(ECHELLE_PETITE, generateur.reqNombreComptesActifs ());
+  size_t maximum = 0;
+  size_t total = 0;
+  for (const auto& client : comptesParClient)
+    {
+      maximum = max (maximum, client.second);
+      total += client.second;
+    }
+  ASSERT_EQ(ECHELLE_PETITE, total);
+  ASSERT_GT(maximum, 50 * total / nombreClients);
+}
+
+
+/**
+ * \brief Test de la méthode Banque construireBanque();
+ *     Cas valide : la banque construite en bloc est identique à la rejouée
+ *                  enregistrement par enregistrement, et accepte toutes les
+ *                  opérations générées sans violer de contrat.
+ *     Cas invalide : aucun
+ */
+TEST(GenerateurCharge, construireBanque_OperationsAppliquees_ContratsRespectes)
+{
+  GenerateurCharge generateur(parametres (11, 3000));
+  Banque banque = generateur.construireBanque ();
+
+  Banque rejouee;
+  generateur.genererPopulation ([&] (const EnregistrementJournal& p_enregistrement)
+  {
+    rejouee.appliquer (p_enregistrement);
+  });
+  ASSERT_EQ(rejouee.reqNombreClients (), banque.reqNombreClients ());
+  for (const auto& client : rejouee.reqClients ())
+    {
+      ASSERT_EQ(client.second.reqReleves (), banque.reqClient (client.first).reqReleves ());
+    }
+
+  size_t produites = generateur.genererOperations (20000, [&] (const EnregistrementJournal& p_operation)
+  {
+    banque.appliquer (p_operation);
+  });
+  ASSERT_EQ(20000u, produites);
+  size_t comptes = 0;
+  for (const auto& client : banque.reqClients ())
+    {
+      comptes += client.second.reqComptes ();
+    }
+  ASSERT_EQ(generateur.reqNombreComptesActifs (), comptes);
+  ASSERT_LT(comptes, 3000u);
+}
@@ -0,0 +1,210 @@
+/**
+ * \file GroupeValidation.cpp
+ * \brief Implantation de la classe GroupeValidation
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "GroupeValidation.h"
+#include "ContratException.h"
+#include <cerrno>
+#include <memory>
+#include <fcntl.h>
+#include <system_error>
+#include <unistd.h>
+
+using namespace std;
+
+namespace bancaire
+{
+/**
+ * \brief Constructeur de la classe GroupeValidation
+ *        Ouvre le journal, se positionne à sa fin et démarre le fil des lots.
+ * \param[in] p_cheminJournal chemin du fichier journal, créé au besoin
+ * \param[in] p_tailleLotMax nombre maximal d'enregistrements par lot
+ * \param[in] p_latenceMax délai maximal avant la synchronisation d'un lot
+ * \pre p_tailleLotMax doit être supérieur à zéro
+ * \pre p_latenceMax ne doit pas être négative
+ * \exception std::system_error si le journal ne peut pas être ouvert
+ */
+GroupeValidation::GroupeValidation(const std::string& p_cheminJournal, std::size_t p_tailleLotMax,
+                                   std::chrono::microseconds p_latenceMax):
+        m_descripteur(-1), m_position(0), m_tailleLotMax(p_tailleLotMax), m_latenceMax(p_latenceMax),
+        m_arret(false), m_nombreLots(0), m_nombreEnregistrements(0)
+{
+  PRECONDITION(p_tailleLotMax>0);
+  PRECONDITION(p_latenceMax.count()>=0);
+
+  m_descripteur = ::open (p_cheminJournal.c_str (), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+  if (m_descripteur < 0)
+    {
+      throw system_error(errno, generic_category (), "Ouverture du journal " + p_cheminJournal);
+    }
+  off_t fin = ::lseek (m_descripteur, 0, SEEK_END);
+  if (fin < 0)
+    {
+      int erreur = errno;
+      ::close (m_descripteur);
+      throw system_error(erreur, generic_category (), "Positionnement du journal " + p_cheminJournal);
+    }
+  m_position = static_cast<uint64_t> (fin);
+  m_filLots = thread(&GroupeValidation::boucleLots, this);
+
+  POSTCONDITION(m_descripteur>=0);
+}
+
+
+/**
+ * \brief Destructeur de la classe GroupeValidation
+ *        Les enregistrements en attente sont écrits et acquittés avant la fermeture.
+ */
+GroupeValidation::~GroupeValidation()
+{
+  {
+    lock_guard<mutex> verrou(m_mutex);
+    m_arret = true;
+  }
+  m_conditionLot.notify_one ();
+  m_filLots.join ();
+  m_ecrivain.attendre ();
+  ::close (m_descripteur);
+}
+
+
+/**
+ * \brief Retourne le nombre maximal d'enregistrements par lot
+ * \return un size_t qui représente la taille maximale d'un lot
+ */
+std::size_t GroupeValidation::reqTailleLotMax() const
+{
+  return m_tailleLotMax;
+}
+
+
+/**
+ * \brief Retourne le délai maximal d'attente d'un enregistrement avant synchronisation
+ * \return la latence maximale en microsecondes
+ */
+std::chrono::microseconds GroupeValidation::reqLatenceMax() const
+{
+  return m_latenceMax;
+}
+
+
+/**
+ * \brief Retourne le nombre de lots synchronisés depuis la création
+ * \return un entier qui représente le nombre de fdatasync effectués
+ */
+std::uint64_t GroupeValidation::reqNombreLots() const
+{
+  return m_nombreLots.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne le nombre d'enregistrements acquittés depuis la création
+ * \return un entier qui représente le nombre d'enregistrements durables
+ */
+std::uint64_t GroupeValidation::reqNombreEnregistrements() const
+{
+  return m_nombreEnregistrements.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Soumet un enregistrement au prochain lot sans attendre sa durabilité
+ * \param[in] p_enregistrement l'enregistrement à rendre durable
+ * \return un futur satisfait lorsque le lot contenant l'enregistrement est
+ *         synchronisé sur disque, ou portant l'erreur d'écriture le cas échéant
+ */
+std::future<void> GroupeValidation::soumettre(const EnregistrementJournal& p_enregistrement)
+{
+  string encode;
+  encoderEnregistrement (p_enregistrement, encode);
+
+  promise<void> attente;
+  future<void> resultat = attente.get_future ();
+  bool lotPlein = false;
+  {
+    lock_guard<mutex> verrou(m_mutex);
+    if (m_attentes.empty ())
+      {
+        m_debutLot = chrono::steady_clock::now ();
+      }
+    m_tampon.append (encode);
+    m_attentes.push_back (move (attente));
+    lotPlein = m_attentes.size () == 1 || m_attentes.size () >= m_tailleLotMax;
+  }
+  if (lotPlein)
+    {
+      m_conditionLot.notify_one ();
+    }
+  return resultat;
+}
+
+
+/**
+ * \brief Soumet un enregistrement et attend qu'il soit durable
+ * \param[in] p_enregistrement l'enregistrement à rendre durable
+ * \exception std::system_error si l'écriture ou la synchronisation du lot échoue
+ */
+void GroupeValidation::valider(const EnregistrementJournal& p_enregistrement)
+{
+  soumettre (p_enregistrement).get ();
+}
+
+
+/**
+ * \brief Boucle du fil des lots : ferme les lots et les confie à l'écrivain
+ *        Chaque lot devient une écriture suivie d'une synchronisation dont le
+ *        rappel acquitte tous les enregistrements du lot.
+ */
+void GroupeValidation::boucleLots()
+{
+  unique_lock<mutex> verrou(m_mutex);
+  for (;;)
+    {
+      m_conditionLot.wait (verrou, [this] { return m_arret || !m_attentes.empty (); });
+      if (m_attentes.empty ())
+        {
+          return; // arrêt demandé et plus rien à écrire
+        }
+      m_conditionLot.wait_until (verrou, m_debutLot + m_latenceMax, [this]
+        {
+          return m_arret || m_attentes.size () >= m_tailleLotMax;
+        });
+
+      string lot;
+      lot.swap (m_tampon);
+      auto attentes = make_shared<vector<promise<void>>> (move (m_attentes));
+      m_attentes.clear ();
+      verrou.unlock ();
+
+      const uint64_t position = m_position;
+      m_position += lot.size ();
+      m_ecrivain.ecrire (m_descripteur, position, move (lot));
+      m_ecrivain.synchroniser (m_descripteur, [this, attentes] (int p_erreur)
+        {
+          if (p_erreur == 0)
+            {
+              m_nombreLots.fetch_add (1, memory_order_relaxed);
+              m_nombreEnregistrements.fetch_add (attentes->size (), memory_order_relaxed);
+              for (auto& attente : *attentes)
+                {
+                  attente.set_value ();
+                }
+            }
+          else
+            {
+              exception_ptr erreur = make_exception_ptr (
+                      system_error(p_erreur, generic_category (), "Ecriture du journal"));
+              for (auto& attente : *attentes)
+                {
+                  attente.set_exception (erreur);
+                }
+            }
+        });
+      verrou.lock ();
+    }
+}
+
+} //namespace bancaire
@@ -0,0 +1,77 @@
+/**
+ * \file GroupeValidation.h
+ * \brief Fichier qui contient l'interface de la classe GroupeValidation.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef GROUPEVALIDATION_H
+#define GROUPEVALIDATION_H
+
+#include "EcrivainAsynchrone.h"
+#include "Journal.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \class GroupeValidation
+ * \brief Rend durables les enregistrements du journal par lots (« group commit »).
+ *
+ * Les appelants concurrents soumettent leurs enregistrements, qui sont
+ * accumulés dans un tampon commun. Un fil dédié ferme les lots et les confie
+ * à un EcrivainAsynchrone, qui écrit chaque lot et le synchronise sur disque
+ * par un seul fdatasync, puis acquitte tous les enregistrements du lot.
+ * Un lot est fermé dès qu'il atteint la taille maximale ou que son plus
+ * ancien enregistrement a attendu la latence maximale ; le lot suivant
+ * s'accumule pendant que le précédent est sur le disque.
+ */
+class GroupeValidation
+{
+public:
+  GroupeValidation(const std::string& p_cheminJournal, std::size_t p_tailleLotMax=256,
+                   std::chrono::microseconds p_latenceMax=std::chrono::microseconds(2000));
+  ~GroupeValidation();
+  GroupeValidation(const GroupeValidation&)=delete;
+  GroupeValidation& operator=(const GroupeValidation&)=delete;
+
+  //accesseurs
+  std::size_t reqTailleLotMax() const;
+  std::chrono::microseconds reqLatenceMax() const;
+  std::uint64_t reqNombreLots() const;
+  std::uint64_t reqNombreEnregistrements() const;
+
+  //methodes
+  std::future<void> soumettre(const EnregistrementJournal& p_enregistrement);
+  void valider(const EnregistrementJournal& p_enregistrement);
+
+private:
+  void boucleLots();
+
+  int m_descripteur;
+  std::uint64_t m_position;
+  const std::size_t m_tailleLotMax;
+  const std::chrono::microseconds m_latenceMax;
+
+  std::mutex m_mutex;
+  std::condition_variable m_conditionLot;
+  std::string m_tampon;
+  std::vector<std::promise<void>> m_attentes;
+  std::chrono::steady_clock::time_point m_debutLot;
+  bool m_arret;
+
+  std::atomic<std::uint64_t> m_nombreLots;
+  std::atomic<std::uint64_t> m_nombreEnregistrements;
+  EcrivainAsynchrone m_ecrivain;
+  std::thread m_filLots;
+};
+} //namespace bancaire
+
+#endif /* GROUPEVALIDATION_H */
@@ -0,0 +1,173 @@
+/**
+ * \file GroupeValidationTesteur.cpp
+ * \brief Test unitaire de la classe GroupeValidation et de l'encodage du journal.
+ *
+ * À tester :
+ *         void encoderEnregistrement(const EnregistrementJournal& p_enregistrement, std::string& p_tampon);
+ *         std::size_t decoderEnregistrement(const char* p_donnees, std::size_t p_taille,
+ *                                           EnregistrementJournal& p_enregistrement);
+ *         GroupeValidation(const std::string& p_cheminJournal, std::size_t p_tailleLotMax,
+ *                          std::chrono::microseconds p_latenceMax);
+ *         std::future<void> soumettre(const EnregistrementJournal& p_enregistrement);
+ *         void valider(const EnregistrementJournal& p_enregistrement);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "GroupeValidation.h"
+#include "Journal.h"
+#include "ContratException.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+string
+cheminTemporaire ()
+{
+  return "/tmp/GroupeValidationTesteur_" + to_string (::getpid ()) + ".journal";
+}
+
+
+string
+lireFichier (const string& p_chemin)
+{
+  ifstream fichier(p_chemin, ios::binary);
+  ostringstream os;
+  os << fichier.rdbuf ();
+  return os.str ();
+}
+
+
+size_t
+compterEnregistrements (const string& p_donnees)
+{
+  size_t nombre = 0;
+  size_t position = 0;
+  EnregistrementJournal enregistrement;
+  while (size_t lu = decoderEnregistrement (p_donnees.data () + position,
+                                            p_donnees.size () - position, enregistrement))
+    {
+      position += lu;
+      ++nombre;
+    }
+  return nombre;
+}
+} //namespace
+
+
+/**
+ * \brief Test de l'encodage et du décodage d'un enregistrement
+ *     Cas valides : un enregistrement décodé est identique à l'original.
+ *     Cas invalides : un enregistrement tronqué ou altéré n'est pas décodé.
+ */
+TEST(JournalTest, encoderDecoder_EnregistrementValide_Identique)
+{
+  EnregistrementJournal original;
+  original.type = TypeOperation::AjoutCheque;
+  original.noFolio = 1000;
+  original.noCompte = 1280;
+  original.nombreTransactions = 25;
+  original.solde = -250.5;
+  original.tauxInteret = 7.25;
+  original.tauxInteretMinimum = 2.5;
+  original.description = "Loyer";
+
+  string tampon;
+  encoderEnregistrement (original, tampon);
+  EnregistrementJournal decode;
+  ASSERT_EQ(tampon.size (), decoderEnregistrement (tampon.data (), tampon.size (), decode));
+  ASSERT_EQ(TypeOperation::AjoutCheque, decode.type);
+  ASSERT_EQ(1000, decode.noFolio);
+  ASSERT_EQ(1280, decode.noCompte);
+  ASSERT_EQ(25, decode.nombreTransactions);
+  ASSERT_EQ(-250.5, decode.solde);
+  ASSERT_EQ(7.25, decode.tauxInteret);
+  ASSERT_EQ(2.5, decode.tauxInteretMinimum);
+  ASSERT_EQ("Loyer", decode.description);
+}
+
+TEST(JournalTest, decoder_EnregistrementTronqueOuAltere_Rejete)
+{
+  EnregistrementJournal original;
+  original.nom = "Perez";
+  string tampon;
+  encoderEnregistrement (original, tampon);
+
+  EnregistrementJournal decode;
+  ASSERT_EQ(0u, decoderEnregistrement (tampon.data (), tampon.size () - 1, decode));
+  tampon[tampon.size () / 2] ^= 0x5A;
+  ASSERT_EQ(0u, decoderEnregistrement (tampon.data (), tampon.size (), decode));
+}
+
+
+/**
+ * \brief Test du constructeur
+ *     Cas valides : les paramètres de lot sont conservés.
+ *     Cas invalides : une taille de lot nulle est refusée.
+ */
+TEST(GroupeValidationTest, constructeur_ParametresValides_ObjetValide)
+{
+  string chemin = cheminTemporaire ();
+  {
+    GroupeValidation groupe(chemin, 64, chrono::microseconds(500));
+    ASSERT_EQ(64u, groupe.reqTailleLotMax ());
+    ASSERT_EQ(chrono::microseconds(500), groupe.reqLatenceMax ());
+    ASSERT_EQ(0u, groupe.reqNombreLots ());
+  }
+  remove (chemin.c_str ());
+}
+
+TEST(GroupeValidationTest, constructeur_TailleLotNulle_PreconditionException)
+{
+  ASSERT_THROW(GroupeValidation groupe(cheminTemporaire (), 0), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la méthode void valider(const EnregistrementJournal& p_enregistrement);
+ *     Cas valides : les enregistrements de plusieurs fils sont tous écrits,
+ *                   avec moins de synchronisations que d'enregistrements.
+ */
+TEST(GroupeValidationTest, valider_AppelantsConcurrents_EnregistrementsGroupes)
+{
+  const int nombreFils = 8;
+  const int parFil = 50;
+  string chemin = cheminTemporaire ();
+  remove (chemin.c_str ());
+  uint64_t nombreLots = 0;
+  {
+    GroupeValidation groupe(chemin, 32, chrono::microseconds(1000));
+    vector<thread> fils;
+    for (int f = 0; f < nombreFils; ++f)
+      {
+        fils.emplace_back ([&groupe, f]
+          {
+            EnregistrementJournal enregistrement;
+            enregistrement.type = TypeOperation::AsgSolde;
+            enregistrement.noFolio = 1000 + f;
+            for (int i = 0; i < parFil; ++i)
+              {
+                enregistrement.solde = i;
+                groupe.valider (enregistrement);
+              }
+          });
+      }
+    for (auto& unFil : fils)
+      {
+        unFil.join ();
+      }
+    ASSERT_EQ(static_cast<uint64_t> (nombreFils * parFil), groupe.reqNombreEnregistrements ());
+    nombreLots = groupe.reqNombreLots ();
+  }
+  ASSERT_LT(nombreLots, static_cast<uint64_t> (nombreFils * parFil));
+  ASSERT_EQ(static_cast<size_t> (nombreFils * parFil), compterEnregistrements (lireFichier (chemin)));
+  remove (chemin.c_str ());
+}
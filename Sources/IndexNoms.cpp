@@ -0,0 +1,207 @@
+/**
+ * \file IndexNoms.cpp
+ * \brief Implantation de la classe IndexNoms
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "IndexNoms.h"
+#include "ContratException.h"
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Sépare le nom du prénom dans une clé ; il précède tous les caractères
+ *        d'un nom normalisé, si bien que « dupont » + séparateur se range
+ *        avant « dupontel ».
+ */
+const char SEPARATEUR = '\x1f';
+
+/**
+ * \brief Lettres de base des caractères U+00C0 à U+00FF, codés en UTF-8 par
+ *        0xC3 suivi de 0x80 à 0xBF ; une chaîne vide retire le caractère.
+ */
+const char* const LATIN1[64] = {
+  "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+  "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "ss",
+  "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+  "d", "n", "o", "o", "o", "o", "o", "", "o", "u", "u", "u", "u", "y", "th", "y"
+};
+
+
+bool
+commencePar (string_view p_texte, string_view p_prefixe)
+{
+  return p_texte.size () >= p_prefixe.size () && p_texte.compare (0, p_prefixe.size (), p_prefixe) == 0;
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe IndexNoms
+ *        On construit un index vide.
+ */
+IndexNoms::IndexNoms() { }
+
+
+/**
+ * \brief Retourne le nombre de clients indexés
+ * \return un size_t qui représente le nombre d'entrées
+ */
+std::size_t IndexNoms::reqNombreEntrees() const
+{
+  return m_entrees.reqNombreEntrees ();
+}
+
+
+/**
+ * \brief Normalise un nom pour la recherche
+ *        Minuscules, lettres accentuées du Latin-1 et œ ramenées à leurs
+ *        lettres de base, tirets et suites d'espaces ramenés à une espace,
+ *        sans espace au début ni à la fin.
+ * \param[in] p_nom le nom, en UTF-8
+ * \return le nom normalisé
+ */
+std::string IndexNoms::normaliser(std::string_view p_nom)
+{
+  string resultat;
+  resultat.reserve (p_nom.size ());
+  bool espace = false;
+  for (size_t i = 0; i < p_nom.size (); ++i)
+    {
+      const unsigned char c = static_cast<unsigned char> (p_nom[i]);
+      const unsigned char suivant = i + 1 < p_nom.size () ? static_cast<unsigned char> (p_nom[i + 1]) : 0;
+      if (c == ' ' || c == '-')
+        {
+          espace = !resultat.empty ();
+          continue;
+        }
+      if (espace)
+        {
+          resultat.push_back (' ');
+          espace = false;
+        }
+      if (c == 0xC3 && suivant >= 0x80 && suivant <= 0xBF)
+        {
+          resultat.append (LATIN1[suivant - 0x80]);
+          ++i;
+        }
+      else if (c == 0xC5 && (suivant == 0x92 || suivant == 0x93))
+        {
+          resultat.append ("oe");
+          ++i;
+        }
+      else if (c >= 'A' && c <= 'Z')
+        {
+          resultat.push_back (static_cast<char> (c - 'A' + 'a'));
+        }
+      else
+        {
+          resultat.push_back (static_cast<char> (c));
+        }
+    }
+  return resultat;
+}
+
+
+/**
+ * \brief Ajoute un client à l'index
+ * \param[in] p_nom le nom du client
+ * \param[in] p_prenom le prénom du client
+ * \param[in] p_noFolio le folio du client
+ * \post l'index compte une entrée de plus
+ */
+void IndexNoms::ajouter(const std::string& p_nom, const std::string& p_prenom, int p_noFolio)
+{
+  [[maybe_unused]] const size_t avant = reqNombreEntrees ();
+  const string cle = normaliser (p_nom) + SEPARATEUR + normaliser (p_prenom);
+  Entree entree {static_cast<uint32_t> (m_caracteres.size ()), static_cast<uint32_t> (cle.size ()), p_noFolio};
+  m_caracteres.append (cle);
+
+  m_entrees.ajouter (entree, [this] (const Entree& p_gauche, const Entree& p_droite)
+  {
+    return precede (p_gauche, p_droite);
+  });
+
+  POSTCONDITION(reqNombreEntrees () == avant + 1);
+}
+
+
+/**
+ * \brief Retrouve les clients qui portent exactement un nom
+ * \param[in] p_nom le nom cherché, normalisé avant la recherche
+ * \param[in] p_prenom le prénom cherché ; vide pour accepter tous les prénoms
+ * \return les folios trouvés, par prénom puis par folio
+ */
+std::vector<int> IndexNoms::rechercherExact(std::string_view p_nom, std::string_view p_prenom) const
+{
+  if (p_prenom.empty ())
+    {
+      return rechercher (normaliser (p_nom) + SEPARATEUR, false, numeric_limits<size_t>::max ());
+    }
+  return rechercher (normaliser (p_nom) + SEPARATEUR + normaliser (p_prenom), true,
+                     numeric_limits<size_t>::max ());
+}
+
+
+/**
+ * \brief Retrouve les clients dont le nom commence par un préfixe
+ * \param[in] p_prefixeNom le début du nom, normalisé avant la recherche
+ * \param[in] p_maximum le nombre maximal de folios retournés
+ * \return les folios trouvés, par nom, prénom puis folio
+ */
+std::vector<int> IndexNoms::rechercherPrefixe(std::string_view p_prefixeNom, std::size_t p_maximum) const
+{
+  return rechercher (normaliser (p_prefixeNom), false, p_maximum);
+}
+
+
+std::string_view IndexNoms::reqCle(const Entree& p_entree) const
+{
+  return string_view(m_caracteres.data () + p_entree.debut, p_entree.longueur);
+}
+
+
+bool IndexNoms::precede(const Entree& p_gauche, const Entree& p_droite) const
+{
+  const int comparaison = reqCle (p_gauche).compare (reqCle (p_droite));
+  return comparaison < 0 || (comparaison == 0 && p_gauche.noFolio < p_droite.noFolio);
+}
+
+
+/**
+ * \brief Parcourt ensemble, dans l'ordre des clés, les entrées des deux
+ *        tableaux qui commencent par un préfixe (ou qui lui sont égales)
+ */
+std::vector<int> IndexNoms::rechercher(const std::string& p_prefixe, bool p_exact, std::size_t p_maximum) const
+{
+  auto avantPrefixe = [this, &p_prefixe] (const Entree& p_entree)
+  {
+    return reqCle (p_entree) < p_prefixe;
+  };
+  auto retenue = [this, &p_prefixe, p_exact] (const Entree& p_entree)
+  {
+    return p_exact ? reqCle (p_entree) == p_prefixe : commencePar (reqCle (p_entree), p_prefixe);
+  };
+  auto precedeCle = [this] (const Entree& p_gauche, const Entree& p_droite)
+  {
+    return precede (p_gauche, p_droite);
+  };
+
+  vector<int> folios;
+  if (p_maximum == 0)
+    {
+      return folios;
+    }
+  m_entrees.parcourir (avantPrefixe, retenue, precedeCle, [&folios, p_maximum] (const Entree& p_entree)
+  {
+    folios.push_back (p_entree.noFolio);
+    return folios.size () < p_maximum;
+  });
+  return folios;
+}
+
+} //namespace bancaire
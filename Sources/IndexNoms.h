@@ -0,0 +1,67 @@
+/**
+ * \file IndexNoms.h
+ * \brief Fichier qui contient l'interface de la classe IndexNoms.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef INDEXNOMS_H
+#define INDEXNOMS_H
+
+#include "TableauFusionne.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \class IndexNoms
+ * \brief Retrouve les folios des clients par leur nom, exact ou par préfixe.
+ *
+ * Les noms sont d'abord normalisés : minuscules, accents retirés (é → e,
+ * œ → oe), tirets et espaces ramenés à une seule espace. La clé d'un client
+ * est son nom normalisé suivi de son prénom normalisé.
+ *
+ * Les clés sont rangées dans un TableauFusionne d'entrées de 12 octets qui
+ * pointent dans un unique tampon de caractères. Les ajouts vont d'abord dans
+ * un petit tableau trié de clés récentes, fusionné dans le tableau principal
+ * lorsqu'il dépasse un multiple de la racine carrée de sa taille : un ajout
+ * coûte ainsi O(√n) en moyenne, et une recherche deux recherches dichotomiques.
+ */
+class IndexNoms
+{
+public:
+  IndexNoms();
+
+  //accesseurs
+  std::size_t reqNombreEntrees() const;
+
+  //methodes
+  void ajouter(const std::string& p_nom, const std::string& p_prenom, int p_noFolio);
+  std::vector<int> rechercherExact(std::string_view p_nom, std::string_view p_prenom = std::string_view()) const;
+  std::vector<int> rechercherPrefixe(std::string_view p_prefixeNom,
+                                     std::size_t p_maximum = std::numeric_limits<std::size_t>::max ()) const;
+  static std::string normaliser(std::string_view p_nom);
+
+private:
+  struct Entree
+  {
+    std::uint32_t debut;
+    std::uint32_t longueur;
+    std::int32_t noFolio;
+  };
+
+  std::string_view reqCle(const Entree& p_entree) const;
+  bool precede(const Entree& p_gauche, const Entree& p_droite) const;
+  std::vector<int> rechercher(const std::string& p_prefixe, bool p_exact, std::size_t p_maximum) const;
+
+  std::string m_caracteres;
+  TableauFusionne<Entree> m_entrees;
+};
+
+} //namespace bancaire
+
+#endif /* INDEXNOMS_H */
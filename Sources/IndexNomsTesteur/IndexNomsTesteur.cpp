@@ -0,0 +1,114 @@
+/**
+ * \file IndexNomsTesteur.cpp
+ * \brief Test unitaire de la classe IndexNoms.
+ *
+ * À tester :
+ *         static std::string normaliser(std::string_view p_nom);
+ *         void ajouter(const std::string& p_nom, const std::string& p_prenom, int p_noFolio);
+ *         std::vector<int> rechercherExact(std::string_view p_nom, std::string_view p_prenom) const;
+ *         std::vector<int> rechercherPrefixe(std::string_view p_prefixeNom, std::size_t p_maximum) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "IndexNoms.h"
+#include <string>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : quelques clients dont des homonymes et des noms accentués
+ */
+class IndexNomsTest : public ::testing::Test
+{
+public:
+  IndexNomsTest()
+  {
+    f_index.ajouter ("Tremblay", "Jean", 1003);
+    f_index.ajouter ("Côté", "Éloïse", 1001);
+    f_index.ajouter ("Tremblay", "Anne", 1002);
+    f_index.ajouter ("Tremblay-Roy", "Marc", 1004);
+    f_index.ajouter ("Trudel", "Luc", 1005);
+  }
+
+  IndexNoms f_index;
+};
+
+
+/**
+ * \brief Test de la méthode static std::string normaliser(std::string_view p_nom);
+ *     Cas valides : casse, accents, œ, tirets et espaces multiples sont normalisés.
+ *     Cas invalide : aucun
+ */
+TEST(IndexNoms, normaliser_NomsAccentues_LettresDeBase)
+{
+  ASSERT_EQ("cote", IndexNoms::normaliser ("Côté"));
+  ASSERT_EQ("eloise", IndexNoms::normaliser ("ÉLOÏSE"));
+  ASSERT_EQ("coeur", IndexNoms::normaliser ("Cœur"));
+  ASSERT_EQ("tremblay roy", IndexNoms::normaliser ("Tremblay-Roy"));
+  ASSERT_EQ("de la cruz", IndexNoms::normaliser ("  De   La Cruz "));
+  ASSERT_EQ("nunez", IndexNoms::normaliser ("Núñez"));
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<int> rechercherExact(std::string_view p_nom, std::string_view p_prenom) const;
+ *     Cas valides : les homonymes sont tous retrouvés, par prénom ; le prénom
+ *                   restreint la recherche ; les accents sont ignorés.
+ *     Cas invalide : un nom seulement préfixe d'un autre ne le retrouve pas.
+ */
+TEST_F(IndexNomsTest, rechercherExact_Homonymes_TousRetrouves)
+{
+  ASSERT_EQ((vector<int> {1002, 1003}), f_index.rechercherExact ("tremblay"));
+  ASSERT_EQ((vector<int> {1003}), f_index.rechercherExact ("TREMBLAY", "jean"));
+  ASSERT_EQ((vector<int> {1001}), f_index.rechercherExact ("cote", "eloise"));
+}
+
+TEST_F(IndexNomsTest, rechercherExact_PrefixeSeulement_AucunResultat)
+{
+  ASSERT_TRUE(f_index.rechercherExact ("Trem").empty ());
+  ASSERT_TRUE(f_index.rechercherExact ("Tremblay", "J").empty ());
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<int> rechercherPrefixe(std::string_view p_prefixeNom, std::size_t p_maximum) const;
+ *     Cas valides : tous les noms qui commencent par le préfixe, dans l'ordre
+ *                   des noms ; le nombre de résultats est borné par p_maximum.
+ *     Cas invalide : un préfixe absent ne retrouve rien.
+ */
+TEST_F(IndexNomsTest, rechercherPrefixe_PrefixeCommun_NomsDansLOrdre)
+{
+  ASSERT_EQ((vector<int> {1002, 1003, 1004, 1005}), f_index.rechercherPrefixe ("Tr"));
+  ASSERT_EQ((vector<int> {1002, 1003, 1004}), f_index.rechercherPrefixe ("tremb"));
+  ASSERT_EQ((vector<int> {1002, 1003}), f_index.rechercherPrefixe ("tr", 2));
+  ASSERT_TRUE(f_index.rechercherPrefixe ("Zola").empty ());
+}
+
+
+/**
+ * \brief Test de la méthode void ajouter(const std::string& p_nom, const std::string& p_prenom, int p_noFolio);
+ *     Cas valide : après de nombreux ajouts, qui forcent des fusions, chaque
+ *                  client est retrouvé et les résultats restent triés.
+ *     Cas invalide : aucun
+ */
+TEST(IndexNoms, ajouter_NombreuxClients_IndexCoherent)
+{
+  IndexNoms index;
+  const int nombre = 20000;
+  for (int i = 0; i < nombre; ++i)
+    {
+      const int cle = (i * 7919) % nombre;
+      index.ajouter ("Nom" + to_string (cle), "Prenom", cle);
+    }
+  ASSERT_EQ(static_cast<size_t> (nombre), index.reqNombreEntrees ());
+  for (int cle = 0; cle < nombre; cle += 997)
+    {
+      ASSERT_EQ((vector<int> {cle}), index.rechercherExact ("Nom" + to_string (cle)));
+    }
+  vector<int> folios = index.rechercherPrefixe ("nom19");
+  ASSERT_EQ(1111u, folios.size ());
+  ASSERT_EQ(19, folios[0]);
+  ASSERT_EQ(190, folios[1]);
+}
@@ -0,0 +1,100 @@
+/**
+ * \file IndexOrdonne.cpp
+ * \brief Implantation de la classe IndexOrdonne
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "IndexOrdonne.h"
+#include "ContratException.h"
+
+using namespace std;
+
+namespace bancaire
+{
+
+
+/**
+ * \brief Constructeur de la classe IndexOrdonne
+ *        On construit un index vide.
+ */
+IndexOrdonne::IndexOrdonne() { }
+
+
+/**
+ * \brief Retourne le nombre de clients indexés
+ * \return un size_t qui représente le nombre d'entrées
+ */
+std::size_t IndexOrdonne::reqNombreEntrees() const
+{
+  return m_entrees.reqNombreEntrees ();
+}
+
+
+/**
+ * \brief Ajoute un client à l'index
+ * \param[in] p_cle la clé sous laquelle ranger le client
+ * \param[in] p_noFolio le folio du client
+ * \post l'index compte une entrée de plus
+ */
+void IndexOrdonne::ajouter(std::int64_t p_cle, int p_noFolio)
+{
+  [[maybe_unused]] const size_t avant = reqNombreEntrees ();
+  m_entrees.ajouter (Entree {p_cle, p_noFolio}, precede);
+
+  POSTCONDITION(reqNombreEntrees () == avant + 1);
+}
+
+
+/**
+ * \brief Visite, par clé puis par folio croissants, les clients dont la clé
+ *        est dans un intervalle
+ * \param[in] p_cleMinimum la plus petite clé retenue
+ * \param[in] p_cleMaximum la plus grande clé retenue
+ * \param[in] p_visiteur la fonction appelée avec la clé et le folio de chaque client retenu
+ * \pre p_cleMinimum <= p_cleMaximum
+ */
+void IndexOrdonne::parcourir(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum,
+                             const std::function<void(std::int64_t, int)>& p_visiteur) const
+{
+  PRECONDITION(p_cleMinimum <= p_cleMaximum);
+
+  auto avantMinimum = [p_cleMinimum] (const Entree& p_entree)
+  {
+    return p_entree.cle < p_cleMinimum;
+  };
+  auto retenue = [p_cleMaximum] (const Entree& p_entree)
+  {
+    return p_entree.cle <= p_cleMaximum;
+  };
+  m_entrees.parcourir (avantMinimum, retenue, precede, [&p_visiteur] (const Entree& p_entree)
+  {
+    p_visiteur (p_entree.cle, p_entree.noFolio);
+    return true;
+  });
+}
+
+
+/**
+ * \brief Retrouve les clients dont la clé est dans un intervalle
+ * \param[in] p_cleMinimum la plus petite clé retenue
+ * \param[in] p_cleMaximum la plus grande clé retenue
+ * \return les folios trouvés, par clé puis par folio croissants
+ * \pre p_cleMinimum <= p_cleMaximum
+ */
+std::vector<int> IndexOrdonne::rechercherIntervalle(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum) const
+{
+  vector<int> folios;
+  parcourir (p_cleMinimum, p_cleMaximum, [&folios] (int64_t, int p_noFolio)
+  {
+    folios.push_back (p_noFolio);
+  });
+  return folios;
+}
+
+
+bool IndexOrdonne::precede(const Entree& p_gauche, const Entree& p_droite)
+{
+  return p_gauche.cle < p_droite.cle || (p_gauche.cle == p_droite.cle && p_gauche.noFolio < p_droite.noFolio);
+}
+
+} //namespace bancaire
@@ -0,0 +1,57 @@
+/**
+ * \file IndexOrdonne.h
+ * \brief Fichier qui contient l'interface de la classe IndexOrdonne.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef INDEXORDONNE_H
+#define INDEXORDONNE_H
+
+#include "TableauFusionne.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \class IndexOrdonne
+ * \brief Range des folios de clients par une clé entière et les parcourt par
+ *        intervalle de clés.
+ *
+ * Les entrées de 16 octets {clé, folio} sont rangées, par clé puis par folio,
+ * dans un TableauFusionne, comme les clés d'IndexNoms : les ajouts vont d'abord
+ * dans un petit tableau trié d'entrées récentes, fusionné par lots dans le
+ * tableau principal ; un parcours d'intervalle fait une recherche dichotomique
+ * dans chacun des deux tableaux puis les lit ensemble, séquentiellement.
+ */
+class IndexOrdonne
+{
+public:
+  IndexOrdonne();
+
+  //accesseurs
+  std::size_t reqNombreEntrees() const;
+
+  //methodes
+  void ajouter(std::int64_t p_cle, int p_noFolio);
+  void parcourir(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum,
+                 const std::function<void(std::int64_t, int)>& p_visiteur) const;
+  std::vector<int> rechercherIntervalle(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum) const;
+
+private:
+  struct Entree
+  {
+    std::int64_t cle;
+    std::int32_t noFolio;
+  };
+
+  static bool precede(const Entree& p_gauche, const Entree& p_droite);
+
+  TableauFusionne<Entree> m_entrees;
+};
+
+} //namespace bancaire
+
+#endif /* INDEXORDONNE_H */
@@ -0,0 +1,97 @@
+/**
+ * \file IndexOrdonneTesteur.cpp
+ * \brief Test unitaire de la classe IndexOrdonne.
+ *
+ * À tester :
+ *         void ajouter(std::int64_t p_cle, int p_noFolio);
+ *         void parcourir(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum,
+ *                        const std::function<void(std::int64_t, int)>& p_visiteur) const;
+ *         std::vector<int> rechercherIntervalle(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "IndexOrdonne.h"
+#include "ContratException.h"
+#include <utility>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : des clients rangés par date de naissance aaaammjj
+ */
+class IndexOrdonneTest : public ::testing::Test
+{
+public:
+  IndexOrdonneTest()
+  {
+    f_index.ajouter (19830120, 1003);
+    f_index.ajouter (19700505, 1001);
+    f_index.ajouter (19830120, 1002);
+    f_index.ajouter (19991231, 1004);
+  }
+
+  IndexOrdonne f_index;
+};
+
+
+/**
+ * \brief Test de la méthode std::vector<int> rechercherIntervalle(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum) const;
+ *     Cas valides : les bornes sont incluses ; les clés égales sont rangées par folio.
+ *     Cas invalide : un intervalle sans clé ne retrouve rien.
+ */
+TEST_F(IndexOrdonneTest, rechercherIntervalle_BornesIncluses_ParCleEtFolio)
+{
+  ASSERT_EQ((vector<int> {1001, 1002, 1003, 1004}), f_index.rechercherIntervalle (0, 99999999));
+  ASSERT_EQ((vector<int> {1002, 1003}), f_index.rechercherIntervalle (19830120, 19830120));
+  ASSERT_EQ((vector<int> {1001, 1002, 1003}), f_index.rechercherIntervalle (19700505, 19831231));
+  ASSERT_TRUE(f_index.rechercherIntervalle (19840101, 19981231).empty ());
+}
+
+
+/**
+ * \brief Test de la méthode void parcourir(std::int64_t p_cleMinimum, std::int64_t p_cleMaximum,
+ *                                         const std::function<void(std::int64_t, int)>& p_visiteur) const;
+ *     Cas valide : le visiteur reçoit la clé et le folio de chaque entrée retenue.
+ *     Cas invalide : un intervalle renversé est refusé.
+ */
+TEST_F(IndexOrdonneTest, parcourir_Intervalle_ClesEtFolios)
+{
+  vector<pair<int64_t, int>> visites;
+  f_index.parcourir (19800101, 20000101, [&visites] (int64_t p_cle, int p_noFolio)
+  {
+    visites.emplace_back (p_cle, p_noFolio);
+  });
+  ASSERT_EQ((vector<pair<int64_t, int>> {{19830120, 1002}, {19830120, 1003}, {19991231, 1004}}), visites);
+}
+
+TEST_F(IndexOrdonneTest, parcourir_IntervalleRenverse_PreconditionException)
+{
+  ASSERT_THROW(f_index.rechercherIntervalle (2, 1), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la méthode void ajouter(std::int64_t p_cle, int p_noFolio);
+ *     Cas valide : après de nombreux ajouts, qui forcent des fusions, un
+ *                  intervalle retrouve exactement ses clients, dans l'ordre.
+ *     Cas invalide : aucun
+ */
+TEST(IndexOrdonne, ajouter_NombreuxClients_IntervallesExacts)
+{
+  IndexOrdonne index;
+  const int nombre = 20000;
+  for (int i = 0; i < nombre; ++i)
+    {
+      const int cle = (i * 7919) % nombre;
+      index.ajouter (cle, cle);
+    }
+  ASSERT_EQ(static_cast<size_t> (nombre), index.reqNombreEntrees ());
+  vector<int> folios = index.rechercherIntervalle (5000, 5999);
+  ASSERT_EQ(1000u, folios.size ());
+  for (int i = 0; i < 1000; ++i)
+    {
+      ASSERT_EQ(5000 + i, folios[i]);
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * \file IndexTelephones.cpp
+ * \brief Implantation de la classe IndexTelephones
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "IndexTelephones.h"
+#include "ContratException.h"
+#include "validationFormat.h"
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Clé d'une case libre ; aucune clé normalisée, toujours inférieure à
+ *        10^10, ne peut la prendre
+ */
+const uint64_t CASE_LIBRE = numeric_limits<uint64_t>::max ();
+
+const size_t CAPACITE_INITIALE = 64;
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe IndexTelephones
+ *        On construit un index vide.
+ */
+IndexTelephones::IndexTelephones():
+        m_cases(CAPACITE_INITIALE, Case {CASE_LIBRE, 0}), m_nombreEntrees(0)
+{
+  INVARIANTS();
+}
+
+
+/**
+ * \brief Retourne le nombre de clients indexés
+ * \return un size_t qui représente le nombre d'entrées
+ */
+std::size_t IndexTelephones::reqNombreEntrees() const
+{
+  return m_nombreEntrees;
+}
+
+
+/**
+ * \brief Ajoute un client à l'index
+ * \param[in] p_telephone le téléphone du client, dans n'importe quelle
+ *            présentation acceptée par util::normaliserNumero
+ * \param[in] p_noFolio le folio du client
+ * \return true si le numéro a été indexé, false s'il ne se normalise pas
+ * \post l'index compte une entrée de plus si le numéro a été indexé
+ */
+bool IndexTelephones::ajouter(std::string_view p_telephone, int p_noFolio)
+{
+  uint64_t cle;
+  if (!util::normaliserNumero (p_telephone, cle))
+    {
+      return false;
+    }
+  [[maybe_unused]] const size_t avant = m_nombreEntrees;
+  if (2 * (m_nombreEntrees + 1) > m_cases.size ())
+    {
+      agrandir ();
+    }
+  placer (Case {cle, p_noFolio});
+  ++m_nombreEntrees;
+
+  POSTCONDITION(m_nombreEntrees == avant + 1);
+  INVARIANTS();
+  return true;
+}
+
+
+/**
+ * \brief Retrouve les clients qui ont un numéro de téléphone
+ * \param[in] p_telephone le numéro cherché, normalisé avant la recherche
+ * \return les folios trouvés, croissants ; aucun si le numéro ne se normalise pas
+ */
+std::vector<int> IndexTelephones::rechercher(std::string_view p_telephone) const
+{
+  uint64_t cle;
+  if (!util::normaliserNumero (p_telephone, cle))
+    {
+      return vector<int>();
+    }
+  return rechercher (cle);
+}
+
+
+/**
+ * \brief Retrouve les clients dont le numéro a une clé donnée
+ * \param[in] p_cle la clé produite par util::normaliserNumero
+ * \return les folios trouvés, croissants
+ */
+std::vector<int> IndexTelephones::rechercher(std::uint64_t p_cle) const
+{
+  vector<int> folios;
+  const size_t masque = m_cases.size () - 1;
+  for (size_t position = reqDepart (p_cle); m_cases[position].cle != CASE_LIBRE;
+       position = (position + 1) & masque)
+    {
+      if (m_cases[position].cle == p_cle)
+        {
+          folios.push_back (m_cases[position].noFolio);
+        }
+    }
+  sort (folios.begin (), folios.end ());
+  return folios;
+}
+
+
+/**
+ * \brief Retourne la case où commence le sondage d'une clé
+ *        Le produit par une constante de Fibonacci mélange les chiffres de la
+ *        clé dans ses bits de poids fort, que l'on retient.
+ */
+std::size_t IndexTelephones::reqDepart(std::uint64_t p_cle) const
+{
+  return static_cast<size_t> ((p_cle * 0x9E3779B97F4A7C15ULL) >> 32) & (m_cases.size () - 1);
+}
+
+
+/**
+ * \brief Range une entrée dans la première case libre de son sondage
+ */
+void IndexTelephones::placer(const Case& p_entree)
+{
+  const size_t masque = m_cases.size () - 1;
+  size_t position = reqDepart (p_entree.cle);
+  while (m_cases[position].cle != CASE_LIBRE)
+    {
+      position = (position + 1) & masque;
+    }
+  m_cases[position] = p_entree;
+}
+
+
+/**
+ * \brief Double la capacité de la table et y replace toutes les entrées
+ */
+void IndexTelephones::agrandir()
+{
+  vector<Case> anciennes(m_cases.size () * 2, Case {CASE_LIBRE, 0});
+  anciennes.swap (m_cases);
+  for (const Case& entree : anciennes)
+    {
+      if (entree.cle != CASE_LIBRE)
+        {
+          placer (entree);
+        }
+    }
+}
+
+
+/**
+ * \brief Vérifie que la capacité est une puissance de deux et que la table
+ *        reste au plus à moitié pleine
+ */
+void IndexTelephones::verifieInvariant() const
+{
+  INVARIANT((m_cases.size () & (m_cases.size () - 1)) == 0);
+  INVARIANT(2 * m_nombreEntrees <= m_cases.size ());
+}
+
+} //namespace bancaire
@@ -0,0 +1,59 @@
+/**
+ * \file IndexTelephones.h
+ * \brief Fichier qui contient l'interface de la classe IndexTelephones.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef INDEXTELEPHONES_H
+#define INDEXTELEPHONES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \class IndexTelephones
+ * \brief Retrouve les folios des clients par leur numéro de téléphone.
+ *
+ * Les numéros sont ramenés par util::normaliserNumero à une clé entière de
+ * dix chiffres ; un numéro qui ne se normalise pas n'est pas indexé. La table
+ * est à adressage ouvert et sondage linéaire : chaque case de 16 octets
+ * contient la clé et le folio, si bien qu'une recherche ne lit le plus
+ * souvent qu'une seule ligne de cache et ne suit aucun pointeur. Plusieurs
+ * clients peuvent partager un numéro.
+ */
+class IndexTelephones
+{
+public:
+  IndexTelephones();
+
+  //accesseurs
+  std::size_t reqNombreEntrees() const;
+
+  //methodes
+  bool ajouter(std::string_view p_telephone, int p_noFolio);
+  std::vector<int> rechercher(std::string_view p_telephone) const;
+  std::vector<int> rechercher(std::uint64_t p_cle) const;
+
+private:
+  struct Case
+  {
+    std::uint64_t cle;
+    std::int32_t noFolio;
+  };
+
+  std::size_t reqDepart(std::uint64_t p_cle) const;
+  void placer(const Case& p_entree);
+  void agrandir();
+  void verifieInvariant() const;
+
+  std::vector<Case> m_cases;
+  std::size_t m_nombreEntrees;
+};
+
+} //namespace bancaire
+
+#endif /* INDEXTELEPHONES_H */
@@ -0,0 +1,113 @@
+/**
+ * \file IndexTelephonesTesteur.cpp
+ * \brief Test unitaire de la classe IndexTelephones et de util::normaliserNumero.
+ *
+ * À tester :
+ *         bool util::normaliserNumero(std::string_view p_numero, std::uint64_t& p_cle);
+ *         bool ajouter(std::string_view p_telephone, int p_noFolio);
+ *         std::vector<int> rechercher(std::string_view p_telephone) const;
+ *         std::vector<int> rechercher(std::uint64_t p_cle) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "IndexTelephones.h"
+#include "validationFormat.h"
+#include <string>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : quelques clients dont deux partagent un numéro
+ */
+class IndexTelephonesTest : public ::testing::Test
+{
+public:
+  IndexTelephonesTest()
+  {
+    f_index.ajouter ("418 555-1234", 1001);
+    f_index.ajouter ("450 555-9876", 1002);
+    f_index.ajouter ("418 555-1234", 1003);
+  }
+
+  IndexTelephones f_index;
+};
+
+
+/**
+ * \brief Test de la fonction bool util::normaliserNumero(std::string_view p_numero, std::uint64_t& p_cle);
+ *     Cas valides : les présentations usuelles d'un même numéro donnent la même clé,
+ *                   avec ou sans indicatif +1, précédé ou non d'espaces.
+ *     Cas invalides : trop ou trop peu de chiffres, un indicatif autre que 1,
+ *                     onze chiffres sans « + », un « + » répété ou ailleurs qu'en
+ *                     tête, ou un caractère étranger sont refusés, sans toucher à la clé.
+ */
+TEST(IndexTelephones, normaliserNumero_PresentationsUsuelles_MemeCle)
+{
+  uint64_t cle = 0;
+  ASSERT_TRUE(util::normaliserNumero ("418 555-1234", cle));
+  ASSERT_EQ(4185551234u, cle);
+  for (const char* numero :{"(418) 555-1234", "418.555.1234", "4185551234", "+1 418 555 1234", "+1-418-555-1234",
+                              "  +1 (418) 555-1234"})
+    {
+      cle = 0;
+      ASSERT_TRUE(util::normaliserNumero (numero, cle));
+      ASSERT_EQ(4185551234u, cle);
+    }
+}
+
+TEST(IndexTelephones, normaliserNumero_NumeroInvalide_Refuse)
+{
+  uint64_t cle = 42;
+  for (const char* numero :{"", "555-1234", "2 418 555 1234", "418 555-12345", "418 555-123a", "418+555-1234",
+                              "1-418-555-1234", "14185551234", "++1 418 555 1234", "+ +1 418 555 1234",
+                              "(+1) 418 555 1234", "+2 418 555 1234", "+418 555 1234"})
+    {
+      ASSERT_FALSE(util::normaliserNumero (numero, cle));
+    }
+  ASSERT_EQ(42u, cle);
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<int> rechercher(std::string_view p_telephone) const;
+ *     Cas valides : tous les clients d'un numéro sont retrouvés, par folio
+ *                   croissant, quelle que soit la présentation du numéro.
+ *     Cas invalides : un numéro absent ou qui ne se normalise pas ne retrouve personne.
+ */
+TEST_F(IndexTelephonesTest, rechercher_NumeroPartage_TousLesFolios)
+{
+  ASSERT_EQ((vector<int> {1001, 1003}), f_index.rechercher ("(418) 555-1234"));
+  ASSERT_EQ((vector<int> {1002}), f_index.rechercher (uint64_t {4505559876}));
+  ASSERT_TRUE(f_index.rechercher ("418 555-1235").empty ());
+  ASSERT_TRUE(f_index.rechercher ("inconnu").empty ());
+}
+
+
+/**
+ * \brief Test de la méthode bool ajouter(std::string_view p_telephone, int p_noFolio);
+ *     Cas valide : après de nombreux ajouts, qui agrandissent la table, chaque
+ *                  client est retrouvé.
+ *     Cas invalide : un numéro qui ne se normalise pas n'est pas indexé.
+ */
+TEST(IndexTelephones, ajouter_NombreuxClients_TousRetrouves)
+{
+  IndexTelephones index;
+  const int nombre = 20000;
+  for (int i = 0; i < nombre; ++i)
+    {
+      ASSERT_TRUE(index.ajouter (to_string (5140000000LL + i * 7919LL), i));
+    }
+  ASSERT_EQ(static_cast<size_t> (nombre), index.reqNombreEntrees ());
+  for (int i = 0; i < nombre; i += 97)
+    {
+      ASSERT_EQ((vector<int> {i}), index.rechercher (uint64_t (5140000000LL + i * 7919LL)));
+    }
+}
+
+TEST_F(IndexTelephonesTest, ajouter_NumeroInvalide_NonIndexe)
+{
+  ASSERT_FALSE(f_index.ajouter ("poste 22", 1004));
+  ASSERT_EQ(3u, f_index.reqNombreEntrees ());
+}
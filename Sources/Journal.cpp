@@ -0,0 +1,380 @@
+/**
+ * \file Journal.cpp
+ * \brief Implantation de l'encodage des enregistrements du journal des transactions
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "Journal.h"
+#include "Cheque.h"
+#include "Client.h"
+#include "CompteException.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "validationFormat.h"
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+const size_t TAILLE_ENTETE = 2 * sizeof (uint32_t);
+
+
+template<typename T>
+void
+ecrireValeur (string& p_tampon, T p_valeur)
+{
+  p_tampon.append (reinterpret_cast<const char*> (&p_valeur), sizeof (T));
+}
+
+
+void
+ecrireTexte (string& p_tampon, const string& p_texte)
+{
+  ecrireValeur<uint32_t> (p_tampon, static_cast<uint32_t> (p_texte.size ()));
+  p_tampon.append (p_texte);
+}
+
+
+/**
+ * \brief Curseur de lecture borné sur un tampon encodé
+ */
+class Lecteur
+{
+public:
+  Lecteur (const char* p_debut, const char* p_fin) : m_courant (p_debut), m_fin (p_fin) { }
+
+  template<typename T>
+  bool
+  lire (T& p_valeur)
+  {
+    if (static_cast<size_t> (m_fin - m_courant) < sizeof (T))
+      {
+        return false;
+      }
+    memcpy (&p_valeur, m_courant, sizeof (T));
+    m_courant += sizeof (T);
+    return true;
+  }
+
+  bool
+  lireTexte (string& p_texte)
+  {
+    uint32_t taille = 0;
+    if (!lire (taille) || static_cast<size_t> (m_fin - m_courant) < taille)
+      {
+        return false;
+      }
+    p_texte.assign (m_courant, taille);
+    m_courant += taille;
+    return true;
+  }
+
+  bool
+  estTermine () const
+  {
+    return m_courant == m_fin;
+  }
+
+private:
+  const char* m_courant;
+  const char* m_fin;
+};
+} //namespace
+
+
+/**
+ * \brief Calcule la somme de contrôle CRC-32 (polynôme IEEE) d'un bloc de données
+ * \param[in] p_donnees pointeur vers le début du bloc
+ * \param[in] p_taille nombre d'octets du bloc
+ * \return la somme de contrôle du bloc
+ */
+uint32_t
+calculerCrc32 (const char* p_donnees, size_t p_taille)
+{
+  static const struct Table
+  {
+    uint32_t valeurs[256];
+
+    Table ()
+    {
+      for (uint32_t i = 0; i < 256; ++i)
+        {
+          uint32_t c = i;
+          for (int k = 0; k < 8; ++k)
+            {
+              c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+          valeurs[i] = c;
+        }
+    }
+  } table;
+
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < p_taille; ++i)
+    {
+      crc = table.valeurs[(crc ^ static_cast<unsigned char> (p_donnees[i])) & 0xFF] ^ (crc >> 8);
+    }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+
+/**
+ * \brief Ajoute la forme binaire d'un enregistrement à la fin d'un tampon
+ *        Le format est : longueur de la charge utile, CRC-32 de la charge utile,
+ *        puis la charge utile elle-même.
+ * \param[in] p_enregistrement l'enregistrement à encoder
+ * \param[in,out] p_tampon le tampon auquel l'enregistrement est ajouté
+ */
+void
+encoderEnregistrement (const EnregistrementJournal& p_enregistrement, string& p_tampon)
+{
+  const size_t debut = p_tampon.size ();
+  p_tampon.append (TAILLE_ENTETE, '\0');
+
+  ecrireValeur (p_tampon, static_cast<uint8_t> (p_enregistrement.type));
+  ecrireValeur<int32_t> (p_tampon, p_enregistrement.noFolio);
+  ecrireValeur<int32_t> (p_tampon, p_enregistrement.noCompte);
+  ecrireValeur<int32_t> (p_tampon, p_enregistrement.nombreTransactions);
+  ecrireValeur (p_tampon, p_enregistrement.solde);
+  ecrireValeur (p_tampon, p_enregistrement.tauxInteret);
+  ecrireValeur (p_tampon, p_enregistrement.tauxInteretMinimum);
+  ecrireTexte (p_tampon, p_enregistrement.nom);
+  ecrireTexte (p_tampon, p_enregistrement.prenom);
+  ecrireTexte (p_tampon, p_enregistrement.telephone);
+  ecrireTexte (p_tampon, p_enregistrement.description);
+  ecrireValeur<int32_t> (p_tampon, p_enregistrement.jour);
+  ecrireValeur<int32_t> (p_tampon, p_enregistrement.mois);
+  ecrireValeur<int32_t> (p_tampon, p_enregistrement.annee);
+
+  const char* charge = p_tampon.data () + debut + TAILLE_ENTETE;
+  const uint32_t taille = static_cast<uint32_t> (p_tampon.size () - debut - TAILLE_ENTETE);
+  const uint32_t crc = calculerCrc32 (charge, taille);
+  memcpy (&p_tampon[debut], &taille, sizeof (taille));
+  memcpy (&p_tampon[debut + sizeof (taille)], &crc, sizeof (crc));
+}
+
+
+/**
+ * \brief Décode un enregistrement à partir du début d'un bloc de données
+ * \param[in] p_donnees pointeur vers le début de l'enregistrement encodé
+ * \param[in] p_taille nombre d'octets disponibles à partir de p_donnees
+ * \param[out] p_enregistrement l'enregistrement décodé
+ * \return le nombre d'octets consommés, ou 0 si l'enregistrement est
+ *         incomplet ou corrompu (fin de journal)
+ */
+size_t
+decoderEnregistrement (const char* p_donnees, size_t p_taille,
+                       EnregistrementJournal& p_enregistrement)
+{
+  uint32_t taille = 0;
+  uint32_t crc = 0;
+  if (p_taille < TAILLE_ENTETE)
+    {
+      return 0;
+    }
+  memcpy (&taille, p_donnees, sizeof (taille));
+  memcpy (&crc, p_donnees + sizeof (taille), sizeof (crc));
+  if (p_taille - TAILLE_ENTETE < taille
+      || calculerCrc32 (p_donnees + TAILLE_ENTETE, taille) != crc)
+    {
+      return 0;
+    }
+
+  Lecteur lecteur (p_donnees + TAILLE_ENTETE, p_donnees + TAILLE_ENTETE + taille);
+  uint8_t type = 0;
+  int32_t noFolio = 0, noCompte = 0, nombreTransactions = 0, jour = 0, mois = 0, annee = 0;
+  bool valide = lecteur.lire (type)
+          && lecteur.lire (noFolio)
+          && lecteur.lire (noCompte)
+          && lecteur.lire (nombreTransactions)
+          && lecteur.lire (p_enregistrement.solde)
+          && lecteur.lire (p_enregistrement.tauxInteret)
+          && lecteur.lire (p_enregistrement.tauxInteretMinimum)
+          && lecteur.lireTexte (p_enregistrement.nom)
+          && lecteur.lireTexte (p_enregistrement.prenom)
+          && lecteur.lireTexte (p_enregistrement.telephone)
+          && lecteur.lireTexte (p_enregistrement.description)
+          && lecteur.lire (jour)
+          && lecteur.lire (mois)
+          && lecteur.lire (annee)
+          && lecteur.estTermine ()
+          && type >= static_cast<uint8_t> (TypeOperation::AjoutClient)
+          && type <= static_cast<uint8_t> (TypeOperation::AsgDescription);
+  if (!valide)
+    {
+      return 0;
+    }
+
+  p_enregistrement.type = static_cast<TypeOperation> (type);
+  p_enregistrement.noFolio = noFolio;
+  p_enregistrement.noCompte = noCompte;
+  p_enregistrement.nombreTransactions = nombreTransactions;
+  p_enregistrement.jour = jour;
+  p_enregistrement.mois = mois;
+  p_enregistrement.annee = annee;
+
+  return TAILLE_ENTETE + taille;
+}
+
+
+/**
+ * \brief Vérifie qu'un enregistrement venu de l'extérieur respecte les règles de saisie
+ *
+ * Reprend les contrôles de FonctionsEntree et les préconditions de Client,
+ * Cheque et Epargne qui ne dépendent que de l'enregistrement : ces contrats
+ * disparaissent avec NDEBUG, un enregistrement lu d'un script ou reçu d'un
+ * client doit donc être vérifié avant d'être appliqué. Les règles qui
+ * dépendent du compte visé (type, taux minimum) sont celles de
+ * verifierMutationCompte, que la Banque applique à chaque mutation.
+ *
+ * \param[in] p_enregistrement l'enregistrement à vérifier
+ * \return vrai si l'enregistrement peut être appliqué à un client existant
+ */
+bool
+validerEnregistrement (const EnregistrementJournal& p_enregistrement)
+{
+  const int noFolio = p_enregistrement.noFolio;
+  const double taux = p_enregistrement.tauxInteret;
+  const double tauxMinimum = p_enregistrement.tauxInteretMinimum;
+  const double solde = p_enregistrement.solde;
+  const int transactions = p_enregistrement.nombreTransactions;
+  const bool description = !p_enregistrement.description.empty ();
+
+  if (noFolio < 1000 || noFolio >= 10000)
+    {
+      return false;
+    }
+  if (p_enregistrement.type == TypeOperation::AjoutClient)
+    {
+      return util::validerFormatNom (p_enregistrement.nom) && util::validerFormatNom (p_enregistrement.prenom)
+              && !p_enregistrement.telephone.empty ()
+              && util::Date::validerDate (p_enregistrement.jour, p_enregistrement.mois, p_enregistrement.annee);
+    }
+  if (p_enregistrement.noCompte <= 0)
+    {
+      return false;
+    }
+  switch (p_enregistrement.type)
+    {
+    case TypeOperation::AjoutCheque:
+      return taux >= 0 && taux <= 100 && tauxMinimum >= 0 && tauxMinimum <= taux
+              && transactions >= 0 && transactions <= 40 && isfinite (solde) && description;
+    case TypeOperation::AjoutEpargne:
+      return taux >= 0.1 && taux <= 3.5 && solde >= 0 && isfinite (solde) && description;
+    case TypeOperation::AsgSolde:
+      return isfinite (solde);
+    case TypeOperation::AsgTauxInteret:
+      return taux >= 0 && taux <= 100;
+    case TypeOperation::AsgNombreTransactions:
+      return transactions >= 0 && transactions <= 40;
+    case TypeOperation::AsgDescription:
+      return description;
+    default:
+      return true;
+    }
+}
+
+
+/**
+ * \brief Vérifie qu'une mutation convient au compte existant qu'elle vise
+ *
+ * Ces règles dépendent du type du compte ou de son taux minimum ; les
+ * préconditions de Cheque et Epargne qui les portaient disparaissent avec
+ * NDEBUG. Banque::appliquer les vérifie avant toute modification, donc avant
+ * la journalisation, et Recuperation ignore une mutation qui les enfreint.
+ *
+ * \param[in] p_operation la mutation ; seules AsgSolde, AsgTauxInteret et
+ *            AsgNombreTransactions sont concernées
+ * \param[in] p_typeCompte AjoutCheque ou AjoutEpargne, selon le compte visé
+ * \param[in] p_tauxInteretMinimum le taux minimum du compte visé s'il est un compte chèque
+ * \exception CompteException si la mutation ne convient pas au compte
+ */
+void
+verifierMutationCompte (const EnregistrementJournal& p_operation, TypeOperation p_typeCompte,
+                        double p_tauxInteretMinimum)
+{
+  const bool epargne = p_typeCompte == TypeOperation::AjoutEpargne;
+  switch (p_operation.type)
+    {
+    case TypeOperation::AsgNombreTransactions:
+      if (epargne)
+        {
+          throw CompteException("Le nombre de transactions ne s'applique qu'a un compte cheque");
+        }
+      break;
+    case TypeOperation::AsgSolde:
+      if (epargne && !(p_operation.solde >= 0))
+        {
+          throw CompteException("Le solde d'un compte epargne ne peut pas etre negatif");
+        }
+      break;
+    case TypeOperation::AsgTauxInteret:
+      if (epargne && !(p_operation.tauxInteret >= 0.1 && p_operation.tauxInteret <= 3.5))
+        {
+          throw CompteException("Le taux d'un compte epargne doit etre entre 0.1% et 3.5%");
+        }
+      if (!epargne && !(p_operation.tauxInteret >= p_tauxInteretMinimum))
+        {
+          throw CompteException("Le taux d'un compte cheque ne peut pas etre inferieur a son taux minimum");
+        }
+      break;
+    default:
+      break;
+    }
+}
+
+
+/**
+ * \brief Construit l'enregistrement qui décrit l'ajout d'un client (sans ses comptes)
+ * \param[in] p_client le client à ajouter
+ * \return l'enregistrement d'ajout du client
+ */
+EnregistrementJournal
+enregistrementAjoutClient (const Client& p_client)
+{
+  EnregistrementJournal enregistrement;
+  enregistrement.type = TypeOperation::AjoutClient;
+  enregistrement.noFolio = p_client.reqNoFolio ();
+  enregistrement.nom = p_client.reqNom ();
+  enregistrement.prenom = p_client.reqPrenom ();
+  enregistrement.telephone = p_client.reqTelephone ();
+  enregistrement.jour = p_client.reqDateNaissance ().reqJour ();
+  enregistrement.mois = p_client.reqDateNaissance ().reqMois ();
+  enregistrement.annee = p_client.reqDateNaissance ().reqAnnee ();
+  return enregistrement;
+}
+
+
+/**
+ * \brief Construit l'enregistrement qui décrit l'ajout d'un compte au portefeuille d'un client
+ * \param[in] p_noFolio le numéro de folio du client
+ * \param[in] p_compte le compte à ajouter
+ * \return l'enregistrement d'ajout du compte
+ * \pre p_compte doit être un compte Cheque ou Epargne
+ */
+EnregistrementJournal
+enregistrementAjoutCompte (int p_noFolio, const Compte& p_compte)
+{
+  const Cheque* cheque = dynamic_cast<const Cheque*> (&p_compte);
+  PRECONDITION(cheque != nullptr || dynamic_cast<const Epargne*> (&p_compte) != nullptr);
+
+  EnregistrementJournal enregistrement;
+  enregistrement.type = cheque ? TypeOperation::AjoutCheque : TypeOperation::AjoutEpargne;
+  enregistrement.noFolio = p_noFolio;
+  enregistrement.noCompte = p_compte.reqNoCompte ();
+  enregistrement.solde = p_compte.reqSolde ();
+  enregistrement.tauxInteret = p_compte.reqTauxInteret ();
+  enregistrement.description = p_compte.reqDescription ();
+  if (cheque)
+    {
+      enregistrement.nombreTransactions = cheque->reqNombreTransactions ();
+      enregistrement.tauxInteretMinimum = cheque->reqTauxInteretMinimum ();
+    }
+  return enregistrement;
+}
+
+} //namespace bancaire
@@ -0,0 +1,74 @@
+/**
+ * \file Journal.h
+ * \brief Fichier qui contient l'interface des enregistrements du journal des transactions.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstdint>
+#include <string>
+
+namespace bancaire
+{
+class Client;
+class Compte;
+
+/**
+ * \enum TypeOperation
+ * \brief Type de mutation consignée dans le journal des transactions.
+ */
+enum class TypeOperation : std::uint8_t
+{
+  AjoutClient = 1,
+  AjoutCheque,
+  AjoutEpargne,
+  SuppressionCompte,
+  AsgSolde,
+  AsgTauxInteret,
+  AsgNombreTransactions,
+  AsgDescription
+};
+
+/**
+ * \struct EnregistrementJournal
+ * \brief Décrit une mutation d'un Client ou d'un de ses comptes.
+ *
+ * Seuls les champs utiles au type d'opération sont significatifs, les autres
+ * gardent leur valeur par défaut. Un enregistrement est encodé en binaire
+ * avec sa longueur et une somme de contrôle CRC-32, ce qui permet de détecter
+ * une écriture partielle en fin de journal lors de la récupération.
+ */
+struct EnregistrementJournal
+{
+  TypeOperation type = TypeOperation::AjoutClient;
+  int noFolio = 0;
+  int noCompte = 0;
+  int nombreTransactions = 0;
+  double solde = 0;
+  double tauxInteret = 0;
+  double tauxInteretMinimum = 0;
+  std::string nom;
+  std::string prenom;
+  std::string telephone;
+  std::string description;
+  int jour = 0;
+  int mois = 0;
+  int annee = 0;
+};
+
+void encoderEnregistrement(const EnregistrementJournal& p_enregistrement, std::string& p_tampon);
+std::size_t decoderEnregistrement(const char* p_donnees, std::size_t p_taille,
+                                  EnregistrementJournal& p_enregistrement);
+std::uint32_t calculerCrc32(const char* p_donnees, std::size_t p_taille);
+bool validerEnregistrement(const EnregistrementJournal& p_enregistrement);
+void verifierMutationCompte(const EnregistrementJournal& p_operation, TypeOperation p_typeCompte,
+                            double p_tauxInteretMinimum);
+
+EnregistrementJournal enregistrementAjoutClient(const Client& p_client);
+EnregistrementJournal enregistrementAjoutCompte(int p_noFolio, const Compte& p_compte);
+
+} //namespace bancaire
+
+#endif /* JOURNAL_H */
@@ -0,0 +1,283 @@
+/**
+ * \file JournalContrat.cpp
+ * \brief Implantation de la consignation des violations de contrat en mémoire
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "JournalContrat.h"
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace contrat
+{
+namespace
+{
+const size_t CAPACITE_ANNEAU = 4096;
+
+atomic<Signalement> g_signalement {Signalement::Console};
+
+
+/**
+ * \brief Copie une chaîne dans un tableau de taille fixe, en la tronquant au besoin
+ */
+template<size_t N>
+void
+copierTronque (char (&p_destination)[N], const char* p_source, size_t p_taille)
+{
+  size_t n = p_taille < N - 1 ? p_taille : N - 1;
+  memcpy (p_destination, p_source, n);
+  p_destination[n] = '\0';
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe AnneauViolations
+ * \param[in] p_capacite nombre de cases, doit être une puissance de deux
+ * \exception std::invalid_argument si la capacité n'est pas une puissance de deux
+ */
+AnneauViolations::AnneauViolations (size_t p_capacite) :
+m_masque (p_capacite - 1), m_cases (new Case[p_capacite]), m_depot (0), m_retrait (0), m_perdues (0)
+{
+  if (p_capacite < 2 || (p_capacite & (p_capacite - 1)) != 0)
+    {
+      throw invalid_argument ("La capacite de l'anneau doit etre une puissance de deux");
+    }
+  for (size_t i = 0; i < p_capacite; ++i)
+    {
+      m_cases[i].sequence.store (i, memory_order_relaxed);
+    }
+}
+
+
+/**
+ * \brief Retourne le nombre de cases de l'anneau
+ * \return la capacité de l'anneau
+ */
+size_t
+AnneauViolations::reqCapacite () const
+{
+  return m_masque + 1;
+}
+
+
+/**
+ * \brief Retourne le nombre de violations perdues parce que l'anneau était plein
+ * \return le nombre de dépôts refusés
+ */
+uint64_t
+AnneauViolations::reqNombrePerdues () const
+{
+  return m_perdues.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Dépose une violation sans jamais bloquer
+ * \param[in] p_violation la violation à consigner
+ * \return faux si l'anneau est plein ; la violation est alors comptée comme perdue
+ */
+bool
+AnneauViolations::deposer (const Violation& p_violation)
+{
+  size_t position = m_depot.load (memory_order_relaxed);
+  for (;;)
+    {
+      Case& uneCase = m_cases[position & m_masque];
+      size_t sequence = uneCase.sequence.load (memory_order_acquire);
+      intptr_t difference = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (position);
+      if (difference == 0)
+        {
+          if (m_depot.compare_exchange_weak (position, position + 1, memory_order_relaxed))
+            {
+              uneCase.violation = p_violation;
+              uneCase.sequence.store (position + 1, memory_order_release);
+              return true;
+            }
+        }
+      else if (difference < 0)
+        {
+          m_perdues.fetch_add (1, memory_order_relaxed);
+          return false;
+        }
+      else
+        {
+          position = m_depot.load (memory_order_relaxed);
+        }
+    }
+}
+
+
+/**
+ * \brief Retire la plus ancienne violation de l'anneau
+ * \param[out] p_violation la violation retirée
+ * \return faux si l'anneau est vide
+ */
+bool
+AnneauViolations::retirer (Violation& p_violation)
+{
+  size_t position = m_retrait.load (memory_order_relaxed);
+  for (;;)
+    {
+      Case& uneCase = m_cases[position & m_masque];
+      size_t sequence = uneCase.sequence.load (memory_order_acquire);
+      intptr_t difference = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (position + 1);
+      if (difference == 0)
+        {
+          if (m_retrait.compare_exchange_weak (position, position + 1, memory_order_relaxed))
+            {
+              p_violation = uneCase.violation;
+              uneCase.sequence.store (position + m_masque + 1, memory_order_release);
+              return true;
+            }
+        }
+      else if (difference < 0)
+        {
+          return false;
+        }
+      else
+        {
+          position = m_retrait.load (memory_order_relaxed);
+        }
+    }
+}
+
+
+/**
+ * \brief Constructeur de la classe VidangeViolations
+ *        Passe le signalement en mode Anneau et démarre le fil de vidange.
+ * \param[in] p_journal flux qui reçoit les violations, il doit survivre à l'objet
+ * \param[in] p_periode intervalle entre deux vidanges de l'anneau
+ */
+VidangeViolations::VidangeViolations (ostream& p_journal, chrono::milliseconds p_periode) :
+m_journal (p_journal), m_periode (p_periode), m_arret (false), m_nombreEcrites (0)
+{
+  asgSignalement (Signalement::Anneau);
+  m_fil = thread (&VidangeViolations::boucleVidange, this);
+}
+
+
+/**
+ * \brief Destructeur de la classe VidangeViolations
+ *        Rétablit le mode Console puis écrit les violations restantes.
+ */
+VidangeViolations::~VidangeViolations ()
+{
+  asgSignalement (Signalement::Console);
+  {
+    lock_guard<mutex> verrou (m_mutex);
+    m_arret = true;
+  }
+  m_condition.notify_one ();
+  m_fil.join ();
+  vider ();
+}
+
+
+/**
+ * \brief Retourne le nombre de violations écrites dans le journal
+ * \return le nombre de violations vidées depuis la création
+ */
+uint64_t
+VidangeViolations::reqNombreEcrites () const
+{
+  return m_nombreEcrites.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Écrit immédiatement dans le journal toutes les violations en attente
+ */
+void
+VidangeViolations::vider ()
+{
+  Violation violation;
+  uint64_t ecrites = 0;
+  while (anneauViolations ().retirer (violation))
+    {
+      m_journal << "Message : " << violation.message << '\n'
+              << "Fichier : " << violation.fichier << '\n'
+              << "Ligne   : " << violation.ligne << '\n'
+              << "Test    : " << violation.expression << '\n';
+      ++ecrites;
+    }
+  if (ecrites > 0)
+    {
+      m_journal.flush ();
+      m_nombreEcrites.fetch_add (ecrites, memory_order_relaxed);
+    }
+}
+
+
+/**
+ * \brief Boucle du fil de vidange
+ */
+void
+VidangeViolations::boucleVidange ()
+{
+  unique_lock<mutex> verrou (m_mutex);
+  while (!m_arret)
+    {
+      m_condition.wait_for (verrou, m_periode, [this] { return m_arret; });
+      verrou.unlock ();
+      vider ();
+      verrou.lock ();
+    }
+}
+
+
+/**
+ * \brief Choisit la destination des violations de contrat
+ * \param[in] p_signalement Console (affichage immédiat) ou Anneau (consignation en mémoire)
+ */
+void
+asgSignalement (Signalement p_signalement)
+{
+  g_signalement.store (p_signalement, memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne la destination courante des violations de contrat
+ * \return le mode de signalement en vigueur
+ */
+Signalement
+reqSignalement ()
+{
+  return g_signalement.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne l'anneau des violations du processus
+ * \return une référence vers l'anneau partagé
+ */
+AnneauViolations&
+anneauViolations ()
+{
+  static AnneauViolations anneau (CAPACITE_ANNEAU);
+  return anneau;
+}
+
+
+/**
+ * \brief Copie les renseignements d'une violation dans l'anneau du processus
+ * \param[in] p_message le type d'erreur de contrat
+ * \param[in] p_fichier le fichier source de la violation
+ * \param[in] p_ligne la ligne de la violation
+ * \param[in] p_expression le test logique qui a échoué
+ */
+void
+consignerViolation (const char* p_message, const string& p_fichier, unsigned int p_ligne,
+                    const string& p_expression)
+{
+  Violation violation;
+  copierTronque (violation.message, p_message, strlen (p_message));
+  copierTronque (violation.fichier, p_fichier.data (), p_fichier.size ());
+  copierTronque (violation.expression, p_expression.data (), p_expression.size ());
+  violation.ligne = p_ligne;
+  anneauViolations ().deposer (violation);
+}
+} // namespace contrat
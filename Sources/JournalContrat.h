@@ -0,0 +1,125 @@
+/**
+ * \file JournalContrat.h
+ * \brief Consignation des violations de contrat dans un anneau en mémoire.
+ *
+ * Par défaut, les exceptions de contrat affichent leur texte complet sur la
+ * console dès leur construction. En mode Anneau, elles se contentent de copier
+ * le fichier, la ligne et le test dans un anneau sans verrou, et un fil de
+ * vidange (VidangeViolations) écrit plus tard ces violations dans un journal.
+ * Si l'anneau est plein, la violation est comptée comme perdue plutôt que de
+ * bloquer le traitement de la requête.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef JOURNALCONTRAT_H
+#define JOURNALCONTRAT_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace contrat
+{
+/**
+ * \enum Signalement
+ * \brief Destination des violations de contrat au moment de leur construction.
+ */
+enum class Signalement : unsigned char
+{
+  Console,
+  Anneau
+};
+
+/**
+ * \struct Violation
+ * \brief Copie de taille fixe des renseignements d'une violation de contrat.
+ */
+struct Violation
+{
+  char message[32];
+  char fichier[96];
+  char expression[128];
+  unsigned int ligne;
+};
+
+/**
+ * \class AnneauViolations
+ * \brief File circulaire bornée sans verrou, à producteurs et consommateurs multiples.
+ *
+ * Chaque case porte un numéro de séquence qui indique si elle est libre pour
+ * le prochain dépôt ou prête pour le prochain retrait.
+ */
+class AnneauViolations
+{
+public:
+  explicit AnneauViolations(std::size_t p_capacite);
+  AnneauViolations(const AnneauViolations&)=delete;
+  AnneauViolations& operator=(const AnneauViolations&)=delete;
+
+  std::size_t reqCapacite() const;
+  std::uint64_t reqNombrePerdues() const;
+
+  bool deposer(const Violation& p_violation);
+  bool retirer(Violation& p_violation);
+
+private:
+  struct Case
+  {
+    std::atomic<std::size_t> sequence;
+    Violation violation;
+  };
+
+  const std::size_t m_masque;
+  std::unique_ptr<Case[]> m_cases;
+  alignas(64) std::atomic<std::size_t> m_depot;
+  alignas(64) std::atomic<std::size_t> m_retrait;
+  alignas(64) std::atomic<std::uint64_t> m_perdues;
+};
+
+/**
+ * \class VidangeViolations
+ * \brief Fil qui vide périodiquement l'anneau des violations vers un journal.
+ *
+ * Tant qu'un objet existe, le signalement est en mode Anneau ; sa destruction
+ * vide les violations restantes et rétablit le mode Console.
+ */
+class VidangeViolations
+{
+public:
+  explicit VidangeViolations(std::ostream& p_journal,
+                             std::chrono::milliseconds p_periode=std::chrono::milliseconds(100));
+  ~VidangeViolations();
+  VidangeViolations(const VidangeViolations&)=delete;
+  VidangeViolations& operator=(const VidangeViolations&)=delete;
+
+  std::uint64_t reqNombreEcrites() const;
+  void vider();
+
+private:
+  void boucleVidange();
+
+  std::ostream& m_journal;
+  const std::chrono::milliseconds m_periode;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_arret;
+  std::atomic<std::uint64_t> m_nombreEcrites;
+  std::thread m_fil;
+};
+
+void asgSignalement(Signalement p_signalement);
+Signalement reqSignalement();
+AnneauViolations& anneauViolations();
+void consignerViolation(const char* p_message, const std::string& p_fichier,
+                        unsigned int p_ligne, const std::string& p_expression);
+} // namespace contrat
+
+#endif /* JOURNALCONTRAT_H */
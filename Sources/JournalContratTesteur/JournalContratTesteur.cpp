@@ -0,0 +1,130 @@
+/**
+ * \file JournalContratTesteur.cpp
+ * \brief Test unitaire de la consignation des violations de contrat.
+ *
+ * À tester :
+ *         AnneauViolations(std::size_t p_capacite);
+ *         bool deposer(const Violation& p_violation);
+ *         bool retirer(Violation& p_violation);
+ *         VidangeViolations(std::ostream& p_journal, std::chrono::milliseconds p_periode);
+ *         void vider();
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "JournalContrat.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace bancaire;
+using namespace contrat;
+using namespace std;
+
+namespace
+{
+Violation
+violationNumero (unsigned int p_ligne)
+{
+  Violation violation {};
+  strcpy (violation.message, "ERREUR DE TEST");
+  violation.ligne = p_ligne;
+  return violation;
+}
+} //namespace
+
+
+/**
+ * \brief Test du constructeur de AnneauViolations
+ *     Cas valides : une capacité puissance de deux est acceptée.
+ *     Cas invalides : une autre capacité est refusée.
+ */
+TEST(AnneauViolationsTest, constructeur_CapaciteInvalide_Exception)
+{
+  AnneauViolations anneau(8);
+  ASSERT_EQ(8u, anneau.reqCapacite ());
+  ASSERT_THROW(AnneauViolations autre(6), invalid_argument);
+}
+
+
+/**
+ * \brief Test des méthodes deposer et retirer
+ *     Cas valides : les violations sont retirées dans l'ordre de dépôt.
+ *     Cas limites : un anneau plein refuse le dépôt et compte la perte ;
+ *                   un anneau vide ne retire rien.
+ */
+TEST(AnneauViolationsTest, deposerRetirer_OrdreConserve_PertesComptees)
+{
+  AnneauViolations anneau(4);
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      ASSERT_TRUE(anneau.deposer (violationNumero (i)));
+    }
+  ASSERT_FALSE(anneau.deposer (violationNumero (99)));
+  ASSERT_EQ(1u, anneau.reqNombrePerdues ());
+
+  Violation violation;
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      ASSERT_TRUE(anneau.retirer (violation));
+      ASSERT_EQ(i, violation.ligne);
+    }
+  ASSERT_FALSE(anneau.retirer (violation));
+}
+
+TEST(AnneauViolationsTest, deposer_ProducteursConcurrents_AucunePerte)
+{
+  AnneauViolations anneau(1024);
+  vector<thread> fils;
+  for (unsigned int f = 0; f < 4; ++f)
+    {
+      fils.emplace_back ([&anneau, f]
+        {
+          for (unsigned int i = 0; i < 200; ++i)
+            {
+              anneau.deposer (violationNumero (f * 1000 + i));
+            }
+        });
+    }
+  for (auto& fil : fils)
+    {
+      fil.join ();
+    }
+  vector<int> vues(4, 0);
+  Violation violation;
+  while (anneau.retirer (violation))
+    {
+      ++vues[violation.ligne / 1000];
+    }
+  ASSERT_EQ(vector<int>(4, 200), vues);
+  ASSERT_EQ(0u, anneau.reqNombrePerdues ());
+}
+
+
+/**
+ * \brief Test de la classe VidangeViolations
+ *     Cas valides : une violation de précondition n'est pas affichée sur la
+ *                   console mais écrite dans le journal de vidange ; le mode
+ *                   Console est rétabli à la destruction.
+ */
+TEST(VidangeViolationsTest, violation_ModeAnneau_EcriteDansJournal)
+{
+  ostringstream journal;
+  {
+    VidangeViolations vidange(journal);
+    ASSERT_EQ(Signalement::Anneau, reqSignalement ());
+
+    testing::internal::CaptureStdout ();
+    ASSERT_THROW(Epargne(1230, 12, 5000, "Etudes"), PreconditionException);
+    ASSERT_EQ("", testing::internal::GetCapturedStdout ());
+
+    vidange.vider ();
+    ASSERT_EQ(1u, vidange.reqNombreEcrites ());
+  }
+  ASSERT_EQ(Signalement::Console, reqSignalement ());
+  ASSERT_NE(string::npos, journal.str ().find ("ERREUR DE PRECONDITION"));
+  ASSERT_NE(string::npos, journal.str ().find ("Epargne.cpp"));
+}
@@ -0,0 +1,479 @@
+/**
+ * \file Metriques.cpp
+ * \brief Implantation des compteurs et des histogrammes de latence
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "Metriques.h"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+using namespace std;
+
+namespace metriques
+{
+namespace
+{
+const unsigned BITS_SOUS_SEAUX = 4;
+const uint64_t SOUS_SEAUX = 1u << BITS_SOUS_SEAUX;
+const unsigned EXPOSANT_MAXIMUM = 40;
+const size_t NOMBRE_SEAUX = (EXPOSANT_MAXIMUM - BITS_SOUS_SEAUX + 1) * SOUS_SEAUX;
+
+const char* const NOMS_OPERATIONS[NOMBRE_OPERATIONS] = {
+  "Client::ajouterCompte",
+  "Client::supprimerCompte",
+  "Client::ajouterComptesEnBloc",
+  "Client::viderComptes",
+  "Client::reqCompte",
+  "Client::reqReleves",
+  "Client::reqClientFormate",
+  "Client::Client(const Client&)",
+  "Compte::asgSolde",
+  "Compte::asgTauxInteret",
+  "Compte::asgDescription",
+  "Compte::calculerInteret",
+  "Compte::reqCompteFormate"
+};
+
+
+/**
+ * \brief Seau d'une durée : exact sous 16 ns, puis 16 seaux par puissance de deux
+ */
+size_t
+indiceSeau (uint64_t p_valeur)
+{
+  if (p_valeur < SOUS_SEAUX)
+    {
+      return static_cast<size_t> (p_valeur);
+    }
+  unsigned exposant = 63 - static_cast<unsigned> (__builtin_clzll (p_valeur));
+  if (exposant >= EXPOSANT_MAXIMUM)
+    {
+      return NOMBRE_SEAUX - 1;
+    }
+  uint64_t mantisse = (p_valeur >> (exposant - BITS_SOUS_SEAUX)) & (SOUS_SEAUX - 1);
+  return (exposant - BITS_SOUS_SEAUX + 1) * SOUS_SEAUX + mantisse;
+}
+
+
+/**
+ * \brief Plus grande durée rangée dans un seau
+ */
+uint64_t
+borneSuperieure (size_t p_indice)
+{
+  if (p_indice < SOUS_SEAUX)
+    {
+      return p_indice;
+    }
+  unsigned exposant = static_cast<unsigned> (p_indice / SOUS_SEAUX) + BITS_SOUS_SEAUX - 1;
+  uint64_t mantisse = p_indice % SOUS_SEAUX;
+  return ((SOUS_SEAUX + mantisse + 1) << (exposant - BITS_SOUS_SEAUX)) - 1;
+}
+
+
+/**
+ * \brief Incrément par un seul écrivain : pas besoin d'instruction verrouillée
+ */
+inline void
+ajouter (atomic<uint64_t>& p_compteur, uint64_t p_valeur)
+{
+  p_compteur.store (p_compteur.load (memory_order_relaxed) + p_valeur, memory_order_relaxed);
+}
+
+
+/**
+ * \brief Compteurs d'une opération pour un fil, sur leurs propres lignes de cache
+ */
+struct alignas(64) CompteurOperation
+{
+  atomic<uint64_t> total {0};
+  atomic<uint64_t> maximum {0};
+  atomic<uint64_t> allocations {0};
+  atomic<uint64_t> octets {0};
+  atomic<uint64_t> liberations {0};
+  atomic<uint64_t> seaux[NOMBRE_SEAUX] = {};
+};
+
+
+/**
+ * \brief Bloc de compteurs d'un fil ; réutilisé par un autre fil après la fin du premier
+ */
+struct CompteursFil
+{
+  atomic<bool> enUsage {true};
+  CompteurOperation operations[NOMBRE_OPERATIONS];
+};
+
+
+/**
+ * \brief Tous les blocs créés ; ils ne sont jamais libérés pour que les
+ *        mesures des fils terminés restent dans les agrégats.
+ */
+struct Registre
+{
+  mutex verrou;
+  vector<unique_ptr<CompteursFil>> blocs;
+};
+
+
+Registre&
+registre ()
+{
+  static Registre instance;
+  return instance;
+}
+
+
+CompteursFil*
+obtenirBloc ()
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  for (auto& bloc : reg.blocs)
+    {
+      bool libre = false;
+      if (bloc->enUsage.compare_exchange_strong (libre, true))
+        {
+          return bloc.get ();
+        }
+    }
+  reg.blocs.push_back (make_unique<CompteursFil>());
+  return reg.blocs.back ().get ();
+}
+
+
+/**
+ * \brief Rattache un bloc au fil courant et le rend à la fin du fil
+ */
+struct Attache
+{
+  CompteursFil* bloc = obtenirBloc ();
+  ~Attache ()
+  {
+    bloc->enUsage.store (false, memory_order_release);
+  }
+};
+
+
+CompteursFil&
+blocCourant ()
+{
+  thread_local Attache attache;
+  return *attache.bloc;
+}
+
+
+/**
+ * \brief État du fil lu par le crochet d'allocation. Ces variables n'ont pas
+ *        d'initialisation dynamique : les lire n'alloue jamais.
+ */
+thread_local CompteurOperation* t_operationCourante = nullptr;
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_octets = 0;
+thread_local uint64_t t_liberations = 0;
+atomic<bool> s_crochetInstalle {false};
+
+
+uint64_t
+centile (const vector<uint64_t>& p_seaux, uint64_t p_nombre, double p_fraction)
+{
+  uint64_t rang = static_cast<uint64_t> (p_fraction * static_cast<double> (p_nombre));
+  rang = min (max<uint64_t> (rang, 1), p_nombre);
+  uint64_t cumul = 0;
+  for (size_t i = 0; i < p_seaux.size (); ++i)
+    {
+      cumul += p_seaux[i];
+      if (cumul >= rang)
+        {
+          return borneSuperieure (i);
+        }
+    }
+  return 0;
+}
+} //namespace
+
+
+/**
+ * \brief Active ou désactive la mesure dans tous les fils
+ * \param[in] p_actives vrai pour mesurer
+ */
+void asgActives(bool p_actives)
+{
+  Reglage::actives.store (p_actives, std::memory_order_relaxed);
+}
+
+
+/**
+ * \brief Indique si la mesure est active
+ * \return vrai si les opérations sont mesurées
+ */
+bool reqActives()
+{
+  return Reglage::actives.load (std::memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne le nom affiché d'une opération
+ * \param[in] p_operation l'opération
+ * \return le nom qualifié de la méthode mesurée
+ */
+const char* reqNomOperation(Operation p_operation)
+{
+  unsigned indice = static_cast<unsigned> (p_operation);
+  return indice < NOMBRE_OPERATIONS ? NOMS_OPERATIONS[indice] : "?";
+}
+
+
+/**
+ * \brief Enregistre une durée dans le bloc du fil courant
+ * \param[in] p_operation l'opération mesurée
+ * \param[in] p_nanosecondes la durée de l'appel
+ */
+void enregistrer(Operation p_operation, std::uint64_t p_nanosecondes)
+{
+  CompteurOperation& compteur = blocCourant ().operations[static_cast<unsigned> (p_operation)];
+  ajouter (compteur.total, p_nanosecondes);
+  if (p_nanosecondes > compteur.maximum.load (memory_order_relaxed))
+    {
+      compteur.maximum.store (p_nanosecondes, memory_order_relaxed);
+    }
+  ajouter (compteur.seaux[indiceSeau (p_nanosecondes)], 1);
+}
+
+
+/**
+ * \brief Fait de p_operation l'opération courante du fil, à qui sont attribuées
+ *        les allocations jusqu'à terminerOperation
+ * \param[in] p_operation l'opération qui commence
+ * \return l'opération courante précédente, à rétablir à la fin
+ */
+void* debuterOperation(Operation p_operation)
+{
+  CompteurOperation* precedente = t_operationCourante;
+  t_operationCourante = nullptr;
+  CompteurOperation* courante = &blocCourant ().operations[static_cast<unsigned> (p_operation)];
+  t_operationCourante = courante;
+  return precedente;
+}
+
+
+/**
+ * \brief Enregistre la durée d'une opération et rétablit l'opération précédente
+ * \param[in] p_operation l'opération qui se termine
+ * \param[in] p_nanosecondes sa durée
+ * \param[in] p_precedente la valeur retournée par debuterOperation
+ */
+void terminerOperation(Operation p_operation, std::uint64_t p_nanosecondes, void* p_precedente)
+{
+  enregistrer (p_operation, p_nanosecondes);
+  t_operationCourante = static_cast<CompteurOperation*> (p_precedente);
+}
+
+
+/**
+ * \brief Compte une allocation pour le fil et pour son opération courante
+ *        Appelée par l'opérateur new de ComptabiliteAllocations.h ; n'alloue jamais.
+ * \param[in] p_octets la taille demandée
+ */
+void compterAllocation(std::size_t p_octets) noexcept
+{
+  if (!s_crochetInstalle.load (memory_order_relaxed))
+    {
+      s_crochetInstalle.store (true, memory_order_relaxed);
+    }
+  ++t_allocations;
+  t_octets += p_octets;
+  if (t_operationCourante != nullptr)
+    {
+      ajouter (t_operationCourante->allocations, 1);
+      ajouter (t_operationCourante->octets, p_octets);
+    }
+}
+
+
+/**
+ * \brief Compte une libération pour le fil et pour son opération courante
+ *        Appelée par l'opérateur delete de ComptabiliteAllocations.h.
+ */
+void compterLiberation() noexcept
+{
+  ++t_liberations;
+  if (t_operationCourante != nullptr)
+    {
+      ajouter (t_operationCourante->liberations, 1);
+    }
+}
+
+
+/**
+ * \brief Indique si les allocations sont comptées, c'est-à-dire si le
+ *        programme inclut ComptabiliteAllocations.h
+ * \return vrai si au moins une allocation a été comptée
+ */
+bool reqComptabiliteAllocations()
+{
+  return s_crochetInstalle.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne les allocations du fil courant depuis son début, mesure
+ *        active ou non. Les bancs d'essai en font la différence autour d'une boucle.
+ * \return les totaux du fil
+ */
+Allocations reqAllocationsFil()
+{
+  return Allocations {t_allocations, t_octets, t_liberations};
+}
+
+
+/**
+ * \brief Agrège les blocs de tous les fils
+ *        Les fils peuvent continuer à mesurer pendant la capture : chaque
+ *        compteur est lu de façon cohérente, mais pas l'ensemble.
+ * \return les statistiques de chaque opération appelée au moins une fois
+ */
+std::vector<Statistiques> capturer()
+{
+  vector<Statistiques> resultats;
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  vector<uint64_t> seaux(NOMBRE_SEAUX);
+  for (unsigned op = 0; op < NOMBRE_OPERATIONS; ++op)
+    {
+      Statistiques stat {static_cast<Operation> (op), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, {}};
+      fill (seaux.begin (), seaux.end (), 0);
+      for (const auto& bloc : reg.blocs)
+        {
+          const CompteurOperation& compteur = bloc->operations[op];
+          stat.total += compteur.total.load (memory_order_relaxed);
+          stat.maximum = max (stat.maximum, compteur.maximum.load (memory_order_relaxed));
+          stat.allocations += compteur.allocations.load (memory_order_relaxed);
+          stat.octets += compteur.octets.load (memory_order_relaxed);
+          stat.liberations += compteur.liberations.load (memory_order_relaxed);
+          for (size_t i = 0; i < NOMBRE_SEAUX; ++i)
+            {
+              seaux[i] += compteur.seaux[i].load (memory_order_relaxed);
+            }
+        }
+      for (size_t i = 0; i < NOMBRE_SEAUX; ++i)
+        {
+          stat.nombre += seaux[i];
+          if (seaux[i] != 0)
+            {
+              stat.seaux.emplace_back (borneSuperieure (i), seaux[i]);
+            }
+        }
+      if (stat.nombre == 0)
+        {
+          continue;
+        }
+      stat.p50 = centile (seaux, stat.nombre, 0.50);
+      stat.p90 = centile (seaux, stat.nombre, 0.90);
+      stat.p99 = centile (seaux, stat.nombre, 0.99);
+      stat.p999 = centile (seaux, stat.nombre, 0.999);
+      resultats.push_back (move (stat));
+    }
+  return resultats;
+}
+
+
+/**
+ * \brief Produit un tableau lisible des statistiques
+ * \return une ligne par opération : nombre, moyenne, centiles et maximum en ns,
+ *         puis allocations et octets alloués par appel si elles sont comptées
+ */
+std::string exporterTexte()
+{
+  const bool allocations = reqComptabiliteAllocations ();
+  ostringstream os;
+  os << left << setw (32) << "Operation" << right << setw (12) << "Nombre" << setw (12) << "Moyenne"
+     << setw (10) << "p50" << setw (10) << "p90" << setw (10) << "p99" << setw (10) << "p99.9"
+     << setw (12) << "Max";
+  if (allocations)
+    {
+      os << setw (14) << "Allocs/appel" << setw (14) << "Octets/appel";
+    }
+  os << endl;
+  for (const Statistiques& stat : capturer ())
+    {
+      os << left << setw (32) << reqNomOperation (stat.operation) << right << setw (12) << stat.nombre
+         << setw (12) << stat.total / stat.nombre << setw (10) << stat.p50 << setw (10) << stat.p90
+         << setw (10) << stat.p99 << setw (10) << stat.p999 << setw (12) << stat.maximum;
+      if (allocations)
+        {
+          const double nombre = static_cast<double> (stat.nombre);
+          os << fixed << setprecision (2) << setw (14) << static_cast<double> (stat.allocations) / nombre
+             << setw (14) << static_cast<double> (stat.octets) / nombre << defaultfloat;
+        }
+      os << endl;
+    }
+  return os.str ();
+}
+
+
+/**
+ * \brief Produit les statistiques et les histogrammes en JSON
+ * \return un objet {"unite": "ns", "operations": [...]}
+ */
+std::string exporterJson()
+{
+  ostringstream os;
+  os << "{\"unite\":\"ns\",\"operations\":[";
+  bool premiere = true;
+  for (const Statistiques& stat : capturer ())
+    {
+      os << (premiere ? "" : ",") << "{\"nom\":\"" << reqNomOperation (stat.operation) << "\""
+         << ",\"nombre\":" << stat.nombre << ",\"total\":" << stat.total
+         << ",\"maximum\":" << stat.maximum << ",\"p50\":" << stat.p50 << ",\"p90\":" << stat.p90
+         << ",\"p99\":" << stat.p99 << ",\"p999\":" << stat.p999;
+      if (reqComptabiliteAllocations ())
+        {
+          os << ",\"allocations\":" << stat.allocations << ",\"octets\":" << stat.octets
+             << ",\"liberations\":" << stat.liberations;
+        }
+      os << ",\"seaux\":[";
+      for (size_t i = 0; i < stat.seaux.size (); ++i)
+        {
+          os << (i == 0 ? "" : ",") << "[" << stat.seaux[i].first << "," << stat.seaux[i].second << "]";
+        }
+      os << "]}";
+      premiere = false;
+    }
+  os << "]}";
+  return os.str ();
+}
+
+
+/**
+ * \brief Remet tous les compteurs à zéro
+ *        À appeler quand aucun fil ne mesure : une mesure concurrente peut
+ *        survivre à la remise à zéro.
+ */
+void reinitialiser()
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  for (auto& bloc : reg.blocs)
+    {
+      for (CompteurOperation& compteur : bloc->operations)
+        {
+          compteur.total.store (0, memory_order_relaxed);
+          compteur.maximum.store (0, memory_order_relaxed);
+          compteur.allocations.store (0, memory_order_relaxed);
+          compteur.octets.store (0, memory_order_relaxed);
+          compteur.liberations.store (0, memory_order_relaxed);
+          for (auto& seau : compteur.seaux)
+            {
+              seau.store (0, memory_order_relaxed);
+            }
+        }
+    }
+}
+
+} // namespace metriques
@@ -0,0 +1,166 @@
+/**
+ * \file Metriques.h
+ * \brief Compteurs d'appels et histogrammes de latence des opérations de Client et de Compte.
+ *
+ * Chaque fil écrit dans son propre bloc de compteurs, aligné sur les lignes de
+ * cache, sans instruction atomique de lecture-modification-écriture. Les
+ * latences sont rangées dans des histogrammes log-linéaires à la manière de
+ * HdrHistogram : 16 sous-seaux par puissance de deux, soit une précision
+ * relative d'environ 6 % de 1 ns à 2^40 ns.
+ *
+ * Si le programme inclut ComptabiliteAllocations.h, les allocations sur le tas
+ * sont de plus attribuées à l'opération mesurée la plus interne en cours.
+ *
+ * La mesure est désactivée par défaut ; une opération ne coûte alors qu'une
+ * lecture relâchée. La compilation avec BANCAIRE_SANS_METRIQUES retire
+ * complètement les points de mesure.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef METRIQUES_H
+#define METRIQUES_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metriques
+{
+/**
+ * \enum Operation
+ * \brief Opérations publiques mesurées. Les accesseurs triviaux (reqNoCompte,
+ *        reqSolde, ...) ne le sont pas : la mesure coûterait plus que l'appel.
+ */
+enum class Operation : unsigned
+{
+  ClientAjouterCompte,
+  ClientSupprimerCompte,
+  ClientAjouterComptesEnBloc,
+  ClientViderComptes,
+  ClientReqCompte,
+  ClientReqReleves,
+  ClientReqClientFormate,
+  ClientCopie,
+  CompteAsgSolde,
+  CompteAsgTauxInteret,
+  CompteAsgDescription,
+  CompteCalculerInteret,
+  CompteReqCompteFormate,
+  Nombre
+};
+
+const unsigned NOMBRE_OPERATIONS = static_cast<unsigned> (Operation::Nombre);
+
+/**
+ * \struct Statistiques
+ * \brief Agrégat, tous fils confondus, des mesures d'une opération. Durées en nanosecondes.
+ *
+ * Les seaux non vides de l'histogramme sont donnés par (borne supérieure, nombre).
+ * Les allocations, octets et libérations ne sont comptés qu'avec ComptabiliteAllocations.h.
+ */
+struct Statistiques
+{
+  Operation operation;
+  std::uint64_t nombre;
+  std::uint64_t total;
+  std::uint64_t maximum;
+  std::uint64_t p50;
+  std::uint64_t p90;
+  std::uint64_t p99;
+  std::uint64_t p999;
+  std::uint64_t allocations;
+  std::uint64_t octets;
+  std::uint64_t liberations;
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> seaux;
+};
+
+/**
+ * \struct Allocations
+ * \brief Totaux des allocations d'un fil depuis son début.
+ */
+struct Allocations
+{
+  std::uint64_t allocations;
+  std::uint64_t octets;
+  std::uint64_t liberations;
+};
+
+/**
+ * \brief Interrupteur global de la mesure.
+ */
+struct Reglage
+{
+  static inline std::atomic<bool> actives {false};
+};
+
+void asgActives(bool p_actives);
+bool reqActives();
+const char* reqNomOperation(Operation p_operation);
+
+void enregistrer(Operation p_operation, std::uint64_t p_nanosecondes);
+void* debuterOperation(Operation p_operation);
+void terminerOperation(Operation p_operation, std::uint64_t p_nanosecondes, void* p_precedente);
+void compterAllocation(std::size_t p_octets) noexcept;
+void compterLiberation() noexcept;
+bool reqComptabiliteAllocations();
+Allocations reqAllocationsFil();
+std::vector<Statistiques> capturer();
+std::string exporterTexte();
+std::string exporterJson();
+void reinitialiser();
+
+/**
+ * \class Chronometre
+ * \brief Mesure la durée de sa propre portée et l'enregistre pour une opération.
+ */
+class Chronometre
+{
+public:
+  explicit Chronometre (Operation p_operation)
+    : m_operation(p_operation), m_debut(0), m_precedente(nullptr)
+  {
+    if (Reglage::actives.load (std::memory_order_relaxed))
+      {
+        m_precedente = debuterOperation (p_operation);
+        m_debut = maintenant ();
+      }
+  }
+
+  ~Chronometre ()
+  {
+    if (m_debut != 0)
+      {
+        terminerOperation (m_operation, maintenant () - m_debut, m_precedente);
+      }
+  }
+
+  Chronometre (const Chronometre&) = delete;
+  Chronometre& operator= (const Chronometre&) = delete;
+
+private:
+  static std::uint64_t maintenant ()
+  {
+    return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now ().time_since_epoch ()).count ());
+  }
+
+  Operation m_operation;
+  std::uint64_t m_debut;
+  void* m_precedente;
+};
+} // namespace metriques
+
+
+#if !defined(BANCAIRE_SANS_METRIQUES)
+#define MESURER(operation) \
+      metriques::Chronometre chronometre_(metriques::Operation::operation)
+#else
+#define MESURER(operation)
+#endif
+
+#endif /* METRIQUES_H */
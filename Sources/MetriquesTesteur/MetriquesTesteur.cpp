@@ -0,0 +1,153 @@
+/**
+ * \file MetriquesTesteur.cpp
+ * \brief Test unitaire des compteurs et histogrammes de latence.
+ *
+ * À tester :
+ *         void asgActives(bool p_actives);
+ *         std::vector<Statistiques> capturer();
+ *         std::string exporterTexte();
+ *         std::string exporterJson();
+ *         void reinitialiser();
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "Metriques.h"
+#include "Cheque.h"
+#include "Client.h"
+#include "Epargne.h"
+#include <thread>
+#include <vector>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+const metriques::Statistiques*
+trouver (const vector<metriques::Statistiques>& p_statistiques, metriques::Operation p_operation)
+{
+  for (const auto& stat : p_statistiques)
+    {
+      if (stat.operation == p_operation)
+        {
+          return &stat;
+        }
+    }
+  return nullptr;
+}
+} //namespace
+
+
+/**
+ * \brief Création d'une fixture qui part de compteurs vides et désactive la mesure à la fin
+ */
+class MetriquesTest : public ::testing::Test
+{
+public:
+  MetriquesTest():
+  f_client(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983)),
+  f_epargne(1, 1.5, 100.0, "Etudes")
+  {
+    metriques::reinitialiser ();
+  }
+
+  ~MetriquesTest()
+  {
+    metriques::asgActives (false);
+  }
+
+  Client f_client;
+  Epargne f_epargne;
+};
+
+
+/**
+ * \brief Test de la méthode void asgActives(bool p_actives);
+ *     Cas valide : les appels sont comptés seulement quand la mesure est active.
+ *     Cas invalide : aucun
+ */
+TEST_F(MetriquesTest, asgActives_MesureDesactivee_AucunAppelCompte)
+{
+  f_client.ajouterCompte (f_epargne);
+  ASSERT_TRUE(metriques::capturer ().empty ());
+}
+
+TEST_F(MetriquesTest, asgActives_MesureActivee_AppelsComptes)
+{
+  metriques::asgActives (true);
+  f_client.ajouterCompte (f_epargne);
+  f_client.reqCompte (1).asgSolde (250);
+  f_client.reqCompte (1).asgSolde (300);
+  f_client.supprimerCompte (1);
+  metriques::asgActives (false);
+
+  auto statistiques = metriques::capturer ();
+  ASSERT_NE(nullptr, trouver (statistiques, metriques::Operation::ClientAjouterCompte));
+  ASSERT_EQ(1u, trouver (statistiques, metriques::Operation::ClientAjouterCompte)->nombre);
+  ASSERT_EQ(2u, trouver (statistiques, metriques::Operation::CompteAsgSolde)->nombre);
+  ASSERT_EQ(1u, trouver (statistiques, metriques::Operation::ClientSupprimerCompte)->nombre);
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<Statistiques> capturer();
+ *     Cas valides : les mesures de plusieurs fils sont additionnées, les
+ *                   centiles sont croissants, et la remise à zéro vide tout.
+ *     Cas invalide : aucun
+ */
+TEST_F(MetriquesTest, capturer_PlusieursFils_MesuresAdditionnees)
+{
+  metriques::asgActives (true);
+  vector<thread> fils;
+  for (int i = 0; i < 4; ++i)
+    {
+      fils.emplace_back ([] ()
+      {
+        Cheque cheque(1, 5, -100, 4, "Loyer", 1);
+        for (int appel = 0; appel < 1000; ++appel)
+          {
+            cheque.calculerInteret ();
+          }
+      });
+    }
+  for (thread& fil : fils)
+    {
+      fil.join ();
+    }
+  metriques::asgActives (false);
+
+  auto statistiques = metriques::capturer ();
+  const metriques::Statistiques* stat = trouver (statistiques, metriques::Operation::CompteCalculerInteret);
+  ASSERT_NE(nullptr, stat);
+  ASSERT_EQ(4000u, stat->nombre);
+  ASSERT_LE(stat->p50, stat->p90);
+  ASSERT_LE(stat->p90, stat->p99);
+  ASSERT_LE(stat->p99, stat->p999);
+  ASSERT_FALSE(stat->seaux.empty ());
+
+  metriques::reinitialiser ();
+  ASSERT_TRUE(metriques::capturer ().empty ());
+}
+
+
+/**
+ * \brief Test des méthodes std::string exporterTexte(); et std::string exporterJson();
+ *     Cas valide : chaque opération mesurée figure dans les deux exports.
+ *     Cas invalide : aucun
+ */
+TEST_F(MetriquesTest, exporter_OperationMesuree_PresenteDansLesExports)
+{
+  metriques::asgActives (true);
+  f_client.ajouterCompte (f_epargne);
+  f_client.reqReleves ();
+  metriques::asgActives (false);
+
+  string texte = metriques::exporterTexte ();
+  string json = metriques::exporterJson ();
+  ASSERT_NE(string::npos, texte.find ("Client::reqReleves"));
+  ASSERT_NE(string::npos, json.find ("{\"nom\":\"Client::reqReleves\",\"nombre\":1,"));
+  ASSERT_NE(string::npos, json.find ("\"nom\":\"Compte::reqCompteFormate\""));
+  ASSERT_EQ('{', json.front ());
+  ASSERT_EQ('}', json.back ());
+}
@@ -0,0 +1,210 @@
+/**
+ * \file ProjectionInterets.cpp
+ * \brief Implantation de la classe ProjectionInterets
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "ProjectionInterets.h"
+#include "ContratException.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Bornes du taux d'un compte épargne, imposées par Epargne
+ */
+const double TAUX_EPARGNE_MINIMUM = 0.1;
+const double TAUX_EPARGNE_MAXIMUM = 3.5;
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe ProjectionInterets
+ *        On copie les comptes épargne de la table.
+ * \param[in] p_table la table dont on retient les comptes épargne
+ */
+ProjectionInterets::ProjectionInterets(const TableComptes& p_table)
+{
+  const vector<TypeCompte>& types = p_table.reqTypes ();
+  for (size_t i = 0; i < types.size (); ++i)
+    {
+      if (types[i] == TypeCompte::Epargne)
+        {
+          m_folios.push_back (p_table.reqFolios ()[i]);
+          m_numeros.push_back (p_table.reqNumeros ()[i]);
+          m_soldes.push_back (p_table.reqSoldes ()[i]);
+          m_taux.push_back (p_table.reqTaux ()[i]);
+        }
+    }
+}
+
+
+/**
+ * \brief Retourne le nombre de comptes épargne projetés
+ * \return un size_t qui représente le nombre de comptes
+ */
+std::size_t ProjectionInterets::reqNombreComptes() const
+{
+  return m_soldes.size ();
+}
+
+
+/**
+ * \brief Retourne les folios des titulaires, dans l'ordre des projections
+ * \return une référence constante vers la colonne
+ */
+const std::vector<std::int32_t>& ProjectionInterets::reqFolios() const
+{
+  return m_folios;
+}
+
+
+/**
+ * \brief Retourne les numéros des comptes, dans l'ordre des projections
+ * \return une référence constante vers la colonne
+ */
+const std::vector<std::int32_t>& ProjectionInterets::reqNumeros() const
+{
+  return m_numeros;
+}
+
+
+/**
+ * \brief Retourne les soldes actuels des comptes
+ * \return une référence constante vers la colonne
+ */
+const std::vector<double>& ProjectionInterets::reqSoldes() const
+{
+  return m_soldes;
+}
+
+
+/**
+ * \brief Retourne les taux actuels des comptes, en pourcentage par période
+ * \return une référence constante vers la colonne
+ */
+const std::vector<double>& ProjectionInterets::reqTaux() const
+{
+  return m_taux;
+}
+
+
+/**
+ * \brief Projette le solde de chaque compte sous un scénario
+ * \param[in] p_scenario le scénario de taux
+ * \param[in] p_periodes le nombre de périodes de capitalisation
+ * \return le solde projeté de chaque compte, dans l'ordre de reqNumeros
+ * \pre p_periodes >= 0
+ */
+std::vector<double> ProjectionInterets::projeter(const ScenarioTaux& p_scenario, int p_periodes) const
+{
+  PRECONDITION(p_periodes >= 0);
+
+  const size_t nombre = reqNombreComptes ();
+  vector<double> soldesProjetes(nombre);
+  for (size_t debut = 0; debut < nombre; debut += TAILLE_BLOC)
+    {
+      projeterBloc (m_soldes.data () + debut, m_taux.data () + debut, min (TAILLE_BLOC, nombre - debut),
+                    p_scenario.deplacement, p_periodes, soldesProjetes.data () + debut);
+    }
+  return soldesProjetes;
+}
+
+
+/**
+ * \brief Projette la somme des soldes de tous les comptes, pour chaque scénario
+ *        Les soldes projetés ne sont jamais rangés que dans un tampon d'un bloc.
+ * \param[in] p_scenarios les scénarios de taux
+ * \param[in] p_periodes le nombre de périodes de capitalisation
+ * \return la somme des soldes projetés, une par scénario, dans l'ordre des scénarios
+ * \pre p_periodes >= 0
+ */
+std::vector<double> ProjectionInterets::projeterTotaux(const std::vector<ScenarioTaux>& p_scenarios,
+                                                       int p_periodes) const
+{
+  PRECONDITION(p_periodes >= 0);
+
+  const size_t nombre = reqNombreComptes ();
+  vector<double> totaux(p_scenarios.size (), 0.0);
+  double tampon[TAILLE_BLOC];
+  for (size_t debut = 0; debut < nombre; debut += TAILLE_BLOC)
+    {
+      const size_t taille = min (TAILLE_BLOC, nombre - debut);
+      for (size_t scenario = 0; scenario < p_scenarios.size (); ++scenario)
+        {
+          totaux[scenario] += projeterBloc (m_soldes.data () + debut, m_taux.data () + debut, taille,
+                                            p_scenarios[scenario].deplacement, p_periodes, tampon);
+        }
+    }
+  return totaux;
+}
+
+
+/**
+ * \brief Noyau de projection d'un bloc de comptes
+ *        Le facteur (1 + taux / 100)^n est obtenu par exponentiation rapide :
+ *        les bits de n sont communs à tous les comptes, si bien que chaque
+ *        étape est une multiplication élément par élément, sans branchement.
+ *        Le bloc est complété par des comptes de solde nul pour que toutes les
+ *        boucles aient TAILLE_BLOC tours, un nombre connu du compilateur.
+ * \param[in] p_soldes les soldes actuels des comptes
+ * \param[in] p_taux les taux des comptes, en pourcentage par période
+ * \param[in] p_nombre le nombre de comptes du bloc, au plus TAILLE_BLOC
+ * \param[in] p_deplacement les points de pourcentage ajoutés à chaque taux,
+ *            avant de le ramener dans les bornes d'un compte épargne
+ * \param[in] p_periodes le nombre de périodes de capitalisation
+ * \param[out] p_soldesProjetes le solde projeté de chaque compte
+ * \return la somme des soldes projetés du bloc
+ * \pre p_nombre <= TAILLE_BLOC et p_periodes >= 0
+ */
+double ProjectionInterets::projeterBloc(const double* p_soldes, const double* p_taux, std::size_t p_nombre,
+                                        double p_deplacement, int p_periodes, double* p_soldesProjetes)
+{
+  PRECONDITION(p_nombre <= TAILLE_BLOC);
+  PRECONDITION(p_periodes >= 0);
+
+  double soldes[TAILLE_BLOC];
+  double base[TAILLE_BLOC];
+  copy_n (p_soldes, p_nombre, soldes);
+  fill (soldes + p_nombre, soldes + TAILLE_BLOC, 0.0);
+  copy_n (p_taux, p_nombre, base);
+  fill (base + p_nombre, base + TAILLE_BLOC, 0.0);
+  for (size_t i = 0; i < TAILLE_BLOC; ++i)
+    {
+      double taux = base[i] + p_deplacement;
+      taux = taux < TAUX_EPARGNE_MINIMUM ? TAUX_EPARGNE_MINIMUM : taux;
+      taux = taux > TAUX_EPARGNE_MAXIMUM ? TAUX_EPARGNE_MAXIMUM : taux;
+      base[i] = 1.0 + taux / 100;
+    }
+  for (unsigned reste = static_cast<unsigned> (p_periodes); reste != 0; reste >>= 1)
+    {
+      if (reste & 1)
+        {
+          for (size_t i = 0; i < TAILLE_BLOC; ++i)
+            {
+              soldes[i] *= base[i];
+            }
+        }
+      for (size_t i = 0; i < TAILLE_BLOC; ++i)
+        {
+          base[i] *= base[i];
+        }
+    }
+  copy_n (soldes, p_nombre, p_soldesProjetes);
+
+  double somme[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < TAILLE_BLOC; i += 4)
+    {
+      for (size_t k = 0; k < 4; ++k)
+        {
+          somme[k] += soldes[i + k];
+        }
+    }
+  return (somme[0] + somme[1]) + (somme[2] + somme[3]);
+}
+
+} //namespace bancaire
@@ -0,0 +1,78 @@
+/**
+ * \file ProjectionInterets.h
+ * \brief Fichier qui contient l'interface de la classe ProjectionInterets et de ses scénarios.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef PROJECTIONINTERETS_H
+#define PROJECTIONINTERETS_H
+
+#include "TableComptes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \struct ScenarioTaux
+ * \brief Scénario de taux d'une projection : le déplacement, en points de
+ *        pourcentage, est ajouté au taux de chaque compte épargne, puis le
+ *        résultat est ramené dans les bornes [0.1, 3.5] d'un compte épargne.
+ *
+ * Les déplacements des taux et des taux minimums des comptes chèque ne
+ * servent qu'à SimulationTaux ; ProjectionInterets les ignore.
+ */
+struct ScenarioTaux
+{
+  double deplacement = 0;
+  double deplacementCheque = 0;
+  double deplacementMinimumCheque = 0;
+};
+
+/**
+ * \class ProjectionInterets
+ * \brief Projette les soldes des comptes épargne capitalisés sur plusieurs
+ *        périodes, sous un ou plusieurs scénarios de taux.
+ *
+ * Comme Epargne::calculerInteret, le taux d'un compte est un pourcentage par
+ * période : après n périodes, le solde vaut solde * (1 + taux / 100)^n. Ce
+ * facteur de croissance est calculé en forme close, par exponentiation
+ * rapide : O(log n) multiplications, quel que soit le nombre de périodes.
+ *
+ * Les soldes et les taux des comptes épargne sont copiés de la table en deux
+ * colonnes contiguës, traitées par blocs qui tiennent dans le cache L1. Dans
+ * un bloc, chaque étape de l'exponentiation est une boucle sans branchement
+ * sur tous les comptes : les mêmes instructions s'appliquent à tous les
+ * comptes, et le compilateur les vectorise.
+ */
+class ProjectionInterets
+{
+public:
+  static constexpr std::size_t TAILLE_BLOC = 512;
+
+  explicit ProjectionInterets(const TableComptes& p_table);
+
+  //accesseurs
+  std::size_t reqNombreComptes() const;
+  const std::vector<std::int32_t>& reqFolios() const;
+  const std::vector<std::int32_t>& reqNumeros() const;
+  const std::vector<double>& reqSoldes() const;
+  const std::vector<double>& reqTaux() const;
+
+  //methodes
+  std::vector<double> projeter(const ScenarioTaux& p_scenario, int p_periodes) const;
+  std::vector<double> projeterTotaux(const std::vector<ScenarioTaux>& p_scenarios, int p_periodes) const;
+  static double projeterBloc(const double* p_soldes, const double* p_taux, std::size_t p_nombre,
+                             double p_deplacement, int p_periodes, double* p_soldesProjetes);
+
+private:
+  std::vector<std::int32_t> m_folios;
+  std::vector<std::int32_t> m_numeros;
+  std::vector<double> m_soldes;
+  std::vector<double> m_taux;
+};
+
+} //namespace bancaire
+
+#endif /* PROJECTIONINTERETS_H */
@@ -0,0 +1,129 @@
+/**
+ * \file ProjectionInteretsTesteur.cpp
+ * \brief Test unitaire de la classe ProjectionInterets.
+ *
+ * À tester :
+ *         ProjectionInterets(const TableComptes& p_table);
+ *         std::vector<double> projeter(const ScenarioTaux& p_scenario, int p_periodes) const;
+ *         std::vector<double> projeterTotaux(const std::vector<ScenarioTaux>& p_scenarios, int p_periodes) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ProjectionInterets.h"
+#include "Cheque.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "GenerateurCharge.h"
+#include <cmath>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : trois comptes épargne et un compte chèque
+ */
+class ProjectionInteretsTest : public ::testing::Test
+{
+public:
+  ProjectionInteretsTest()
+  {
+    Client client1(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983));
+    client1.ajouterCompte (Epargne(1, 2, 1000, "Etudes"));
+    client1.ajouterCompte (Cheque(2, 10, -150, 4, "Loyer", 1));
+    Client client2(2000, "Carlo", "Ancelotti", "590 234-0342", util::Date(20, 1, 1983));
+    client2.ajouterCompte (Epargne(1, 0.5, 200, "Voyage"));
+    client2.ajouterCompte (Epargne(2, 3.5, 0, "Retraite"));
+    Banque banque;
+    banque.ajouterClient (client1);
+    banque.ajouterClient (client2);
+    f_table = TableComptes(banque);
+  }
+
+  TableComptes f_table;
+};
+
+
+/**
+ * \brief Test du constructeur ProjectionInterets(const TableComptes& p_table);
+ *     Cas valide : seuls les comptes épargne sont retenus, avec leur titulaire.
+ *     Cas invalide : aucun
+ */
+TEST_F(ProjectionInteretsTest, constructeur_Table_ComptesEpargneSeulement)
+{
+  ProjectionInterets projection(f_table);
+  ASSERT_EQ(3u, projection.reqNombreComptes ());
+  ASSERT_EQ((vector<int32_t> {1000, 2000, 2000}), projection.reqFolios ());
+  ASSERT_EQ((vector<int32_t> {1, 1, 2}), projection.reqNumeros ());
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<double> projeter(const ScenarioTaux& p_scenario, int p_periodes) const;
+ *     Cas valides : le solde projeté vaut solde * (1 + taux / 100)^n ; une
+ *                   période égale le solde plus calculerInteret ; zéro période
+ *                   rend le solde ; le déplacement est borné à [0.1, 3.5].
+ *     Cas invalide : un nombre de périodes négatif est refusé.
+ */
+TEST_F(ProjectionInteretsTest, projeter_CapitalisationComposee_FormeClose)
+{
+  ProjectionInterets projection(f_table);
+  vector<double> soldes = projection.projeter (ScenarioTaux(), 120);
+  ASSERT_NEAR(1000 * pow (1.02, 120), soldes[0], 1e-9);
+  ASSERT_NEAR(200 * pow (1.005, 120), soldes[1], 1e-9);
+  ASSERT_EQ(0, soldes[2]);
+
+  ASSERT_NEAR(1000 + Epargne(1, 2, 1000, "Etudes").calculerInteret (), projection.projeter (ScenarioTaux(), 1)[0],
+              1e-9);
+  ASSERT_EQ(projection.reqSoldes (), projection.projeter (ScenarioTaux(), 0));
+}
+
+TEST_F(ProjectionInteretsTest, projeter_DeplacementHorsBornes_TauxBorne)
+{
+  ProjectionInterets projection(f_table);
+  ScenarioTaux hausse;
+  hausse.deplacement = 1;
+  vector<double> soldes = projection.projeter (hausse, 10);
+  ASSERT_NEAR(1000 * pow (1.03, 10), soldes[0], 1e-9);
+  ScenarioTaux baisse;
+  baisse.deplacement = -5;
+  ASSERT_NEAR(200 * pow (1.001, 10), projection.projeter (baisse, 10)[1], 1e-9);
+}
+
+TEST_F(ProjectionInteretsTest, projeter_PeriodesNegatives_PreconditionException)
+{
+  ProjectionInterets projection(f_table);
+  ASSERT_THROW(projection.projeter (ScenarioTaux(), -1), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<double> projeterTotaux(const std::vector<ScenarioTaux>& p_scenarios, int p_periodes) const;
+ *     Cas valide : sur une population de plusieurs blocs, chaque total est la
+ *                  somme des soldes projetés compte par compte.
+ *     Cas invalide : aucun
+ */
+TEST(ProjectionInterets, projeterTotaux_PopulationSynthetique_SommeDesProjections)
+{
+  ParametresCharge parametres;
+  parametres.nombreComptes = 5000;
+  ProjectionInterets projection(TableComptes(GenerateurCharge(parametres).construireBanque ()));
+  ASSERT_GT(projection.reqNombreComptes (), ProjectionInterets::TAILLE_BLOC);
+
+  vector<ScenarioTaux> scenarios(3);
+  scenarios[1].deplacement = 0.5;
+  scenarios[2].deplacement = -0.25;
+  vector<double> totaux = projection.projeterTotaux (scenarios, 60);
+  ASSERT_EQ(3u, totaux.size ());
+  for (size_t s = 0; s < scenarios.size (); ++s)
+    {
+      double attendu = 0;
+      for (double solde : projection.projeter (scenarios[s], 60))
+        {
+          attendu += solde;
+        }
+      ASSERT_NEAR(attendu, totaux[s], 1e-9 * attendu);
+    }
+  ASSERT_GT(totaux[1], totaux[0]);
+  ASSERT_LT(totaux[2], totaux[0]);
+}
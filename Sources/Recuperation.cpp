@@ -0,0 +1,398 @@
+/**
+ * \file Recuperation.cpp
+ * \brief Implantation de la classe Recuperation
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "Recuperation.h"
+#include "ArenaComptes.h"
+#include "Cheque.h"
+#include "CompteException.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "Journal.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+const size_t TAILLE_ENTETE = 2 * sizeof (uint32_t);
+
+/**
+ * \brief État final d'un compte après repli de ses mutations
+ */
+struct EtatCompte
+{
+  bool actif;
+  TypeOperation type;
+  int noCompte;
+  int nombreTransactions;
+  double solde;
+  double tauxInteret;
+  double tauxInteretMinimum;
+  string description;
+};
+
+/**
+ * \brief État final d'un client après repli de ses mutations
+ *        Les comptes gardent l'ordre d'ajout du portefeuille.
+ */
+struct EtatClient
+{
+  EnregistrementJournal creation;
+  vector<EtatCompte> comptes;
+  unordered_map<int, size_t> indices;
+};
+
+/**
+ * \brief Travail d'un fil : les positions des enregistrements de sa partition
+ *        et les clients reconstruits.
+ */
+struct Partition
+{
+  vector<uint64_t> positions;
+  vector<Client> clients;
+  size_t nombreEnregistrements = 0;
+  size_t nombreIgnores = 0;
+  uint64_t premiereErreur = UINT64_MAX;
+  exception_ptr erreur;
+};
+
+
+/**
+ * \brief Replie une mutation sur l'état des clients d'une partition
+ * \return faux si la mutation ne s'applique à aucun état connu, ou ne convient
+ *         pas au compte visé (verifierMutationCompte)
+ */
+bool
+replier (unordered_map<int, EtatClient>& p_etats, const EnregistrementJournal& p_enregistrement)
+{
+  if (p_enregistrement.type == TypeOperation::AjoutClient)
+    {
+      EtatClient etat;
+      etat.creation = p_enregistrement;
+      return p_etats.emplace (p_enregistrement.noFolio, move (etat)).second;
+    }
+
+  auto client = p_etats.find (p_enregistrement.noFolio);
+  if (client == p_etats.end ())
+    {
+      return false;
+    }
+  EtatClient& etat = client->second;
+
+  if (p_enregistrement.type == TypeOperation::AjoutCheque
+      || p_enregistrement.type == TypeOperation::AjoutEpargne)
+    {
+      if (etat.indices.count (p_enregistrement.noCompte) != 0)
+        {
+          return false;
+        }
+      etat.indices.emplace (p_enregistrement.noCompte, etat.comptes.size ());
+      etat.comptes.push_back (EtatCompte {true, p_enregistrement.type, p_enregistrement.noCompte,
+                                          p_enregistrement.nombreTransactions, p_enregistrement.solde,
+                                          p_enregistrement.tauxInteret,
+                                          p_enregistrement.tauxInteretMinimum,
+                                          p_enregistrement.description});
+      return true;
+    }
+
+  auto indice = etat.indices.find (p_enregistrement.noCompte);
+  if (indice == etat.indices.end ())
+    {
+      return false;
+    }
+  EtatCompte& compte = etat.comptes[indice->second];
+  try
+    {
+      verifierMutationCompte (p_enregistrement, compte.type, compte.tauxInteretMinimum);
+    }
+  catch (const CompteException&)
+    {
+      return false;
+    }
+  switch (p_enregistrement.type)
+    {
+    case TypeOperation::SuppressionCompte:
+      compte.actif = false;
+      etat.indices.erase (indice);
+      break;
+    case TypeOperation::AsgSolde:
+      compte.solde = p_enregistrement.solde;
+      break;
+    case TypeOperation::AsgTauxInteret:
+      compte.tauxInteret = p_enregistrement.tauxInteret;
+      break;
+    case TypeOperation::AsgNombreTransactions:
+      compte.nombreTransactions = p_enregistrement.nombreTransactions;
+      break;
+    case TypeOperation::AsgDescription:
+      compte.description = p_enregistrement.description;
+      break;
+    default:
+      return false;
+    }
+  return true;
+}
+
+
+/**
+ * \brief Construit un client et son portefeuille à partir de son état final
+ */
+Client
+construireClient (const EtatClient& p_etat)
+{
+  const EnregistrementJournal& creation = p_etat.creation;
+  Client client(creation.noFolio, creation.nom, creation.prenom, creation.telephone,
+                util::Date(creation.jour, creation.mois, creation.annee));
+
+  vector<unique_ptr<Compte>> comptes;
+  comptes.reserve (p_etat.indices.size ());
+  for (const EtatCompte& compte : p_etat.comptes)
+    {
+      if (!compte.actif)
+        {
+          continue;
+        }
+      if (compte.type == TypeOperation::AjoutCheque)
+        {
+          comptes.push_back (make_unique<Cheque>(compte.noCompte, compte.nombreTransactions,
+                                                 compte.solde, compte.tauxInteret,
+                                                 compte.description, compte.tauxInteretMinimum));
+        }
+      else
+        {
+          comptes.push_back (make_unique<Epargne>(compte.noCompte, compte.tauxInteret,
+                                                  compte.solde, compte.description));
+        }
+    }
+  client.ajouterComptesEnBloc (move (comptes));
+  return client;
+}
+
+
+/**
+ * \brief Relit les enregistrements d'une partition qui précèdent p_limite
+ *        et reconstruit ses clients.
+ */
+void
+rejouerPartition (const string& p_journal, uint64_t p_limite, Partition& p_partition)
+{
+  TRACE_SCOPE("Recuperation::rejouerPartition");
+  try
+    {
+      unordered_map<int, EtatClient> etats;
+      EnregistrementJournal enregistrement;
+      for (uint64_t position : p_partition.positions)
+        {
+          if (position >= p_limite)
+            {
+              break;
+            }
+          if (decoderEnregistrement (p_journal.data () + position, p_journal.size () - position,
+                                     enregistrement) == 0)
+            {
+              p_partition.premiereErreur = position;
+              break;
+            }
+          ++p_partition.nombreEnregistrements;
+          if (!replier (etats, enregistrement))
+            {
+              ++p_partition.nombreIgnores;
+            }
+        }
+      if (p_partition.premiereErreur != UINT64_MAX)
+        {
+          return; // la relecture sera reprise avec une limite plus basse
+        }
+      // Les comptes d'une partition partagent une arène : la banque récupérée
+      // rendra leur mémoire d'un coup au lieu de compte par compte.
+      ArenaComptes::Reference arena = ArenaComptes::creer ();
+      ArenaComptes::Portee portee(*arena);
+      p_partition.clients.reserve (etats.size ());
+      for (const auto& etat : etats)
+        {
+          p_partition.clients.push_back (construireClient (etat.second));
+        }
+    }
+  catch (...)
+    {
+      p_partition.erreur = current_exception ();
+    }
+}
+
+
+/**
+ * \brief Exécute la relecture de toutes les partitions en parallèle
+ */
+void
+rejouerPartitions (const string& p_journal, uint64_t p_limite, vector<Partition>& p_partitions)
+{
+  vector<thread> fils;
+  fils.reserve (p_partitions.size ());
+  for (Partition& partition : p_partitions)
+    {
+      partition.clients.clear ();
+      partition.nombreEnregistrements = 0;
+      partition.nombreIgnores = 0;
+      partition.premiereErreur = UINT64_MAX;
+      fils.emplace_back (rejouerPartition, cref (p_journal), p_limite, ref (partition));
+    }
+  for (thread& fil : fils)
+    {
+      fil.join ();
+    }
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe Recuperation
+ * \param[in] p_nombreFils nombre de fils de relecture, 0 pour utiliser tous les cœurs
+ */
+Recuperation::Recuperation(unsigned p_nombreFils):
+        m_nombreFils(p_nombreFils != 0 ? p_nombreFils : max (1u, thread::hardware_concurrency ())),
+        m_nombreEnregistrements(0), m_nombreIgnores(0), m_tailleValide(0)
+{
+  POSTCONDITION(m_nombreFils>0);
+}
+
+
+/**
+ * \brief Retourne le nombre de fils de relecture
+ * \return un entier qui représente le nombre de partitions du journal
+ */
+unsigned Recuperation::reqNombreFils() const
+{
+  return m_nombreFils;
+}
+
+
+/**
+ * \brief Retourne le nombre d'enregistrements relus lors de la dernière récupération
+ * \return un size_t qui représente le nombre d'enregistrements valides
+ */
+std::size_t Recuperation::reqNombreEnregistrements() const
+{
+  return m_nombreEnregistrements;
+}
+
+
+/**
+ * \brief Retourne le nombre d'enregistrements valides qui ne s'appliquaient à
+ *        aucun client ou compte connu lors de la dernière récupération
+ * \return un size_t qui représente le nombre d'enregistrements ignorés
+ */
+std::size_t Recuperation::reqNombreIgnores() const
+{
+  return m_nombreIgnores;
+}
+
+
+/**
+ * \brief Retourne la taille du préfixe valide du journal lors de la dernière récupération
+ * \return un entier qui représente la position de fin du dernier enregistrement valide
+ */
+std::uint64_t Recuperation::reqTailleValide() const
+{
+  return m_tailleValide;
+}
+
+
+/**
+ * \brief Reconstruit la banque décrite par un journal des transactions
+ * \param[in] p_cheminJournal chemin du journal ; un journal absent donne une banque vide
+ * \return la banque reconstruite, sans journal associé
+ * \exception std::system_error si le journal ne peut pas être tronqué
+ * \exception ContratException si l'état final d'un client ou d'un compte est invalide
+ */
+Banque Recuperation::recuperer(const std::string& p_cheminJournal)
+{
+  TRACE_SCOPE("Recuperation::recuperer");
+  m_nombreEnregistrements = 0;
+  m_nombreIgnores = 0;
+  m_tailleValide = 0;
+
+  string journal;
+  {
+    ifstream fichier(p_cheminJournal, ios::binary);
+    if (!fichier)
+      {
+        return Banque();
+      }
+    journal.assign (istreambuf_iterator<char>(fichier), istreambuf_iterator<char>());
+  }
+
+  // Répartition structurelle : seules les longueurs et le folio sont lus ici,
+  // les sommes de contrôle sont vérifiées en parallèle par les fils.
+  vector<Partition> partitions(m_nombreFils);
+  uint64_t position = 0;
+  const size_t positionFolio = TAILLE_ENTETE + sizeof (uint8_t);
+  while (position + positionFolio + sizeof (int32_t) <= journal.size ())
+    {
+      uint32_t taille = 0;
+      int32_t noFolio = 0;
+      memcpy (&taille, journal.data () + position, sizeof (taille));
+      if (journal.size () - position - TAILLE_ENTETE < taille)
+        {
+          break;
+        }
+      memcpy (&noFolio, journal.data () + position + positionFolio, sizeof (noFolio));
+      partitions[static_cast<uint32_t> (noFolio) % m_nombreFils].positions.push_back (position);
+      position += TAILLE_ENTETE + taille;
+    }
+  uint64_t limite = position;
+
+  rejouerPartitions (journal, limite, partitions);
+  uint64_t premiereErreur = limite;
+  for (const Partition& partition : partitions)
+    {
+      premiereErreur = min (premiereErreur, partition.premiereErreur);
+    }
+  if (premiereErreur < limite)
+    {
+      // Un enregistrement corrompu termine le journal : on rejoue tout ce qui le précède.
+      limite = premiereErreur;
+      rejouerPartitions (journal, limite, partitions);
+    }
+
+  Banque banque;
+  for (Partition& partition : partitions)
+    {
+      if (partition.erreur)
+        {
+          rethrow_exception (partition.erreur);
+        }
+      m_nombreEnregistrements += partition.nombreEnregistrements;
+      m_nombreIgnores += partition.nombreIgnores;
+      for (Client& client : partition.clients)
+        {
+          banque.ajouterClient (move (client));
+        }
+    }
+
+  m_tailleValide = limite;
+  TRACE_COUNT("enregistrements relus", m_nombreEnregistrements);
+  if (m_tailleValide < journal.size ()
+      && ::truncate (p_cheminJournal.c_str (), static_cast<off_t> (m_tailleValide)) != 0)
+    {
+      throw system_error(errno, generic_category (), "Troncature du journal " + p_cheminJournal);
+    }
+  return banque;
+}
+
+} //namespace bancaire
@@ -0,0 +1,52 @@
+/**
+ * \file Recuperation.h
+ * \brief Fichier qui contient l'interface de la classe Recuperation.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef RECUPERATION_H
+#define RECUPERATION_H
+
+#include "Banque.h"
+#include <cstdint>
+#include <string>
+
+namespace bancaire
+{
+/**
+ * \class Recuperation
+ * \brief Reconstruit une Banque à partir du journal des transactions après un arrêt.
+ *
+ * Les enregistrements sont répartis par numéro de folio entre plusieurs fils,
+ * ce qui conserve l'ordre des mutations de chaque client. Chaque fil replie les
+ * mutations d'un client sur un état simple, sans passer par les mutateurs ni
+ * leurs vérifications de contrat, puis construit une seule fois chaque compte
+ * dans son état final et remplit le portefeuille en bloc. Les comptes d'une
+ * même partition sont alloués dans une ArenaComptes.
+ *
+ * Le journal est relu jusqu'au premier enregistrement incomplet ou corrompu,
+ * puis tronqué à cette position pour que les ajouts suivants restent lisibles.
+ */
+class Recuperation
+{
+public:
+  explicit Recuperation(unsigned p_nombreFils=0);
+
+  //accesseurs
+  unsigned reqNombreFils() const;
+  std::size_t reqNombreEnregistrements() const;
+  std::size_t reqNombreIgnores() const;
+  std::uint64_t reqTailleValide() const;
+
+  //methodes
+  Banque recuperer(const std::string& p_cheminJournal);
+
+private:
+  unsigned m_nombreFils;
+  std::size_t m_nombreEnregistrements;
+  std::size_t m_nombreIgnores;
+  std::uint64_t m_tailleValide;
+};
+} //namespace bancaire
+
+#endif /* RECUPERATION_H */
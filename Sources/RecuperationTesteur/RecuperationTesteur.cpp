@@ -0,0 +1,156 @@
+/**
+ * \file RecuperationTesteur.cpp
+ * \brief Test unitaire de la classe Recuperation.
+ *
+ * À tester :
+ *         Recuperation(unsigned p_nombreFils);
+ *         Banque recuperer(const std::string& p_cheminJournal);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "Banque.h"
+#include "Cheque.h"
+#include "Epargne.h"
+#include "GroupeValidation.h"
+#include "Journal.h"
+#include "Recuperation.h"
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Fixture qui produit un journal à partir de mutations exécutées sur une banque
+ */
+class RecuperationTest : public ::testing::Test
+{
+public:
+  RecuperationTest():
+  chemin("/tmp/RecuperationTesteur_" + to_string (::getpid ()) + ".journal")
+  {
+    remove (chemin.c_str ());
+    GroupeValidation journal(chemin, 64, chrono::microseconds(100));
+    original.asgJournal (&journal);
+    for (int folio = 1000; folio < 1040; ++folio)
+      {
+        original.executer (enregistrementAjoutClient (
+                Client(folio, "Jean", "Marie", "418 567-4213", util::Date(2, 3, 1980))));
+        for (int no = 1; no <= 5; ++no)
+          {
+            original.executer (enregistrementAjoutCompte (folio, Epargne(no, 1.5, 100 * no, "Etudes")));
+          }
+        original.executer (enregistrementAjoutCompte (folio, Cheque(10, 5, -20, 4, "Loyer", 1)));
+
+        EnregistrementJournal mutation;
+        mutation.noFolio = folio;
+        mutation.type = TypeOperation::SuppressionCompte;
+        mutation.noCompte = 2;
+        original.executer (mutation);
+        mutation.type = TypeOperation::AsgSolde;
+        mutation.noCompte = 3;
+        mutation.solde = folio;
+        original.executer (mutation);
+        mutation.type = TypeOperation::AsgDescription;
+        mutation.noCompte = 10;
+        mutation.description = "Courant";
+        original.executer (mutation);
+      }
+    original.asgJournal (nullptr);
+  }
+
+  ~RecuperationTest()
+  {
+    remove (chemin.c_str ());
+  }
+
+  void comparer(const Banque& p_recuperee) const
+  {
+    ASSERT_EQ(original.reqNombreClients (), p_recuperee.reqNombreClients ());
+    for (const auto& client : original.reqClients ())
+      {
+        ASSERT_EQ(client.second.reqReleves (), p_recuperee.reqClient (client.first).reqReleves ());
+      }
+  }
+
+  string chemin;
+  Banque original;
+};
+
+
+/**
+ * \brief Test de la méthode Banque recuperer(const std::string& p_cheminJournal);
+ *     Cas valides : la banque récupérée est identique à l'originale, quel que
+ *                   soit le nombre de fils ; un journal absent donne une banque vide.
+ *     Cas limites : un enregistrement tronqué en fin de journal est ignoré et retiré.
+ */
+TEST_F(RecuperationTest, recuperer_JournalComplet_BanqueIdentique)
+{
+  for (unsigned nombreFils : {1u, 3u, 8u})
+    {
+      Recuperation recuperation(nombreFils);
+      comparer (recuperation.recuperer (chemin));
+      ASSERT_EQ(40u * 10u, recuperation.reqNombreEnregistrements ());
+      ASSERT_EQ(0u, recuperation.reqNombreIgnores ());
+    }
+}
+
+TEST_F(RecuperationTest, recuperer_JournalAbsent_BanqueVide)
+{
+  Recuperation recuperation(2);
+  ASSERT_EQ(0u, recuperation.recuperer (chemin + ".absent").reqNombreClients ());
+}
+
+TEST_F(RecuperationTest, recuperer_FinTronquee_JournalTronque)
+{
+  uint64_t tailleComplete = 0;
+  {
+    ifstream fichier(chemin, ios::binary | ios::ate);
+    tailleComplete = static_cast<uint64_t> (fichier.tellg ());
+  }
+  {
+    EnregistrementJournal solde;
+    solde.type = TypeOperation::AsgSolde;
+    solde.noFolio = 1000;
+    solde.noCompte = 1;
+    solde.solde = 999;
+    string encode;
+    encoderEnregistrement (solde, encode);
+    ofstream fichier(chemin, ios::binary | ios::app);
+    fichier.write (encode.data (), static_cast<streamsize> (encode.size () - 3));
+  }
+
+  Recuperation recuperation(4);
+  comparer (recuperation.recuperer (chemin));
+  ASSERT_EQ(tailleComplete, recuperation.reqTailleValide ());
+  ifstream fichier(chemin, ios::binary | ios::ate);
+  ASSERT_EQ(tailleComplete, static_cast<uint64_t> (fichier.tellg ()));
+}
+
+
+/**
+ * \brief Test de la méthode Banque recuperer(const std::string& p_cheminJournal);
+ *     Cas invalide : une mutation bien formée mais qui ne convient pas au compte
+ *                    visé (solde négatif d'un compte épargne) est ignorée.
+ */
+TEST_F(RecuperationTest, recuperer_MutationIncompatibleAvecLeCompte_Ignoree)
+{
+  {
+    EnregistrementJournal solde;
+    solde.type = TypeOperation::AsgSolde;
+    solde.noFolio = 1000;
+    solde.noCompte = 1;
+    solde.solde = -50;
+    string encode;
+    encoderEnregistrement (solde, encode);
+    ofstream fichier(chemin, ios::binary | ios::app);
+    fichier.write (encode.data (), static_cast<streamsize> (encode.size ()));
+  }
+
+  Recuperation recuperation(2);
+  comparer (recuperation.recuperer (chemin));
+  ASSERT_EQ(40u * 10u + 1u, recuperation.reqNombreEnregistrements ());
+  ASSERT_EQ(1u, recuperation.reqNombreIgnores ());
+}
@@ -0,0 +1,566 @@
+/**
+ * \file ServeurLocal.cpp
+ * \brief Implantation de la classe ServeurLocal et de l'encodage de son protocole
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "ServeurLocal.h"
+#include "ContratException.h"
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <system_error>
+#include <unistd.h>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace bancaire
+{
+namespace
+{
+const size_t TAILLE_LONGUEUR = sizeof (uint32_t);
+const size_t TAILLE_ENTETE = sizeof (uint32_t) + sizeof (uint8_t);
+const size_t TAILLE_LECTURE = 64 * 1024;
+
+template<typename T>
+void
+ecrireValeur (string& p_tampon, T p_valeur)
+{
+  p_tampon.append (reinterpret_cast<const char*> (&p_valeur), sizeof (T));
+}
+
+
+template<typename T>
+T
+lireValeur (const char* p_donnees)
+{
+  T valeur;
+  memcpy (&valeur, p_donnees, sizeof (T));
+  return valeur;
+}
+
+
+/**
+ * \brief Réserve le champ de longueur d'une trame et écrit son en-tête
+ * \return la position du champ de longueur, à compléter par fermerTrame
+ */
+size_t
+ouvrirTrame (string& p_tampon, uint32_t p_identifiant, uint8_t p_octet)
+{
+  const size_t debut = p_tampon.size ();
+  p_tampon.append (TAILLE_LONGUEUR, '\0');
+  ecrireValeur (p_tampon, p_identifiant);
+  ecrireValeur (p_tampon, p_octet);
+  return debut;
+}
+
+
+void
+fermerTrame (string& p_tampon, size_t p_debut)
+{
+  const uint32_t longueur = static_cast<uint32_t> (p_tampon.size () - p_debut - TAILLE_LONGUEUR);
+  memcpy (&p_tampon[p_debut], &longueur, sizeof (longueur));
+}
+} //namespace
+
+
+/**
+ * \brief Ajoute à un tampon une requête portant une mutation de la banque
+ * \param[in] p_identifiant l'identifiant rendu avec la réponse
+ * \param[in] p_operation la mutation à exécuter
+ * \param[in,out] p_tampon le tampon auquel la trame est ajoutée
+ */
+void
+encoderRequeteOperation (std::uint32_t p_identifiant, const EnregistrementJournal& p_operation,
+                         std::string& p_tampon)
+{
+  const size_t debut = ouvrirTrame (p_tampon, p_identifiant, static_cast<uint8_t> (NatureRequete::Operation));
+  encoderEnregistrement (p_operation, p_tampon);
+  fermerTrame (p_tampon, debut);
+}
+
+
+/**
+ * \brief Ajoute à un tampon une requête de relevé d'un client
+ * \param[in] p_identifiant l'identifiant rendu avec la réponse
+ * \param[in] p_noFolio le folio du client
+ * \param[in,out] p_tampon le tampon auquel la trame est ajoutée
+ */
+void
+encoderRequeteReleve (std::uint32_t p_identifiant, int p_noFolio, std::string& p_tampon)
+{
+  const size_t debut = ouvrirTrame (p_tampon, p_identifiant, static_cast<uint8_t> (NatureRequete::Releve));
+  ecrireValeur<int32_t> (p_tampon, p_noFolio);
+  fermerTrame (p_tampon, debut);
+}
+
+
+/**
+ * \brief Décode une réponse à partir du début d'un bloc de données
+ * \param[in] p_donnees pointeur vers le début de la réponse
+ * \param[in] p_taille nombre d'octets disponibles à partir de p_donnees
+ * \param[out] p_reponse la réponse décodée
+ * \return le nombre d'octets consommés, ou 0 si la réponse est incomplète
+ */
+std::size_t
+decoderReponse (const char* p_donnees, std::size_t p_taille, Reponse& p_reponse)
+{
+  if (p_taille < TAILLE_LONGUEUR)
+    {
+      return 0;
+    }
+  const uint32_t longueur = lireValeur<uint32_t> (p_donnees);
+  if (longueur < TAILLE_ENTETE || p_taille - TAILLE_LONGUEUR < longueur)
+    {
+      return 0;
+    }
+  const char* trame = p_donnees + TAILLE_LONGUEUR;
+  p_reponse.identifiant = lireValeur<uint32_t> (trame);
+  p_reponse.statut = static_cast<StatutReponse> (lireValeur<uint8_t> (trame + sizeof (uint32_t)));
+  p_reponse.corps.assign (trame + TAILLE_ENTETE, longueur - TAILLE_ENTETE);
+  return TAILLE_LONGUEUR + longueur;
+}
+
+
+/**
+ * \brief Constructeur de la classe ServeurLocal
+ *        Crée le socket d'écoute et démarre le fil du serveur. Un fichier
+ *        déjà présent au chemin donné est remplacé.
+ * \param[in] p_banque la banque servie ; seul le serveur doit y toucher tant qu'il existe
+ * \param[in] p_chemin le chemin du socket
+ * \pre p_chemin ne doit pas être vide et doit tenir dans une sockaddr_un
+ * \exception std::system_error si le socket ne peut pas être créé ou lié
+ */
+ServeurLocal::ServeurLocal(Banque& p_banque, const std::string& p_chemin) :
+        m_banque(p_banque), m_chemin(p_chemin), m_ecoute(-1), m_reveil{-1, -1}, m_arret(false),
+        m_nombreRequetes(0), m_nombreLots(0)
+{
+  sockaddr_un adresse {};
+  PRECONDITION(!p_chemin.empty ());
+  PRECONDITION(p_chemin.size () < sizeof (adresse.sun_path));
+
+  adresse.sun_family = AF_UNIX;
+  memcpy (adresse.sun_path, p_chemin.c_str (), p_chemin.size () + 1);
+  if (::pipe2 (m_reveil, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+      throw system_error(errno, generic_category (), "Creation du tube de reveil");
+    }
+  m_ecoute = ::socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+  ::unlink (p_chemin.c_str ());
+  if (m_ecoute < 0
+      || ::bind (m_ecoute, reinterpret_cast<const sockaddr*> (&adresse), sizeof (adresse)) != 0
+      || ::listen (m_ecoute, SOMAXCONN) != 0)
+    {
+      int erreur = errno;
+      if (m_ecoute >= 0)
+        {
+          ::close (m_ecoute);
+        }
+      ::close (m_reveil[0]);
+      ::close (m_reveil[1]);
+      throw system_error(erreur, generic_category (), "Ecoute sur " + p_chemin);
+    }
+  m_fil = thread(&ServeurLocal::boucle, this);
+  m_filAcquittements = thread(&ServeurLocal::boucleAcquittements, this);
+
+  POSTCONDITION(m_ecoute>=0);
+}
+
+
+/**
+ * \brief Destructeur de la classe ServeurLocal
+ *        Arrête les fils du serveur, ferme les connexions et retire le socket.
+ *        Les réponses encore en attente du journal ne sont pas envoyées.
+ */
+ServeurLocal::~ServeurLocal()
+{
+  {
+    lock_guard<mutex> verrou(m_mutexAcquittements);
+    m_arret.store (true);
+  }
+  m_conditionAcquittements.notify_one ();
+  reveiller ();
+  m_fil.join ();
+  m_filAcquittements.join ();
+  ::close (m_ecoute);
+  ::close (m_reveil[0]);
+  ::close (m_reveil[1]);
+  ::unlink (m_chemin.c_str ());
+}
+
+
+/**
+ * \brief Retourne le chemin du socket d'écoute
+ * \return une référence constante vers le chemin
+ */
+const std::string& ServeurLocal::reqChemin() const
+{
+  return m_chemin;
+}
+
+
+/**
+ * \brief Retourne le nombre de requêtes dont la réponse est prête depuis la création
+ * \return un entier qui représente le nombre de requêtes
+ */
+std::uint64_t ServeurLocal::reqNombreRequetes() const
+{
+  return m_nombreRequetes.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Retourne le nombre de lots traités depuis la création
+ *        Un lot regroupe toutes les requêtes complètes d'une même lecture.
+ * \return un entier qui représente le nombre de lots
+ */
+std::uint64_t ServeurLocal::reqNombreLots() const
+{
+  return m_nombreLots.load (memory_order_relaxed);
+}
+
+
+/**
+ * \brief Boucle du fil du serveur : attend les connexions, lit les requêtes et
+ *        écrit les réponses jusqu'à l'arrêt
+ *
+ * Tant que les réponses d'une connexion ne sont pas toutes écrites, on n'y lit
+ * plus rien : un client qui ne lit pas ses réponses ralentit son propre envoi.
+ * Un réveil par le tube m_reveil signale l'arrêt, ou des acquittements du
+ * journal : on rend alors les réponses devenues prêtes de chaque connexion.
+ */
+void ServeurLocal::boucle()
+{
+  vector<Connexion> connexions;
+  vector<pollfd> attente;
+  for (;;)
+    {
+      attente.clear ();
+      attente.push_back (pollfd {m_reveil[0], POLLIN, 0});
+      attente.push_back (pollfd {m_ecoute, POLLIN, 0});
+      for (size_t i = 0; i < connexions.size (); ++i)
+        {
+          // Une connexion fermée en lecture qui attend le journal n'est pas
+          // surveillée : POLLHUP la rendrait prête sans fin.
+          const bool aEcrire = connexions[i].envoye < connexions[i].sortie.size ();
+          const int descripteur = aEcrire || !connexions[i].finEntree ? connexions[i].descripteur : -1;
+          attente.push_back (pollfd {descripteur, static_cast<short> (aEcrire ? POLLOUT : POLLIN), 0});
+        }
+      if (::poll (attente.data (), attente.size (), -1) < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          break;
+        }
+      if (attente[0].revents != 0)
+        {
+          char vidange[64];
+          while (::read (m_reveil[0], vidange, sizeof (vidange)) > 0)
+            {
+            }
+          if (m_arret.load ())
+            {
+              break;
+            }
+        }
+
+      for (size_t i = 0; i < connexions.size (); ++i)
+        {
+          Connexion& connexion = connexions[i];
+          const short evenements = attente[i + 2].revents;
+          if (evenements & (POLLIN | POLLHUP | POLLERR) && !(evenements & POLLOUT))
+            {
+              connexion.finEntree = !lire (connexion);
+              traiterLot (connexion);
+            }
+          rendreReponses (connexion);
+          const bool ouverte = ecrire (connexion);
+          if (!ouverte || (connexion.finEntree && connexion.resultats.empty ()
+                           && connexion.envoye == connexion.sortie.size ()))
+            {
+              ::close (connexion.descripteur);
+              connexion.descripteur = -1;
+            }
+        }
+      for (size_t i = connexions.size (); i-- > 0;)
+        {
+          if (connexions[i].descripteur < 0)
+            {
+              connexions.erase (connexions.begin () + i);
+            }
+        }
+
+      if (attente[1].revents & POLLIN)
+        {
+          int descripteur;
+          while ((descripteur = ::accept4 (m_ecoute, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0)
+            {
+              connexions.push_back (Connexion {descripteur, string(), string(), 0, false, {}});
+            }
+        }
+    }
+
+  for (Connexion& connexion : connexions)
+    {
+      ::close (connexion.descripteur);
+    }
+}
+
+
+/**
+ * \brief Lit tout ce qui est disponible sur une connexion, sans bloquer
+ * \param[in,out] p_connexion la connexion lue
+ * \return faux si le client a fermé la connexion ou si elle est en erreur
+ */
+bool ServeurLocal::lire(Connexion& p_connexion)
+{
+  char tampon[TAILLE_LECTURE];
+  while (p_connexion.entree.size () < TAILLE_MAX_TRAME)
+    {
+      ssize_t lus = ::recv (p_connexion.descripteur, tampon, sizeof (tampon), 0);
+      if (lus > 0)
+        {
+          p_connexion.entree.append (tampon, static_cast<size_t> (lus));
+        }
+      else if (lus < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      else
+        {
+          return lus < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+  return true;
+}
+
+
+/**
+ * \brief Boucle du fil d'acquittements : attend, dans l'ordre de soumission,
+ *        que les mutations journalisées soient durables, et réveille le fil
+ *        du serveur pour qu'il en rende les réponses
+ *
+ * Le réveil n'est donné qu'une fois la file vidée, ou devant une mutation
+ * encore en attente : un seul réveil couvre toutes les mutations d'un lot
+ * du GroupeValidation.
+ */
+void ServeurLocal::boucleAcquittements()
+{
+  unique_lock<mutex> verrou(m_mutexAcquittements);
+  for (;;)
+    {
+      m_conditionAcquittements.wait (verrou, [this] { return m_arret.load () || !m_acquittements.empty (); });
+      if (m_arret.load ())
+        {
+          return;
+        }
+      shared_future<void> attente = move (m_acquittements.front ());
+      m_acquittements.pop_front ();
+      verrou.unlock ();
+      attente.wait ();
+      verrou.lock ();
+      if (m_acquittements.empty () || m_acquittements.front ().wait_for (0s) != future_status::ready)
+        {
+          reveiller ();
+        }
+    }
+}
+
+
+/**
+ * \brief Traite toutes les requêtes complètes reçues d'une connexion comme un lot
+ *
+ * Les mutations sont appliquées dans l'ordre et soumises au journal ; leurs
+ * résultats rejoignent la file de la connexion sans attendre le journal. Les
+ * mutations pas encore durables sont confiées au fil d'acquittements.
+ *
+ * \param[in,out] p_connexion la connexion dont on consomme l'entrée
+ */
+void ServeurLocal::traiterLot(Connexion& p_connexion)
+{
+  const string& entree = p_connexion.entree;
+  const size_t dejaEnAttente = p_connexion.resultats.size ();
+  size_t position = 0;
+  while (entree.size () - position >= TAILLE_LONGUEUR)
+    {
+      const uint32_t longueur = lireValeur<uint32_t> (entree.data () + position);
+      if (longueur > TAILLE_MAX_TRAME)
+        {
+          // Trame démesurée : le flux n'est plus fiable, on abandonne la connexion.
+          ::shutdown (p_connexion.descripteur, SHUT_RD);
+          position = entree.size ();
+          break;
+        }
+      if (entree.size () - position - TAILLE_LONGUEUR < longueur)
+        {
+          break;
+        }
+      traiterRequete (p_connexion, entree.data () + position + TAILLE_LONGUEUR, longueur);
+      position += TAILLE_LONGUEUR + longueur;
+    }
+  p_connexion.entree.erase (0, position);
+  if (p_connexion.resultats.size () == dejaEnAttente)
+    {
+      return;
+    }
+  m_nombreLots.fetch_add (1, memory_order_relaxed);
+
+  bool aAttendre = false;
+  {
+    lock_guard<mutex> verrou(m_mutexAcquittements);
+    for (size_t i = dejaEnAttente; i < p_connexion.resultats.size (); ++i)
+      {
+        const shared_future<void>& attente = p_connexion.resultats[i].attente;
+        if (attente.valid () && attente.wait_for (0s) != future_status::ready)
+          {
+            m_acquittements.push_back (attente);
+            aAttendre = true;
+          }
+      }
+  }
+  if (aAttendre)
+    {
+      m_conditionAcquittements.notify_one ();
+    }
+}
+
+
+/**
+ * \brief Exécute une requête et range son résultat à la suite de ceux de la connexion
+ *
+ * Une mutation indécodable ou qui enfreint les règles de saisie est Invalide ;
+ * une mutation qui ne convient pas au compte visé est refusée, avant d'avoir
+ * touché la banque.
+ *
+ * \param[in,out] p_connexion la connexion à laquelle le résultat est ajouté
+ * \param[in] p_trame la trame, sans son champ de longueur
+ * \param[in] p_taille la taille de la trame
+ */
+void ServeurLocal::traiterRequete(Connexion& p_connexion, const char* p_trame, std::size_t p_taille)
+{
+  p_connexion.resultats.emplace_back ();
+  Resultat& resultat = p_connexion.resultats.back ();
+  resultat.identifiant = p_taille >= sizeof (uint32_t) ? lireValeur<uint32_t> (p_trame) : 0;
+  resultat.statut = StatutReponse::Invalide;
+  if (p_taille < TAILLE_ENTETE)
+    {
+      return;
+    }
+
+  const NatureRequete nature = static_cast<NatureRequete> (lireValeur<uint8_t> (p_trame + sizeof (uint32_t)));
+  const char* corps = p_trame + TAILLE_ENTETE;
+  const size_t tailleCorps = p_taille - TAILLE_ENTETE;
+  try
+    {
+      if (nature == NatureRequete::Operation)
+        {
+          if (decoderEnregistrement (corps, tailleCorps, m_operation) != tailleCorps
+              || !validerEnregistrement (m_operation))
+            {
+              return;
+            }
+          resultat.attente = m_banque.executer (m_operation).share ();
+          resultat.statut = StatutReponse::Succes;
+        }
+      else if (nature == NatureRequete::Releve && tailleCorps == sizeof (int32_t))
+        {
+          resultat.corps = m_banque.reqClient (lireValeur<int32_t> (corps)).reqReleves ();
+          resultat.statut = StatutReponse::Succes;
+        }
+    }
+  catch (const exception& erreur)
+    {
+      resultat.statut = StatutReponse::Refus;
+      resultat.corps = erreur.what ();
+    }
+}
+
+
+/**
+ * \brief Encode, dans l'ordre, les réponses prêtes d'une connexion
+ *        On s'arrête à la première mutation que le journal n'a pas encore
+ *        rendue durable : les réponses suivantes attendent leur tour.
+ * \param[in,out] p_connexion la connexion dont on remplit la sortie
+ */
+void ServeurLocal::rendreReponses(Connexion& p_connexion)
+{
+  uint64_t rendues = 0;
+  while (!p_connexion.resultats.empty ())
+    {
+      Resultat& resultat = p_connexion.resultats.front ();
+      if (resultat.attente.valid ())
+        {
+          if (resultat.attente.wait_for (0s) != future_status::ready)
+            {
+              break;
+            }
+          try
+            {
+              resultat.attente.get ();
+            }
+          catch (const exception& erreur)
+            {
+              resultat.statut = StatutReponse::Refus;
+              resultat.corps = erreur.what ();
+            }
+        }
+      const size_t debut = ouvrirTrame (p_connexion.sortie, resultat.identifiant,
+                                        static_cast<uint8_t> (resultat.statut));
+      p_connexion.sortie.append (resultat.corps);
+      fermerTrame (p_connexion.sortie, debut);
+      p_connexion.resultats.pop_front ();
+      ++rendues;
+    }
+  m_nombreRequetes.fetch_add (rendues, memory_order_relaxed);
+}
+
+
+/**
+ * \brief Écrit ce qui reste des réponses d'une connexion, sans bloquer
+ * \param[in,out] p_connexion la connexion dont on vide la sortie
+ * \return faux si la connexion est en erreur
+ */
+bool ServeurLocal::ecrire(Connexion& p_connexion)
+{
+  while (p_connexion.envoye < p_connexion.sortie.size ())
+    {
+      ssize_t ecrits = ::send (p_connexion.descripteur, p_connexion.sortie.data () + p_connexion.envoye,
+                               p_connexion.sortie.size () - p_connexion.envoye, MSG_NOSIGNAL);
+      if (ecrits >= 0)
+        {
+          p_connexion.envoye += static_cast<size_t> (ecrits);
+        }
+      else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+          return true;
+        }
+      else if (errno != EINTR)
+        {
+          return false;
+        }
+    }
+  p_connexion.sortie.clear ();
+  p_connexion.envoye = 0;
+  return true;
+}
+
+
+/**
+ * \brief Réveille le fil du serveur ; un réveil déjà en attente suffit si le tube est plein
+ */
+void ServeurLocal::reveiller()
+{
+  const char reveil = 0;
+  while (::write (m_reveil[1], &reveil, 1) < 0 && errno == EINTR)
+    {
+    }
+}
+
+} //namespace bancaire
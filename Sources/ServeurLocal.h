@@ -0,0 +1,151 @@
+/**
+ * \file ServeurLocal.h
+ * \brief Fichier qui contient l'interface de la classe ServeurLocal et de son protocole.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef SERVEURLOCAL_H
+#define SERVEURLOCAL_H
+
+#include "Banque.h"
+#include "Journal.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace bancaire
+{
+/**
+ * \brief Nature d'une requête adressée au serveur
+ *        Operation porte une mutation encodée par encoderEnregistrement
+ *        (AjoutClient, AjoutCheque, AjoutEpargne, SuppressionCompte, AsgSolde, ...),
+ *        Releve porte un numéro de folio.
+ */
+enum class NatureRequete : std::uint8_t
+{
+  Operation = 1,
+  Releve
+};
+
+/**
+ * \brief Issue d'une requête : Refus porte le message de l'exception levée par
+ *        la banque, dont les mutations qui ne conviennent pas au compte visé,
+ *        ou par le journal ; Invalide signale une requête indécodable
+ *        ou une mutation qui enfreint les règles de saisie (validerEnregistrement).
+ */
+enum class StatutReponse : std::uint8_t
+{
+  Succes = 0,
+  Refus,
+  Invalide
+};
+
+/**
+ * \struct Reponse
+ * \brief Réponse décodée ; le corps est le relevé, un message d'erreur ou vide.
+ */
+struct Reponse
+{
+  std::uint32_t identifiant = 0;
+  StatutReponse statut = StatutReponse::Succes;
+  std::string corps;
+};
+
+/**
+ * \brief Taille maximale d'une trame ; une trame plus grande ferme la connexion.
+ */
+const std::size_t TAILLE_MAX_TRAME = 1 << 20;
+
+void encoderRequeteOperation(std::uint32_t p_identifiant, const EnregistrementJournal& p_operation,
+                             std::string& p_tampon);
+void encoderRequeteReleve(std::uint32_t p_identifiant, int p_noFolio, std::string& p_tampon);
+std::size_t decoderReponse(const char* p_donnees, std::size_t p_taille, Reponse& p_reponse);
+
+/**
+ * \class ServeurLocal
+ * \brief Sert une Banque aux autres processus de la machine par un socket du domaine Unix.
+ *
+ * Chaque trame, requête ou réponse, est formée de sa longueur (uint32, sans
+ * compter ce champ), d'un identifiant choisi par le client (uint32), d'un
+ * octet de nature ou de statut, puis du corps. Les entiers sont dans l'ordre
+ * des octets de la machine : le serveur ne sert que des processus locaux.
+ *
+ * Un client peut envoyer plusieurs requêtes sans attendre les réponses ; elles
+ * sont traitées et rendues dans l'ordre d'envoi. Toutes les requêtes complètes
+ * reçues d'une connexion forment un lot. Chaque mutation est vérifiée
+ * explicitement avant d'être exécutée, les contrats de Client, Cheque et
+ * Epargne disparaissant avec NDEBUG. Si la banque a un journal, les réponses
+ * d'une connexion restent en attente jusqu'à ce que leurs mutations soient
+ * durables, sans bloquer le fil du serveur : les lots de toutes les connexions
+ * sont ainsi soumis au même GroupeValidation et partagent ses validations.
+ *
+ * Un seul fil, démarré par le constructeur, sert toutes les connexions ; il est
+ * le seul à toucher la banque tant que le serveur existe. Un second fil attend
+ * les acquittements du journal et réveille le premier par le tube m_reveil.
+ */
+class ServeurLocal
+{
+public:
+  ServeurLocal(Banque& p_banque, const std::string& p_chemin);
+  ~ServeurLocal();
+  ServeurLocal(const ServeurLocal&)=delete;
+  ServeurLocal& operator=(const ServeurLocal&)=delete;
+
+  //accesseurs
+  const std::string& reqChemin() const;
+  std::uint64_t reqNombreRequetes() const;
+  std::uint64_t reqNombreLots() const;
+
+private:
+  struct Resultat
+  {
+    std::uint32_t identifiant;
+    StatutReponse statut;
+    std::string corps;
+    std::shared_future<void> attente;
+  };
+
+  struct Connexion
+  {
+    int descripteur;
+    std::string entree;
+    std::string sortie;
+    std::size_t envoye;
+    bool finEntree;
+    std::deque<Resultat> resultats;
+  };
+
+  void boucle();
+  void boucleAcquittements();
+  bool lire(Connexion& p_connexion);
+  void traiterLot(Connexion& p_connexion);
+  void traiterRequete(Connexion& p_connexion, const char* p_trame, std::size_t p_taille);
+  void rendreReponses(Connexion& p_connexion);
+  bool ecrire(Connexion& p_connexion);
+  void reveiller();
+
+  Banque& m_banque;
+  const std::string m_chemin;
+  int m_ecoute;
+  int m_reveil[2];
+  EnregistrementJournal m_operation;
+
+  std::mutex m_mutexAcquittements;
+  std::condition_variable m_conditionAcquittements;
+  std::deque<std::shared_future<void>> m_acquittements;
+  std::atomic<bool> m_arret;
+
+  std::atomic<std::uint64_t> m_nombreRequetes;
+  std::atomic<std::uint64_t> m_nombreLots;
+  std::thread m_fil;
+  std::thread m_filAcquittements;
+};
+} //namespace bancaire
+
+#endif /* SERVEURLOCAL_H */
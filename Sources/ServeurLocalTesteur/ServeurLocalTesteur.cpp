@@ -0,0 +1,342 @@
+/**
+ * \file ServeurLocalTesteur.cpp
+ * \brief Test unitaire de la classe ServeurLocal et de son protocole.
+ *
+ * À tester :
+ *         ServeurLocal(Banque& p_banque, const std::string& p_chemin);
+ *         std::uint64_t reqNombreRequetes() const;
+ *         std::uint64_t reqNombreLots() const;
+ *         void encoderRequeteOperation(std::uint32_t p_identifiant, const EnregistrementJournal& p_operation, std::string& p_tampon);
+ *         void encoderRequeteReleve(std::uint32_t p_identifiant, int p_noFolio, std::string& p_tampon);
+ *         std::size_t decoderReponse(const char* p_donnees, std::size_t p_taille, Reponse& p_reponse);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ServeurLocal.h"
+#include "Cheque.h"
+#include "Client.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "GroupeValidation.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+/**
+ * \brief Client minimal du protocole : envoie un tampon de requêtes d'un coup
+ *        et lit le nombre de réponses attendu
+ */
+class ClientLocal
+{
+public:
+  explicit ClientLocal (const string& p_chemin) : m_descripteur(::socket (AF_UNIX, SOCK_STREAM, 0))
+  {
+    sockaddr_un adresse {};
+    adresse.sun_family = AF_UNIX;
+    strncpy (adresse.sun_path, p_chemin.c_str (), sizeof (adresse.sun_path) - 1);
+    EXPECT_EQ(0, ::connect (m_descripteur, reinterpret_cast<const sockaddr*> (&adresse), sizeof (adresse)));
+  }
+
+  ~ClientLocal ()
+  {
+    ::close (m_descripteur);
+  }
+
+  vector<Reponse> echanger (const string& p_requetes, size_t p_nombreReponses)
+  {
+    envoyer (p_requetes);
+    return recevoir (p_nombreReponses);
+  }
+
+  void envoyer (const string& p_requetes)
+  {
+    EXPECT_EQ(static_cast<ssize_t> (p_requetes.size ()),
+              ::send (m_descripteur, p_requetes.data (), p_requetes.size (), MSG_NOSIGNAL));
+  }
+
+  vector<Reponse> recevoir (size_t p_nombreReponses)
+  {
+    vector<Reponse> reponses;
+    string recu;
+    char tampon[4096];
+    while (reponses.size () < p_nombreReponses)
+      {
+        ssize_t lus = ::recv (m_descripteur, tampon, sizeof (tampon), 0);
+        if (lus <= 0)
+          {
+            break;
+          }
+        recu.append (tampon, static_cast<size_t> (lus));
+        Reponse reponse;
+        size_t consommes;
+        while ((consommes = decoderReponse (recu.data (), recu.size (), reponse)) != 0)
+          {
+            reponses.push_back (reponse);
+            recu.erase (0, consommes);
+          }
+      }
+    return reponses;
+  }
+
+private:
+  int m_descripteur;
+};
+
+
+EnregistrementJournal
+ajoutClient (int p_noFolio)
+{
+  return enregistrementAjoutClient (Client(p_noFolio, "Ancelotti", "Carlo", "590 234-0342",
+                                           util::Date(20, 1, 1983)));
+}
+
+
+EnregistrementJournal
+ajoutEpargne (int p_noFolio, int p_noCompte)
+{
+  return enregistrementAjoutCompte (p_noFolio, Epargne(p_noCompte, 1.5, 100, "Etudes"));
+}
+
+
+EnregistrementJournal
+mutation (TypeOperation p_type, int p_noFolio, int p_noCompte)
+{
+  EnregistrementJournal operation;
+  operation.type = p_type;
+  operation.noFolio = p_noFolio;
+  operation.noCompte = p_noCompte;
+  return operation;
+}
+} //namespace
+
+
+/**
+ * \brief Création d'une fixture qui sert une banque vide sur un socket propre au test
+ */
+class ServeurLocalTest : public ::testing::Test
+{
+public:
+  ServeurLocalTest():
+  f_chemin("/tmp/bancaire-serveur-" + to_string (::getpid ()) + ".sock"),
+  f_serveur(make_unique<ServeurLocal>(f_banque, f_chemin)) { }
+
+  Banque f_banque;
+  string f_chemin;
+  unique_ptr<ServeurLocal> f_serveur;
+};
+
+
+/**
+ * \brief Test de la méthode ServeurLocal(Banque& p_banque, const std::string& p_chemin);
+ *     Cas valide : le socket est créé au chemin donné et retiré à la destruction.
+ *     Cas invalide : un chemin vide est refusé.
+ */
+TEST_F(ServeurLocalTest, constructeur_CheminValide_SocketCree)
+{
+  ASSERT_EQ(f_chemin, f_serveur->reqChemin ());
+  ASSERT_EQ(0, ::access (f_chemin.c_str (), F_OK));
+  f_serveur.reset ();
+  ASSERT_NE(0, ::access (f_chemin.c_str (), F_OK));
+}
+
+TEST_F(ServeurLocalTest, constructeur_CheminVide_ExceptionLevee)
+{
+  ASSERT_THROW(ServeurLocal(f_banque, ""), PreconditionException);
+}
+
+
+/**
+ * \brief Test du traitement des requêtes en pipeline
+ *     Cas valides : des requêtes envoyées d'un coup sont exécutées dans l'ordre,
+ *                   en un lot, et leurs réponses rendues dans le même ordre.
+ *     Cas invalides : une requête refusée par la banque ou indécodable reçoit
+ *                     sa propre réponse sans empêcher les suivantes.
+ */
+TEST_F(ServeurLocalTest, requetes_EnPipeline_ExecuteesEnOrdre)
+{
+  string requetes;
+  encoderRequeteOperation (1, ajoutClient (2000), requetes);
+  encoderRequeteOperation (2, ajoutEpargne (2000, 7), requetes);
+  encoderRequeteReleve (3, 2000, requetes);
+
+  vector<Reponse> reponses = ClientLocal(f_chemin).echanger (requetes, 3);
+  ASSERT_EQ(3u, reponses.size ());
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      ASSERT_EQ(i + 1, reponses[i].identifiant);
+      ASSERT_EQ(StatutReponse::Succes, reponses[i].statut);
+    }
+  ASSERT_NE(string::npos, reponses[2].corps.find ("Etudes"));
+  ASSERT_EQ(3u, f_serveur->reqNombreRequetes ());
+  ASSERT_EQ(1u, f_serveur->reqNombreLots ());
+}
+
+TEST_F(ServeurLocalTest, requetes_RefuseesOuInvalides_ReponsesPropres)
+{
+  string requetes;
+  encoderRequeteOperation (1, ajoutClient (2000), requetes);
+  encoderRequeteOperation (2, ajoutClient (2000), requetes);
+  encoderRequeteReleve (3, 3000, requetes);
+  const uint32_t longueur = 5;
+  const uint32_t identifiant = 4;
+  requetes.append (reinterpret_cast<const char*> (&longueur), sizeof (longueur));
+  requetes.append (reinterpret_cast<const char*> (&identifiant), sizeof (identifiant));
+  requetes.push_back (42);
+  encoderRequeteReleve (5, 2000, requetes);
+
+  vector<Reponse> reponses = ClientLocal(f_chemin).echanger (requetes, 5);
+  ASSERT_EQ(5u, reponses.size ());
+  ASSERT_EQ(StatutReponse::Succes, reponses[0].statut);
+  ASSERT_EQ(StatutReponse::Refus, reponses[1].statut);
+  ASSERT_FALSE(reponses[1].corps.empty ());
+  ASSERT_EQ(StatutReponse::Refus, reponses[2].statut);
+  ASSERT_EQ(4u, reponses[3].identifiant);
+  ASSERT_EQ(StatutReponse::Invalide, reponses[3].statut);
+  ASSERT_EQ(StatutReponse::Succes, reponses[4].statut);
+}
+
+
+/**
+ * \brief Test de la vérification des mutations décodées
+ *     Cas valide : une mutation conforme est exécutée.
+ *     Cas invalides : un folio hors de [1000, 10000[, un nom mal formé, une date
+ *                     ou un téléphone invalides sont Invalide ; un nombre de
+ *                     transactions sur un compte épargne ou un solde épargne
+ *                     négatif sont refusés par la banque elle-même, sans la
+ *                     toucher, que les contrats soient compilés ou non (NDEBUG).
+ */
+TEST_F(ServeurLocalTest, requetes_MutationsHorsRegles_RefuseesAvantExecution)
+{
+  EnregistrementJournal folio = ajoutClient (2000);
+  folio.noFolio = 999;
+  EnregistrementJournal nom = ajoutClient (2000);
+  nom.nom = "Ancelotti1";
+  EnregistrementJournal date = ajoutClient (2000);
+  date.jour = 31;
+  date.mois = 2;
+  EnregistrementJournal telephone = ajoutClient (2000);
+  telephone.telephone.clear ();
+  EnregistrementJournal transactions = mutation (TypeOperation::AsgNombreTransactions, 2000, 7);
+  transactions.nombreTransactions = 5;
+  EnregistrementJournal solde = mutation (TypeOperation::AsgSolde, 2000, 7);
+  solde.solde = -50;
+
+  string requetes;
+  encoderRequeteOperation (1, folio, requetes);
+  encoderRequeteOperation (2, nom, requetes);
+  encoderRequeteOperation (3, date, requetes);
+  encoderRequeteOperation (4, telephone, requetes);
+  encoderRequeteOperation (5, ajoutClient (2000), requetes);
+  encoderRequeteOperation (6, ajoutEpargne (2000, 7), requetes);
+  encoderRequeteOperation (7, transactions, requetes);
+  encoderRequeteOperation (8, solde, requetes);
+
+  vector<Reponse> reponses = ClientLocal(f_chemin).echanger (requetes, 8);
+  ASSERT_EQ(8u, reponses.size ());
+  for (size_t i = 0; i < 4; ++i)
+    {
+      ASSERT_EQ(StatutReponse::Invalide, reponses[i].statut);
+    }
+  ASSERT_EQ(StatutReponse::Succes, reponses[4].statut);
+  ASSERT_EQ(StatutReponse::Succes, reponses[5].statut);
+  ASSERT_EQ(StatutReponse::Refus, reponses[6].statut);
+  ASSERT_EQ(StatutReponse::Refus, reponses[7].statut);
+  ASSERT_EQ(0u, reponses[6].corps.find ("Le nombre de transactions"));
+  ASSERT_EQ(0u, reponses[7].corps.find ("Le solde d'un compte epargne"));
+  f_serveur.reset ();
+  ASSERT_EQ(1u, f_banque.reqNombreClients ());
+  ASSERT_DOUBLE_EQ(100, f_banque.reqClient (2000).reqCompte (7).reqSolde ());
+}
+
+
+/**
+ * \brief Test du service d'une banque journalisée
+ *     Cas valide : le lot d'une connexion qui attend le journal ne retarde pas
+ *                  celui d'une autre ; les deux partagent la même validation
+ *                  du GroupeValidation, et chaque réponse ne part qu'une fois
+ *                  sa mutation durable.
+ *     Cas invalide : aucun
+ */
+TEST_F(ServeurLocalTest, requetes_BanqueJournalisee_LotsDesConnexionsGroupes)
+{
+  const string cheminJournal = "/tmp/ServeurLocalTesteur_" + to_string (::getpid ()) + ".journal";
+  remove (cheminJournal.c_str ());
+  {
+    GroupeValidation groupe(cheminJournal, 1024, chrono::milliseconds(200));
+    f_serveur.reset ();
+    f_banque.asgJournal (&groupe);
+    f_serveur = make_unique<ServeurLocal>(f_banque, f_chemin);
+
+    ClientLocal premier(f_chemin);
+    ClientLocal second(f_chemin);
+    string requetes;
+    encoderRequeteOperation (1, ajoutClient (2000), requetes);
+    encoderRequeteOperation (2, ajoutEpargne (2000, 7), requetes);
+    premier.envoyer (requetes);
+    requetes.clear ();
+    encoderRequeteOperation (1, ajoutClient (3000), requetes);
+    second.envoyer (requetes);
+
+    vector<Reponse> reponsesPremier = premier.recevoir (2);
+    vector<Reponse> reponsesSecond = second.recevoir (1);
+    ASSERT_EQ(2u, reponsesPremier.size ());
+    ASSERT_EQ(1u, reponsesSecond.size ());
+    ASSERT_EQ(StatutReponse::Succes, reponsesPremier[1].statut);
+    ASSERT_EQ(StatutReponse::Succes, reponsesSecond[0].statut);
+    ASSERT_EQ(3u, groupe.reqNombreEnregistrements ());
+    ASSERT_EQ(1u, groupe.reqNombreLots ());
+    ASSERT_EQ(2u, f_serveur->reqNombreLots ());
+
+    f_serveur.reset ();
+    f_banque.asgJournal (nullptr);
+  }
+  remove (cheminJournal.c_str ());
+}
+
+
+/**
+ * \brief Test du service de plusieurs connexions simultanées
+ *     Cas valide : les requêtes de chaque connexion sont toutes exécutées.
+ *     Cas invalide : aucun
+ */
+TEST_F(ServeurLocalTest, requetes_PlusieursConnexions_ToutesExecutees)
+{
+  vector<thread> clients;
+  for (int i = 0; i < 4; ++i)
+    {
+      clients.emplace_back ([this, i] ()
+      {
+        const int folio = 2000 + i;
+        string requetes;
+        encoderRequeteOperation (0, ajoutClient (folio), requetes);
+        for (int no = 1; no <= 100; ++no)
+          {
+            encoderRequeteOperation (static_cast<uint32_t> (no), ajoutEpargne (folio, no), requetes);
+          }
+        vector<Reponse> reponses = ClientLocal(f_chemin).echanger (requetes, 101);
+        EXPECT_EQ(101u, reponses.size ());
+      });
+    }
+  for (thread& client : clients)
+    {
+      client.join ();
+    }
+  f_serveur.reset ();
+
+  ASSERT_EQ(4u, f_banque.reqNombreClients ());
+  for (int i = 0; i < 4; ++i)
+    {
+      ASSERT_EQ(100u, f_banque.reqClient (2000 + i).reqComptes ());
+    }
+}
@@ -0,0 +1,317 @@
+/**
+ * \file SimulationTaux.cpp
+ * \brief Implantation de la classe SimulationTaux
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "SimulationTaux.h"
+#include "ContratException.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+const double DEUX_PI = 6.283185307179586;
+const double TAUX_MAXIMUM = 100;
+
+
+/**
+ * \brief Étape de splitmix64, comme dans GenerateurCharge
+ */
+uint64_t
+melanger (uint64_t& p_etat)
+{
+  uint64_t z = (p_etat += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+
+/**
+ * \brief Tire un réel uniforme dans ]0, 1]
+ */
+double
+tirerReel (uint64_t& p_etat)
+{
+  return static_cast<double> ((melanger (p_etat) >> 11) + 1) * 0x1.0p-53;
+}
+
+
+/**
+ * \brief Tire un réel de loi normale centrée réduite, par la méthode de Box-Muller
+ */
+double
+tirerNormale (uint64_t& p_etat)
+{
+  const double rayon = sqrt (-2.0 * log (tirerReel (p_etat)));
+  return rayon * cos (DEUX_PI * tirerReel (p_etat));
+}
+
+
+/**
+ * \brief Retourne le centile p d'une série triée, par la méthode du rang le plus proche
+ */
+double
+centile (const vector<double>& p_tries, double p_proportion)
+{
+  const double rang = ceil (p_proportion * static_cast<double> (p_tries.size ()));
+  const size_t position = rang < 1 ? 0 : static_cast<size_t> (rang) - 1;
+  return p_tries[min (position, p_tries.size () - 1)];
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur de la classe SimulationTaux
+ *        On copie les comptes épargne et les comptes chèque à découvert de la
+ *        table ; les autres comptes chèque ne produisent aucun intérêt.
+ * \param[in] p_table la table des comptes à soumettre aux chocs
+ * \param[in] p_parametres les réglages de la simulation
+ * \param[in] p_nombreFils nombre de fils de simulation, 0 pour utiliser tous les cœurs
+ * \pre p_parametres.nombreScenarios doit être supérieur à zéro
+ * \pre p_parametres.periodes ne doit pas être négatif
+ * \pre les écarts types ne doivent pas être négatifs
+ */
+SimulationTaux::SimulationTaux(const TableComptes& p_table, const ParametresSimulation& p_parametres,
+                               unsigned p_nombreFils):
+        m_parametres(p_parametres),
+        m_nombreFils(p_nombreFils != 0 ? p_nombreFils : max (1u, thread::hardware_concurrency ())),
+        m_epargne(p_table), m_totalEpargne(0)
+{
+  PRECONDITION(p_parametres.nombreScenarios > 0);
+  PRECONDITION(p_parametres.periodes >= 0);
+  PRECONDITION(p_parametres.ecartTypeEpargne >= 0 && p_parametres.ecartTypeCheque >= 0
+               && p_parametres.ecartTypeMinimumCheque >= 0);
+
+  for (double solde : m_epargne.reqSoldes ())
+    {
+      m_totalEpargne += solde;
+    }
+  const vector<TypeCompte>& types = p_table.reqTypes ();
+  for (size_t i = 0; i < types.size (); ++i)
+    {
+      if (types[i] == TypeCompte::Cheque && p_table.reqSoldes ()[i] < 0)
+        {
+          m_soldesDecouverts.push_back (p_table.reqSoldes ()[i]);
+          m_tauxDecouverts.push_back (p_table.reqTaux ()[i]);
+          m_tauxMinimumsDecouverts.push_back (p_table.reqTauxMinimums ()[i]);
+          m_transactionsDecouverts.push_back (p_table.reqNombresTransactions ()[i]);
+        }
+    }
+
+  POSTCONDITION(m_nombreFils > 0);
+}
+
+
+/**
+ * \brief Retourne le nombre de fils de simulation
+ * \return un entier qui représente le nombre de tranches de scénarios
+ */
+unsigned SimulationTaux::reqNombreFils() const
+{
+  return m_nombreFils;
+}
+
+
+/**
+ * \brief Retourne le nombre de comptes épargne soumis aux chocs
+ * \return un size_t qui représente le nombre de comptes
+ */
+std::size_t SimulationTaux::reqNombreComptesEpargne() const
+{
+  return m_epargne.reqNombreComptes ();
+}
+
+
+/**
+ * \brief Retourne le nombre de comptes chèque à découvert soumis aux chocs
+ * \return un size_t qui représente le nombre de comptes
+ */
+std::size_t SimulationTaux::reqNombreDecouverts() const
+{
+  return m_soldesDecouverts.size ();
+}
+
+
+/**
+ * \brief Tire les déplacements d'un scénario
+ *        Le générateur est amorcé par la graine et le rang du scénario : un
+ *        scénario est le même quel que soit le fil qui le tire.
+ * \param[in] p_scenario le rang du scénario
+ * \return les déplacements tirés, en points de pourcentage
+ */
+ScenarioTaux SimulationTaux::tirerScenario(std::size_t p_scenario) const
+{
+  uint64_t derivation = m_parametres.graine ^ (static_cast<uint64_t> (p_scenario) * 0xD1B54A32D192ED03ULL);
+  uint64_t etat = melanger (derivation);
+  ScenarioTaux scenario;
+  scenario.deplacement = m_parametres.ecartTypeEpargne * tirerNormale (etat);
+  scenario.deplacementCheque = m_parametres.ecartTypeCheque * tirerNormale (etat);
+  scenario.deplacementMinimumCheque = m_parametres.ecartTypeMinimumCheque * tirerNormale (etat);
+  return scenario;
+}
+
+
+/**
+ * \brief Calcule l'engagement en intérêts d'un scénario sur tout l'horizon
+ * \param[in] p_scenario les déplacements des taux
+ * \return l'intérêt versé sur l'épargne moins l'intérêt perçu sur les découverts
+ */
+double SimulationTaux::evaluer(const ScenarioTaux& p_scenario) const
+{
+  const size_t nombre = m_epargne.reqNombreComptes ();
+  const double* soldes = m_epargne.reqSoldes ().data ();
+  const double* taux = m_epargne.reqTaux ().data ();
+  double tampon[ProjectionInterets::TAILLE_BLOC];
+  double epargne = 0;
+  for (size_t debut = 0; debut < nombre; debut += ProjectionInterets::TAILLE_BLOC)
+    {
+      epargne += ProjectionInterets::projeterBloc (soldes + debut, taux + debut,
+                                                   min (ProjectionInterets::TAILLE_BLOC, nombre - debut),
+                                                   p_scenario.deplacement, m_parametres.periodes, tampon);
+    }
+  const double decouverts = calculerInteretsChequeBloc (m_soldesDecouverts.data (), m_tauxDecouverts.data (),
+                                                        m_tauxMinimumsDecouverts.data (),
+                                                        m_transactionsDecouverts.data (), reqNombreDecouverts (),
+                                                        p_scenario.deplacementCheque,
+                                                        p_scenario.deplacementMinimumCheque);
+  return (epargne - m_totalEpargne) - decouverts * m_parametres.periodes;
+}
+
+
+/**
+ * \brief Tire et évalue tous les scénarios, répartis entre les fils
+ * \return l'engagement de chaque scénario, dans l'ordre des rangs
+ */
+std::vector<double> SimulationTaux::simuler() const
+{
+  TRACE_SCOPE("SimulationTaux::simuler");
+  const size_t nombreScenarios = m_parametres.nombreScenarios;
+  const size_t nombreFils = min<size_t> (m_nombreFils, nombreScenarios);
+  vector<double> engagements(nombreScenarios);
+  vector<thread> fils;
+  fils.reserve (nombreFils);
+  for (size_t rang = 0; rang < nombreFils; ++rang)
+    {
+      const size_t debut = nombreScenarios * rang / nombreFils;
+      const size_t fin = nombreScenarios * (rang + 1) / nombreFils;
+      fils.emplace_back (&SimulationTaux::simulerTranche, this, debut, fin, engagements.data ());
+    }
+  for (thread& fil : fils)
+    {
+      fil.join ();
+    }
+  return engagements;
+}
+
+
+/**
+ * \brief Simule tous les scénarios et résume leur distribution
+ * \return les statistiques des engagements
+ */
+StatistiquesSimulation SimulationTaux::executer() const
+{
+  return resumer (simuler ());
+}
+
+
+/**
+ * \brief Résume une distribution d'engagements
+ * \param[in] p_engagements les engagements des scénarios, copiés pour être triés
+ * \return la moyenne, l'écart type corrigé et les centiles, par rang le plus proche
+ * \pre p_engagements ne doit pas être vide
+ */
+StatistiquesSimulation SimulationTaux::resumer(std::vector<double> p_engagements)
+{
+  PRECONDITION(!p_engagements.empty ());
+
+  sort (p_engagements.begin (), p_engagements.end ());
+  const double nombre = static_cast<double> (p_engagements.size ());
+  StatistiquesSimulation statistiques;
+  statistiques.nombreScenarios = p_engagements.size ();
+  double somme = 0;
+  for (double engagement : p_engagements)
+    {
+      somme += engagement;
+    }
+  statistiques.moyenne = somme / nombre;
+  if (p_engagements.size () > 1)
+    {
+      double carres = 0;
+      for (double engagement : p_engagements)
+        {
+          carres += (engagement - statistiques.moyenne) * (engagement - statistiques.moyenne);
+        }
+      statistiques.ecartType = sqrt (carres / (nombre - 1));
+    }
+  statistiques.minimum = p_engagements.front ();
+  statistiques.centile5 = centile (p_engagements, 0.05);
+  statistiques.mediane = centile (p_engagements, 0.50);
+  statistiques.centile95 = centile (p_engagements, 0.95);
+  statistiques.centile99 = centile (p_engagements, 0.99);
+  statistiques.maximum = p_engagements.back ();
+  return statistiques;
+}
+
+
+/**
+ * \brief Noyau de calcul de l'intérêt d'une période sur un bloc de comptes chèque
+ *        Reproduit Cheque::calculerInteret, y compris la troncature à l'entier
+ *        des paliers de 11 à 35 transactions, sans branchement : les paliers
+ *        sont choisis par sélection.
+ * \param[in] p_soldes les soldes des comptes
+ * \param[in] p_taux les taux des comptes, en pourcentage
+ * \param[in] p_tauxMinimums les taux minimums des comptes, en pourcentage
+ * \param[in] p_nombresTransactions les nombres de transactions des comptes
+ * \param[in] p_nombre le nombre de comptes du bloc
+ * \param[in] p_deplacementTaux les points ajoutés à chaque taux
+ * \param[in] p_deplacementMinimum les points ajoutés à chaque taux minimum
+ * \return la somme des intérêts du bloc ; les soldes positifs n'en produisent pas
+ */
+double SimulationTaux::calculerInteretsChequeBloc(const double* p_soldes, const double* p_taux,
+                                                  const double* p_tauxMinimums,
+                                                  const std::int32_t* p_nombresTransactions,
+                                                  std::size_t p_nombre, double p_deplacementTaux,
+                                                  double p_deplacementMinimum)
+{
+  double somme = 0;
+  for (size_t i = 0; i < p_nombre; ++i)
+    {
+      double minimum = p_tauxMinimums[i] + p_deplacementMinimum;
+      minimum = minimum < 0 ? 0 : minimum;
+      minimum = minimum > TAUX_MAXIMUM ? TAUX_MAXIMUM : minimum;
+      double taux = p_taux[i] + p_deplacementTaux;
+      taux = taux < minimum ? minimum : taux;
+      taux = taux > TAUX_MAXIMUM ? TAUX_MAXIMUM : taux;
+
+      const int32_t transactions = p_nombresTransactions[i];
+      const double interet = -p_soldes[i] * ((transactions <= 35 ? minimum : taux) / 100);
+      const double tronque = trunc (interet);
+      const double palier = transactions <= 10 || transactions > 35
+              ? interet : tronque + (transactions <= 25 ? 0.4 : 0.8) * tronque;
+      somme += p_soldes[i] < 0 ? palier : 0;
+    }
+  return somme;
+}
+
+
+/**
+ * \brief Tire et évalue les scénarios de rangs [p_debut, p_fin)
+ * \param[out] p_engagements le tableau de tous les engagements, indexé par rang
+ */
+void SimulationTaux::simulerTranche(std::size_t p_debut, std::size_t p_fin, double* p_engagements) const
+{
+  for (size_t scenario = p_debut; scenario < p_fin; ++scenario)
+    {
+      p_engagements[scenario] = evaluer (tirerScenario (scenario));
+    }
+}
+
+} //namespace bancaire
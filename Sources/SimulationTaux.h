@@ -0,0 +1,106 @@
+/**
+ * \file SimulationTaux.h
+ * \brief Fichier qui contient l'interface de la classe SimulationTaux et de ses réglages.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef SIMULATIONTAUX_H
+#define SIMULATIONTAUX_H
+
+#include "ProjectionInterets.h"
+#include "TableComptes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \struct ParametresSimulation
+ * \brief Réglages d'une simulation ; la même graine donne toujours les mêmes
+ *        scénarios, quel que soit le nombre de fils.
+ *
+ * Les écarts types sont en points de pourcentage.
+ */
+struct ParametresSimulation
+{
+  std::uint64_t graine = 1;
+  std::size_t nombreScenarios = 1000;
+  int periodes = 12;
+  double ecartTypeEpargne = 0.5;
+  double ecartTypeCheque = 0.5;
+  double ecartTypeMinimumCheque = 0.25;
+};
+
+/**
+ * \struct StatistiquesSimulation
+ * \brief Distribution des engagements en intérêts des scénarios simulés
+ */
+struct StatistiquesSimulation
+{
+  std::size_t nombreScenarios = 0;
+  double moyenne = 0;
+  double ecartType = 0;
+  double minimum = 0;
+  double centile5 = 0;
+  double mediane = 0;
+  double centile95 = 0;
+  double centile99 = 0;
+  double maximum = 0;
+};
+
+/**
+ * \class SimulationTaux
+ * \brief Simulation de Monte-Carlo de chocs de taux sur les comptes d'une table.
+ *
+ * Chaque scénario tire trois déplacements gaussiens, maintenus sur tout
+ * l'horizon : celui des taux épargne, ramenés dans [0.1, 3.5], et ceux des
+ * taux et des taux minimums des comptes chèque, ramenés dans [0, 100] avec
+ * le taux au moins égal au minimum. L'engagement d'un scénario est l'intérêt
+ * capitalisé versé sur l'épargne, moins l'intérêt perçu à chaque période sur
+ * les découverts, dont les soldes sont supposés constants.
+ *
+ * L'épargne est projetée par les noyaux en blocs de ProjectionInterets, et les
+ * découverts par calculerInteretsChequeBloc, qui reproduit les paliers de
+ * Cheque::calculerInteret. Les scénarios sont répartis en tranches contiguës
+ * entre les fils ; chaque fil a son propre générateur, réamorcé pour chaque
+ * scénario à partir de la graine et du rang du scénario.
+ */
+class SimulationTaux
+{
+public:
+  SimulationTaux(const TableComptes& p_table, const ParametresSimulation& p_parametres,
+                 unsigned p_nombreFils=0);
+
+  //accesseurs
+  unsigned reqNombreFils() const;
+  std::size_t reqNombreComptesEpargne() const;
+  std::size_t reqNombreDecouverts() const;
+
+  //methodes
+  ScenarioTaux tirerScenario(std::size_t p_scenario) const;
+  double evaluer(const ScenarioTaux& p_scenario) const;
+  std::vector<double> simuler() const;
+  StatistiquesSimulation executer() const;
+  static StatistiquesSimulation resumer(std::vector<double> p_engagements);
+  static double calculerInteretsChequeBloc(const double* p_soldes, const double* p_taux,
+                                           const double* p_tauxMinimums, const std::int32_t* p_nombresTransactions,
+                                           std::size_t p_nombre, double p_deplacementTaux,
+                                           double p_deplacementMinimum);
+
+private:
+  void simulerTranche(std::size_t p_debut, std::size_t p_fin, double* p_engagements) const;
+
+  ParametresSimulation m_parametres;
+  unsigned m_nombreFils;
+  ProjectionInterets m_epargne;
+  double m_totalEpargne;
+  std::vector<double> m_soldesDecouverts;
+  std::vector<double> m_tauxDecouverts;
+  std::vector<double> m_tauxMinimumsDecouverts;
+  std::vector<std::int32_t> m_transactionsDecouverts;
+};
+
+} //namespace bancaire
+
+#endif /* SIMULATIONTAUX_H */
@@ -0,0 +1,234 @@
+/**
+ * \file SimulationTauxTesteur.cpp
+ * \brief Test unitaire de la classe SimulationTaux.
+ *
+ * À tester :
+ *         SimulationTaux(const TableComptes& p_table, const ParametresSimulation& p_parametres,
+ *                        unsigned p_nombreFils=0);
+ *         ScenarioTaux tirerScenario(std::size_t p_scenario) const;
+ *         double evaluer(const ScenarioTaux& p_scenario) const;
+ *         std::vector<double> simuler() const;
+ *         StatistiquesSimulation executer() const;
+ *         static StatistiquesSimulation resumer(std::vector<double> p_engagements);
+ *         static double calculerInteretsChequeBloc(const double* p_soldes, const double* p_taux,
+ *                                                  const double* p_tauxMinimums,
+ *                                                  const std::int32_t* p_nombresTransactions,
+ *                                                  std::size_t p_nombre, double p_deplacementTaux,
+ *                                                  double p_deplacementMinimum);
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "SimulationTaux.h"
+#include "Cheque.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "GenerateurCharge.h"
+#include <cmath>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : deux comptes épargne, deux comptes chèque à
+ *        découvert et un compte chèque créditeur
+ */
+class SimulationTauxTest : public ::testing::Test
+{
+public:
+  SimulationTauxTest()
+  {
+    Client client1(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983));
+    client1.ajouterCompte (Epargne(1, 2, 1000, "Etudes"));
+    client1.ajouterCompte (Cheque(2, 10, -150, 4, "Loyer", 1));
+    Client client2(2000, "Carlo", "Ancelotti", "590 234-0342", util::Date(20, 1, 1983));
+    client2.ajouterCompte (Epargne(1, 0.5, 200, "Voyage"));
+    client2.ajouterCompte (Cheque(2, 38, -300, 5, "Courant", 2));
+    client2.ajouterCompte (Cheque(3, 20, 400, 3, "Paie", 1));
+    Banque banque;
+    banque.ajouterClient (client1);
+    banque.ajouterClient (client2);
+    f_table = TableComptes(banque);
+    f_parametres.nombreScenarios = 200;
+    f_parametres.periodes = 12;
+  }
+
+  TableComptes f_table;
+  ParametresSimulation f_parametres;
+};
+
+
+/**
+ * \brief Test du constructeur SimulationTaux(const TableComptes& p_table, const ParametresSimulation& p_parametres, unsigned p_nombreFils=0);
+ *     Cas valides : les comptes épargne et les découverts sont retenus ; 0 fil
+ *                   donne au moins un fil.
+ *     Cas invalides : aucun scénario, des périodes ou un écart type négatifs.
+ */
+TEST_F(SimulationTauxTest, constructeur_Table_EpargneEtDecouverts)
+{
+  SimulationTaux simulation(f_table, f_parametres);
+  ASSERT_EQ(2u, simulation.reqNombreComptesEpargne ());
+  ASSERT_EQ(2u, simulation.reqNombreDecouverts ());
+  ASSERT_GT(simulation.reqNombreFils (), 0u);
+  ASSERT_EQ(3u, SimulationTaux(f_table, f_parametres, 3).reqNombreFils ());
+}
+
+TEST_F(SimulationTauxTest, constructeur_ParametresInvalides_PreconditionException)
+{
+  ParametresSimulation parametres = f_parametres;
+  parametres.nombreScenarios = 0;
+  ASSERT_THROW(SimulationTaux(f_table, parametres), PreconditionException);
+  parametres = f_parametres;
+  parametres.periodes = -1;
+  ASSERT_THROW(SimulationTaux(f_table, parametres), PreconditionException);
+  parametres = f_parametres;
+  parametres.ecartTypeCheque = -0.5;
+  ASSERT_THROW(SimulationTaux(f_table, parametres), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la méthode static double calculerInteretsChequeBloc(...);
+ *     Cas valides : pour chaque nombre de transactions de 0 à 40, à découvert
+ *                   ou non, le noyau rend Cheque::calculerInteret, avec ou sans
+ *                   déplacement des taux ; le taux reste au moins égal au minimum.
+ *     Cas invalide : aucun
+ */
+TEST(SimulationTaux, calculerInteretsChequeBloc_Paliers_CommeCheque)
+{
+  const double soldes[] = {-1234.56, -87.5, 250};
+  for (int32_t transactions = 0; transactions <= 40; ++transactions)
+    {
+      for (double solde : soldes)
+        {
+          const double taux = 6;
+          const double minimum = 2.5;
+          ASSERT_DOUBLE_EQ(Cheque(1, transactions, solde, taux, "Courant", minimum).calculerInteret (),
+                           SimulationTaux::calculerInteretsChequeBloc (&solde, &taux, &minimum, &transactions,
+                                                                       1, 0, 0));
+          ASSERT_DOUBLE_EQ(Cheque(1, transactions, solde, 7.5, "Courant", 3).calculerInteret (),
+                           SimulationTaux::calculerInteretsChequeBloc (&solde, &taux, &minimum, &transactions,
+                                                                       1, 1.5, 0.5));
+          ASSERT_DOUBLE_EQ(Cheque(1, transactions, solde, 4, "Courant", 4).calculerInteret (),
+                           SimulationTaux::calculerInteretsChequeBloc (&solde, &taux, &minimum, &transactions,
+                                                                       1, -3, 1.5));
+        }
+    }
+}
+
+
+/**
+ * \brief Test de la méthode ScenarioTaux tirerScenario(std::size_t p_scenario) const;
+ *     Cas valides : un rang donne toujours le même scénario, des rangs
+ *                   différents des scénarios différents ; un écart type nul
+ *                   donne un déplacement nul.
+ *     Cas invalide : aucun
+ */
+TEST_F(SimulationTauxTest, tirerScenario_MemeRang_MemeScenario)
+{
+  SimulationTaux simulation(f_table, f_parametres);
+  ASSERT_EQ(simulation.tirerScenario (7).deplacement, simulation.tirerScenario (7).deplacement);
+  ASSERT_NE(simulation.tirerScenario (7).deplacement, simulation.tirerScenario (8).deplacement);
+
+  ParametresSimulation parametres = f_parametres;
+  parametres.ecartTypeMinimumCheque = 0;
+  ASSERT_EQ(0, SimulationTaux(f_table, parametres).tirerScenario (7).deplacementMinimumCheque);
+}
+
+
+/**
+ * \brief Test de la méthode double evaluer(const ScenarioTaux& p_scenario) const;
+ *     Cas valide : l'engagement est l'intérêt composé de l'épargne moins
+ *                  l'intérêt des découverts sur chaque période.
+ *     Cas invalide : aucun
+ */
+TEST_F(SimulationTauxTest, evaluer_ScenarioNul_EpargneMoinsDecouverts)
+{
+  SimulationTaux simulation(f_table, f_parametres);
+  const double epargne = 1000 * (pow (1.02, 12) - 1) + 200 * (pow (1.005, 12) - 1);
+  const double decouverts = Cheque(2, 10, -150, 4, "Loyer", 1).calculerInteret ()
+          + Cheque(2, 38, -300, 5, "Courant", 2).calculerInteret ();
+  ASSERT_NEAR(epargne - 12 * decouverts, simulation.evaluer (ScenarioTaux()), 1e-9);
+
+  ScenarioTaux hausse;
+  hausse.deplacement = 1;
+  ASSERT_GT(simulation.evaluer (hausse), simulation.evaluer (ScenarioTaux()));
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<double> simuler() const;
+ *     Cas valides : un engagement par scénario, égal à l'évaluation de son
+ *                   tirage, quel que soit le nombre de fils.
+ *     Cas invalide : aucun
+ */
+TEST_F(SimulationTauxTest, simuler_PlusieursFils_MemesEngagements)
+{
+  vector<double> seul = SimulationTaux(f_table, f_parametres, 1).simuler ();
+  vector<double> plusieurs = SimulationTaux(f_table, f_parametres, 7).simuler ();
+  ASSERT_EQ(f_parametres.nombreScenarios, seul.size ());
+  ASSERT_EQ(seul, plusieurs);
+
+  SimulationTaux simulation(f_table, f_parametres, 4);
+  ASSERT_EQ(simulation.evaluer (simulation.tirerScenario (123)), seul[123]);
+}
+
+
+/**
+ * \brief Test de la méthode static StatistiquesSimulation resumer(std::vector<double> p_engagements);
+ *     Cas valides : moyenne, écart type corrigé et centiles par rang le plus
+ *                   proche d'une série connue, dans le désordre ; une seule
+ *                   valeur a un écart type nul.
+ *     Cas invalide : une série vide est refusée.
+ */
+TEST(SimulationTaux, resumer_SerieConnue_Statistiques)
+{
+  vector<double> serie;
+  for (int valeur = 100; valeur >= 1; --valeur)
+    {
+      serie.push_back (valeur);
+    }
+  StatistiquesSimulation statistiques = SimulationTaux::resumer (serie);
+  ASSERT_EQ(100u, statistiques.nombreScenarios);
+  ASSERT_DOUBLE_EQ(50.5, statistiques.moyenne);
+  ASSERT_NEAR(29.011492, statistiques.ecartType, 1e-6);
+  ASSERT_EQ(1, statistiques.minimum);
+  ASSERT_EQ(5, statistiques.centile5);
+  ASSERT_EQ(50, statistiques.mediane);
+  ASSERT_EQ(95, statistiques.centile95);
+  ASSERT_EQ(99, statistiques.centile99);
+  ASSERT_EQ(100, statistiques.maximum);
+
+  ASSERT_EQ(0, SimulationTaux::resumer ({42}).ecartType);
+  ASSERT_THROW(SimulationTaux::resumer ({}), PreconditionException);
+}
+
+
+/**
+ * \brief Test de la méthode StatistiquesSimulation executer() const;
+ *     Cas valide : sur une population synthétique de plusieurs blocs, les
+ *                  statistiques sont ordonnées et la moyenne est proche de
+ *                  l'engagement sans choc.
+ *     Cas invalide : aucun
+ */
+TEST(SimulationTaux, executer_PopulationSynthetique_DistributionOrdonnee)
+{
+  ParametresCharge charge;
+  charge.nombreComptes = 2000;
+  ParametresSimulation parametres;
+  parametres.nombreScenarios = 500;
+  parametres.ecartTypeEpargne = 0.25;
+  SimulationTaux simulation(TableComptes(GenerateurCharge(charge).construireBanque ()), parametres, 4);
+  ASSERT_GT(simulation.reqNombreComptesEpargne (), ProjectionInterets::TAILLE_BLOC);
+
+  StatistiquesSimulation statistiques = simulation.executer ();
+  ASSERT_EQ(500u, statistiques.nombreScenarios);
+  ASSERT_GT(statistiques.ecartType, 0);
+  ASSERT_LE(statistiques.minimum, statistiques.centile5);
+  ASSERT_LE(statistiques.centile5, statistiques.mediane);
+  ASSERT_LE(statistiques.mediane, statistiques.centile95);
+  ASSERT_LE(statistiques.centile95, statistiques.centile99);
+  ASSERT_LE(statistiques.centile99, statistiques.maximum);
+  const double sansChoc = simulation.evaluer (ScenarioTaux());
+  ASSERT_NEAR(sansChoc, statistiques.moyenne, 0.1 * fabs (sansChoc));
+}
@@ -0,0 +1,374 @@
+/**
+ * \file TableComptes.cpp
+ * \brief Implantation de la classe TableComptes
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "TableComptes.h"
+#include "Cheque.h"
+#include "ContratException.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Étendue de clés au-delà de laquelle les groupes sont rangés dans une
+ *        table associative plutôt que dans un tableau indexé par la clé
+ */
+const int64_t ETENDUE_DENSE_MAX = 1 << 16;
+
+
+void
+accumuler (Agregat& p_agregat, double p_valeur)
+{
+  ++p_agregat.nombre;
+  p_agregat.somme += p_valeur;
+  p_agregat.minimum = min (p_agregat.minimum, p_valeur);
+  p_agregat.maximum = max (p_agregat.maximum, p_valeur);
+}
+
+
+/**
+ * \brief Agrège les lignes sélectionnées sans regroupement
+ *        Quatre accumulateurs indépendants brisent la chaîne de dépendances des
+ *        additions ; le masque est appliqué par sélection, sans branchement.
+ */
+Agregat
+agregerTout (const vector<uint8_t>& p_masque, const double* p_valeurs)
+{
+  const double infini = numeric_limits<double>::infinity ();
+  const size_t nombre = p_masque.size ();
+  double somme[4] = {0, 0, 0, 0};
+  double minimum[4] = {infini, infini, infini, infini};
+  double maximum[4] = {-infini, -infini, -infini, -infini};
+  size_t selectionnes = 0;
+  size_t i = 0;
+  for (; i + 4 <= nombre; i += 4)
+    {
+      for (size_t k = 0; k < 4; ++k)
+        {
+          const bool retenu = p_masque[i + k] != 0;
+          const double valeur = p_valeurs[i + k];
+          somme[k] += retenu ? valeur : 0.0;
+          minimum[k] = min (minimum[k], retenu ? valeur : infini);
+          maximum[k] = max (maximum[k], retenu ? valeur : -infini);
+          selectionnes += p_masque[i + k];
+        }
+    }
+  for (; i < nombre; ++i)
+    {
+      const bool retenu = p_masque[i] != 0;
+      somme[0] += retenu ? p_valeurs[i] : 0.0;
+      minimum[0] = min (minimum[0], retenu ? p_valeurs[i] : infini);
+      maximum[0] = max (maximum[0], retenu ? p_valeurs[i] : -infini);
+      selectionnes += p_masque[i];
+    }
+
+  Agregat agregat;
+  agregat.nombre = selectionnes;
+  agregat.somme = (somme[0] + somme[1]) + (somme[2] + somme[3]);
+  agregat.minimum = min (min (minimum[0], minimum[1]), min (minimum[2], minimum[3]));
+  agregat.maximum = max (max (maximum[0], maximum[1]), max (maximum[2], maximum[3]));
+  return agregat;
+}
+} //namespace
+
+
+/**
+ * \brief Constructeur par défaut de la classe TableComptes
+ *        On construit une table vide.
+ */
+TableComptes::TableComptes() { }
+
+
+/**
+ * \brief Constructeur de la classe TableComptes
+ *        On copie en colonnes tous les comptes de tous les clients de la banque.
+ * \param[in] p_banque la banque dont on copie les comptes
+ */
+TableComptes::TableComptes(const Banque& p_banque)
+{
+  for (const auto& paire : p_banque.reqClients ())
+    {
+      ajouterClient (paire.second);
+    }
+}
+
+
+/**
+ * \brief Constructeur de la classe TableComptes
+ *        On copie en colonnes tous les comptes des clients d'un instantané.
+ * \param[in] p_instantane l'instantané dont on copie les comptes
+ */
+TableComptes::TableComptes(const VersionsClients::Instantane& p_instantane)
+{
+  p_instantane.parcourirClients ([this] (const Client& p_client)
+  {
+    ajouterClient (p_client);
+  });
+}
+
+
+/**
+ * \brief Retourne le nombre de comptes de la table
+ * \return un size_t qui représente le nombre de lignes
+ */
+std::size_t TableComptes::reqNombreComptes() const
+{
+  return m_numeros.size ();
+}
+
+
+/**
+ * \brief Retourne la colonne des folios des titulaires
+ * \return une référence constante vers la colonne
+ */
+const std::vector<std::int32_t>& TableComptes::reqFolios() const
+{
+  return m_folios;
+}
+
+
+/**
+ * \brief Retourne la colonne des numéros de compte
+ * \return une référence constante vers la colonne
+ */
+const std::vector<std::int32_t>& TableComptes::reqNumeros() const
+{
+  return m_numeros;
+}
+
+
+/**
+ * \brief Retourne la colonne des types de compte
+ * \return une référence constante vers la colonne
+ */
+const std::vector<TypeCompte>& TableComptes::reqTypes() const
+{
+  return m_types;
+}
+
+
+/**
+ * \brief Retourne la colonne des soldes
+ * \return une référence constante vers la colonne
+ */
+const std::vector<double>& TableComptes::reqSoldes() const
+{
+  return m_soldes;
+}
+
+
+/**
+ * \brief Retourne la colonne des taux d'intérêt
+ * \return une référence constante vers la colonne
+ */
+const std::vector<double>& TableComptes::reqTaux() const
+{
+  return m_taux;
+}
+
+
+/**
+ * \brief Retourne la colonne des nombres de transactions, nuls pour les comptes épargne
+ * \return une référence constante vers la colonne
+ */
+const std::vector<std::int32_t>& TableComptes::reqNombresTransactions() const
+{
+  return m_nombresTransactions;
+}
+
+
+/**
+ * \brief Retourne la colonne des taux minimums, nuls pour les comptes épargne
+ * \return une référence constante vers la colonne
+ */
+const std::vector<double>& TableComptes::reqTauxMinimums() const
+{
+  return m_tauxMinimums;
+}
+
+
+/**
+ * \brief Ajoute à la table tous les comptes d'un client
+ * \param[in] p_client le client dont on copie les comptes
+ * \post la table compte p_client.reqComptes() lignes de plus
+ */
+void TableComptes::ajouterClient(const Client& p_client)
+{
+  [[maybe_unused]] const size_t avant = reqNombreComptes ();
+  const int32_t folio = p_client.reqNoFolio ();
+  p_client.parcourirComptes ([this, folio] (const Compte& p_compte)
+  {
+    const Cheque* cheque = dynamic_cast<const Cheque*> (&p_compte);
+    m_folios.push_back (folio);
+    m_numeros.push_back (p_compte.reqNoCompte ());
+    m_types.push_back (cheque != nullptr ? TypeCompte::Cheque : TypeCompte::Epargne);
+    m_soldes.push_back (p_compte.reqSolde ());
+    m_taux.push_back (p_compte.reqTauxInteret ());
+    m_nombresTransactions.push_back (cheque != nullptr ? cheque->reqNombreTransactions () : 0);
+    m_tauxMinimums.push_back (cheque != nullptr ? cheque->reqTauxInteretMinimum () : 0);
+  });
+
+  POSTCONDITION(reqNombreComptes () == avant + p_client.reqComptes ());
+  INVARIANTS();
+}
+
+
+/**
+ * \brief Exécute une requête sur la table
+ * \param[in] p_requete le filtre, la mesure et le regroupement
+ * \return un agrégat par groupe non vide, par clé croissante ; sans
+ *         regroupement, un seul agrégat de clé 0, même si aucun compte n'est retenu
+ * \pre la largeur des tranches doit être positive si l'on regroupe par tranche
+ */
+std::vector<Agregat> TableComptes::executer(const RequeteComptes& p_requete) const
+{
+  PRECONDITION(p_requete.groupement == Groupement::Aucun || p_requete.groupement == Groupement::Type
+               || p_requete.largeurTranche > 0);
+
+  vector<uint8_t> masque;
+  selectionner (p_requete, masque);
+
+  vector<double> transactions;
+  const double* valeurs = m_soldes.data ();
+  if (p_requete.mesure == Mesure::TauxInteret)
+    {
+      valeurs = m_taux.data ();
+    }
+  else if (p_requete.mesure == Mesure::NombreTransactions)
+    {
+      transactions.assign (m_nombresTransactions.begin (), m_nombresTransactions.end ());
+      valeurs = transactions.data ();
+    }
+
+  if (p_requete.groupement == Groupement::Aucun)
+    {
+      return vector<Agregat> {agregerTout (masque, valeurs)};
+    }
+
+  const size_t nombre = masque.size ();
+  vector<int64_t> cles(nombre);
+  if (p_requete.groupement == Groupement::Type)
+    {
+      for (size_t i = 0; i < nombre; ++i)
+        {
+          cles[i] = static_cast<int64_t> (m_types[i]);
+        }
+    }
+  else
+    {
+      const double* colonne = p_requete.groupement == Groupement::TrancheTaux ? m_taux.data () : m_soldes.data ();
+      const double inverse = 1.0 / p_requete.largeurTranche;
+      for (size_t i = 0; i < nombre; ++i)
+        {
+          cles[i] = static_cast<int64_t> (floor (colonne[i] * inverse));
+        }
+    }
+
+  int64_t cleMinimum = numeric_limits<int64_t>::max ();
+  int64_t cleMaximum = numeric_limits<int64_t>::min ();
+  for (size_t i = 0; i < nombre; ++i)
+    {
+      if (masque[i])
+        {
+          cleMinimum = min (cleMinimum, cles[i]);
+          cleMaximum = max (cleMaximum, cles[i]);
+        }
+    }
+  vector<Agregat> resultats;
+  if (cleMinimum > cleMaximum)
+    {
+      return resultats;
+    }
+
+  if (cleMaximum - cleMinimum < ETENDUE_DENSE_MAX)
+    {
+      vector<Agregat> groupes(static_cast<size_t> (cleMaximum - cleMinimum + 1));
+      for (size_t i = 0; i < nombre; ++i)
+        {
+          if (masque[i])
+            {
+              accumuler (groupes[static_cast<size_t> (cles[i] - cleMinimum)], valeurs[i]);
+            }
+        }
+      for (size_t k = 0; k < groupes.size (); ++k)
+        {
+          if (groupes[k].nombre != 0)
+            {
+              groupes[k].cle = cleMinimum + static_cast<int64_t> (k);
+              resultats.push_back (groupes[k]);
+            }
+        }
+    }
+  else
+    {
+      map<int64_t, Agregat> groupes;
+      for (size_t i = 0; i < nombre; ++i)
+        {
+          if (masque[i])
+            {
+              Agregat& groupe = groupes[cles[i]];
+              groupe.cle = cles[i];
+              accumuler (groupe, valeurs[i]);
+            }
+        }
+      for (const auto& paire : groupes)
+        {
+          resultats.push_back (paire.second);
+        }
+    }
+  return resultats;
+}
+
+
+/**
+ * \brief Évalue les prédicats d'une requête sur toutes les lignes
+ *        Une seule boucle sans branchement combine les comparaisons de chaque
+ *        colonne ; les filtres absents ont des bornes infinies toujours vraies.
+ * \param[in] p_requete la requête dont on évalue le filtre
+ * \param[out] p_masque 1 pour chaque ligne retenue, 0 sinon
+ */
+void TableComptes::selectionner(const RequeteComptes& p_requete, std::vector<std::uint8_t>& p_masque) const
+{
+  const size_t nombre = reqNombreComptes ();
+  p_masque.resize (nombre);
+  const double* soldes = m_soldes.data ();
+  const double* taux = m_taux.data ();
+  const uint8_t* types = reinterpret_cast<const uint8_t*> (m_types.data ());
+  const uint8_t toutType = p_requete.filtrerType ? 0 : 1;
+  const uint8_t type = static_cast<uint8_t> (p_requete.type);
+  const double soldeMinimum = p_requete.soldeMinimum;
+  const double soldeMaximum = p_requete.soldeMaximum;
+  const double tauxMinimum = p_requete.tauxMinimum;
+  const double tauxMaximum = p_requete.tauxMaximum;
+  uint8_t* masque = p_masque.data ();
+  for (size_t i = 0; i < nombre; ++i)
+    {
+      masque[i] = static_cast<uint8_t> ((soldes[i] >= soldeMinimum) & (soldes[i] < soldeMaximum)
+              & (taux[i] >= tauxMinimum) & (taux[i] < tauxMaximum)
+              & (toutType | (types[i] == type)));
+    }
+}
+
+
+/**
+ * \brief Vérifie que toutes les colonnes ont le même nombre de lignes
+ */
+void TableComptes::verifieInvariant() const
+{
+  INVARIANT(m_folios.size () == m_numeros.size ());
+  INVARIANT(m_types.size () == m_numeros.size ());
+  INVARIANT(m_soldes.size () == m_numeros.size ());
+  INVARIANT(m_taux.size () == m_numeros.size ());
+  INVARIANT(m_nombresTransactions.size () == m_numeros.size ());
+  INVARIANT(m_tauxMinimums.size () == m_numeros.size ());
+}
+
+} //namespace bancaire
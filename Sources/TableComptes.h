@@ -0,0 +1,138 @@
+/**
+ * \file TableComptes.h
+ * \brief Fichier qui contient l'interface de la classe TableComptes et de ses requêtes.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef TABLECOMPTES_H
+#define TABLECOMPTES_H
+
+#include "Banque.h"
+#include "Client.h"
+#include "VersionsClients.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \brief Type concret d'un compte dans la table
+ */
+enum class TypeCompte : std::uint8_t
+{
+  Cheque,
+  Epargne
+};
+
+/**
+ * \brief Colonne agrégée par une requête
+ */
+enum class Mesure
+{
+  Solde,
+  TauxInteret,
+  NombreTransactions
+};
+
+/**
+ * \brief Clé de regroupement d'une requête
+ *        TrancheTaux et TrancheSolde découpent la colonne en tranches de
+ *        largeurTranche ; la clé d'une tranche est son indice, la tranche k
+ *        couvrant [k * largeurTranche, (k + 1) * largeurTranche[.
+ */
+enum class Groupement
+{
+  Aucun,
+  Type,
+  TrancheTaux,
+  TrancheSolde
+};
+
+/**
+ * \struct RequeteComptes
+ * \brief Filtre, mesure et regroupement d'une requête sur la table des comptes.
+ *
+ * Les bornes des filtres sont inclusives en bas et exclusives en haut ; par
+ * défaut, rien n'est filtré. Le découvert total des comptes chèque s'obtient
+ * par exemple avec filtrerType, type = Cheque et soldeMaximum = 0.
+ */
+struct RequeteComptes
+{
+  bool filtrerType = false;
+  TypeCompte type = TypeCompte::Cheque;
+  double soldeMinimum = -std::numeric_limits<double>::infinity ();
+  double soldeMaximum = std::numeric_limits<double>::infinity ();
+  double tauxMinimum = -std::numeric_limits<double>::infinity ();
+  double tauxMaximum = std::numeric_limits<double>::infinity ();
+  Mesure mesure = Mesure::Solde;
+  Groupement groupement = Groupement::Aucun;
+  double largeurTranche = 1;
+};
+
+/**
+ * \struct Agregat
+ * \brief Agrégats d'un groupe ; minimum et maximum ne valent que si nombre > 0.
+ */
+struct Agregat
+{
+  std::int64_t cle = 0;
+  std::size_t nombre = 0;
+  double somme = 0;
+  double minimum = std::numeric_limits<double>::infinity ();
+  double maximum = -std::numeric_limits<double>::infinity ();
+};
+
+/**
+ * \class TableComptes
+ * \brief Copie en colonnes des comptes d'une banque, sur laquelle s'exécutent
+ *        des requêtes de filtrage et d'agrégation.
+ *
+ * Chaque attribut des comptes est rangé dans son propre tableau contigu. Une
+ * requête évalue d'abord ses prédicats colonne par colonne, sans branchement,
+ * dans un masque de sélection : ces boucles sont vectorisées par le
+ * compilateur. Les agrégats sont ensuite calculés sur le masque, à plusieurs
+ * accumulateurs indépendants quand il n'y a pas de regroupement.
+ *
+ * La table est une copie : elle ne suit pas les modifications faites à la
+ * banque après sa construction. Construite à partir d'un instantané épinglé,
+ * elle peut l'être d'un autre fil pendant que la banque continue ses mutations.
+ */
+class TableComptes
+{
+public:
+  TableComptes();
+  explicit TableComptes(const Banque& p_banque);
+  explicit TableComptes(const VersionsClients::Instantane& p_instantane);
+
+  //accesseurs
+  std::size_t reqNombreComptes() const;
+  const std::vector<std::int32_t>& reqFolios() const;
+  const std::vector<std::int32_t>& reqNumeros() const;
+  const std::vector<TypeCompte>& reqTypes() const;
+  const std::vector<double>& reqSoldes() const;
+  const std::vector<double>& reqTaux() const;
+  const std::vector<std::int32_t>& reqNombresTransactions() const;
+  const std::vector<double>& reqTauxMinimums() const;
+
+  //methodes
+  void ajouterClient(const Client& p_client);
+  std::vector<Agregat> executer(const RequeteComptes& p_requete) const;
+
+private:
+  void selectionner(const RequeteComptes& p_requete, std::vector<std::uint8_t>& p_masque) const;
+  void verifieInvariant() const;
+
+  std::vector<std::int32_t> m_folios;
+  std::vector<std::int32_t> m_numeros;
+  std::vector<TypeCompte> m_types;
+  std::vector<double> m_soldes;
+  std::vector<double> m_taux;
+  std::vector<std::int32_t> m_nombresTransactions;
+  std::vector<double> m_tauxMinimums;
+};
+
+} //namespace bancaire
+
+#endif /* TABLECOMPTES_H */
@@ -0,0 +1,199 @@
+/**
+ * \file TableComptesTesteur.cpp
+ * \brief Test unitaire de la classe TableComptes.
+ *
+ * À tester :
+ *         TableComptes(const Banque& p_banque);
+ *         TableComptes(const VersionsClients::Instantane& p_instantane);
+ *         void ajouterClient(const Client& p_client);
+ *         std::vector<Agregat> executer(const RequeteComptes& p_requete) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "TableComptes.h"
+#include "Cheque.h"
+#include "ContratException.h"
+#include "Epargne.h"
+#include "GenerateurCharge.h"
+#include "Journal.h"
+#include <cmath>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : deux clients, trois comptes chèque dont deux
+ *        à découvert, et trois comptes épargne à des taux différents
+ */
+class TableComptesTest : public ::testing::Test
+{
+public:
+  TableComptesTest()
+  {
+    Client client1(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983));
+    client1.ajouterCompte (Cheque(1, 10, -150, 4, "Loyer", 1));
+    client1.ajouterCompte (Epargne(2, 1.5, 1000, "Etudes"));
+    client1.ajouterCompte (Epargne(3, 2.7, 500, "Voyage"));
+    Client client2(2000, "Carlo", "Ancelotti", "590 234-0342", util::Date(20, 1, 1983));
+    client2.ajouterCompte (Cheque(1, 5, -50.5, 2, "Courant", 1));
+    client2.ajouterCompte (Cheque(2, 20, 300, 3, "Paie", 1));
+    client2.ajouterCompte (Epargne(3, 1.2, 250, "Retraite"));
+    f_banque.ajouterClient (client1);
+    f_banque.ajouterClient (client2);
+  }
+
+  Banque f_banque;
+};
+
+
+/**
+ * \brief Test du constructeur TableComptes(const Banque& p_banque);
+ *     Cas valide : chaque compte de chaque client devient une ligne de la table.
+ *     Cas invalide : aucun
+ */
+TEST_F(TableComptesTest, constructeur_Banque_UneLigneParCompte)
+{
+  TableComptes table(f_banque);
+  ASSERT_EQ(6u, table.reqNombreComptes ());
+  ASSERT_EQ(1000, table.reqFolios ()[0]);
+  ASSERT_EQ(TypeCompte::Cheque, table.reqTypes ()[0]);
+  ASSERT_EQ(10, table.reqNombresTransactions ()[0]);
+  ASSERT_EQ(1, table.reqTauxMinimums ()[0]);
+  ASSERT_EQ(TypeCompte::Epargne, table.reqTypes ()[1]);
+  ASSERT_EQ(0, table.reqNombresTransactions ()[1]);
+  ASSERT_EQ(0, table.reqTauxMinimums ()[1]);
+}
+
+
+/**
+ * \brief Test du constructeur TableComptes(const VersionsClients::Instantane& p_instantane);
+ *     Cas valide : la table reflète l'instantané, pas les mutations qui le suivent.
+ *     Cas invalide : aucun
+ */
+TEST_F(TableComptesTest, constructeur_Instantane_EtatEpingle)
+{
+  f_banque.activerInstantanes ();
+  VersionsClients::Instantane instantane = f_banque.epingler ();
+  Client client3(3000, "Zidane", "Zinedine", "418 555-1234", util::Date(23, 6, 1972));
+  client3.ajouterCompte (Epargne(1, 1, 10, "Maison"));
+  f_banque.ajouterClient (client3);
+  EnregistrementJournal solde;
+  solde.type = TypeOperation::AsgSolde;
+  solde.noFolio = 1000;
+  solde.noCompte = 1;
+  solde.solde = 0;
+  f_banque.appliquer (solde);
+
+  TableComptes table(instantane);
+  ASSERT_EQ(6u, table.reqNombreComptes ());
+  ASSERT_EQ(-150, table.reqSoldes ()[0]);
+  ASSERT_EQ(7u, TableComptes(f_banque.epingler ()).reqNombreComptes ());
+}
+
+
+/**
+ * \brief Test de la méthode std::vector<Agregat> executer(const RequeteComptes& p_requete) const;
+ *     Cas valides : découvert total des comptes chèque, soldes épargne par
+ *                   tranche de taux, regroupement par type, requête sans résultat.
+ *     Cas invalide : une largeur de tranche nulle est refusée.
+ */
+TEST_F(TableComptesTest, executer_DecouvertCheques_SommeDesSoldesNegatifs)
+{
+  RequeteComptes requete;
+  requete.filtrerType = true;
+  requete.type = TypeCompte::Cheque;
+  requete.soldeMaximum = 0;
+  vector<Agregat> resultat = TableComptes(f_banque).executer (requete);
+
+  ASSERT_EQ(1u, resultat.size ());
+  ASSERT_EQ(2u, resultat[0].nombre);
+  ASSERT_DOUBLE_EQ(-200.5, resultat[0].somme);
+  ASSERT_DOUBLE_EQ(-150, resultat[0].minimum);
+  ASSERT_DOUBLE_EQ(-50.5, resultat[0].maximum);
+}
+
+TEST_F(TableComptesTest, executer_EpargneParTrancheDeTaux_UnGroupeParTranche)
+{
+  RequeteComptes requete;
+  requete.filtrerType = true;
+  requete.type = TypeCompte::Epargne;
+  requete.groupement = Groupement::TrancheTaux;
+  requete.largeurTranche = 1;
+  vector<Agregat> resultat = TableComptes(f_banque).executer (requete);
+
+  ASSERT_EQ(2u, resultat.size ());
+  ASSERT_EQ(1, resultat[0].cle);
+  ASSERT_EQ(2u, resultat[0].nombre);
+  ASSERT_DOUBLE_EQ(1250, resultat[0].somme);
+  ASSERT_EQ(2, resultat[1].cle);
+  ASSERT_DOUBLE_EQ(500, resultat[1].somme);
+}
+
+TEST_F(TableComptesTest, executer_ParType_MesureNombreTransactions)
+{
+  RequeteComptes requete;
+  requete.groupement = Groupement::Type;
+  requete.mesure = Mesure::NombreTransactions;
+  vector<Agregat> resultat = TableComptes(f_banque).executer (requete);
+
+  ASSERT_EQ(2u, resultat.size ());
+  ASSERT_EQ(static_cast<int64_t> (TypeCompte::Cheque), resultat[0].cle);
+  ASSERT_DOUBLE_EQ(35, resultat[0].somme);
+  ASSERT_DOUBLE_EQ(20, resultat[0].maximum);
+  ASSERT_EQ(3u, resultat[1].nombre);
+  ASSERT_DOUBLE_EQ(0, resultat[1].somme);
+}
+
+TEST_F(TableComptesTest, executer_AucunCompteRetenu_AgregatVide)
+{
+  RequeteComptes requete;
+  requete.soldeMinimum = 1e9;
+  vector<Agregat> total = TableComptes(f_banque).executer (requete);
+  ASSERT_EQ(1u, total.size ());
+  ASSERT_EQ(0u, total[0].nombre);
+  requete.groupement = Groupement::Type;
+  ASSERT_TRUE(TableComptes(f_banque).executer (requete).empty ());
+}
+
+TEST_F(TableComptesTest, executer_LargeurTrancheNulle_ExceptionLevee)
+{
+  RequeteComptes requete;
+  requete.groupement = Groupement::TrancheSolde;
+  requete.largeurTranche = 0;
+  ASSERT_THROW(TableComptes(f_banque).executer (requete), PreconditionException);
+}
+
+
+/**
+ * \brief Test de cohérence de std::vector<Agregat> executer(const RequeteComptes& p_requete) const;
+ *     Cas valide : sur une population synthétique, la somme vectorisée égale
+ *                  celle d'un parcours simple, et les groupes par tranche de
+ *                  solde se partagent tous les comptes.
+ *     Cas invalide : aucun
+ */
+TEST(TableComptes, executer_PopulationSynthetique_CoherentAvecParcoursSimple)
+{
+  ParametresCharge parametres;
+  parametres.nombreComptes = 5000;
+  TableComptes table(GenerateurCharge(parametres).construireBanque ());
+
+  double attendu = 0;
+  for (size_t i = 0; i < table.reqNombreComptes (); ++i)
+    {
+      attendu += table.reqSoldes ()[i];
+    }
+  RequeteComptes requete;
+  vector<Agregat> total = table.executer (requete);
+  ASSERT_EQ(table.reqNombreComptes (), total[0].nombre);
+  ASSERT_NEAR(attendu, total[0].somme, 1e-6 * (1 + fabs (attendu)));
+
+  requete.groupement = Groupement::TrancheSolde;
+  requete.largeurTranche = 0.5;
+  size_t nombre = 0;
+  for (const Agregat& groupe : table.executer (requete))
+    {
+      nombre += groupe.nombre;
+    }
+  ASSERT_EQ(table.reqNombreComptes (), nombre);
+}
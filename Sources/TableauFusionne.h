@@ -0,0 +1,157 @@
+/**
+ * \file TableauFusionne.h
+ * \brief Fichier qui contient l'interface et l'implantation du gabarit TableauFusionne.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef TABLEAUFUSIONNE_H
+#define TABLEAUFUSIONNE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace bancaire
+{
+/**
+ * \class TableauFusionne
+ * \brief Tableau trié d'entrées, alimenté par un tampon de récentes fusionné par lots.
+ *
+ * Mécanique commune à IndexNoms et IndexOrdonne. Les ajouts vont d'abord dans
+ * un petit tableau trié d'entrées récentes, fusionné dans le tableau principal
+ * lorsqu'il dépasse FACTEUR_RECENTS fois la racine carrée de sa taille : un
+ * ajout coûte ainsi O(√n) en moyenne. Un parcours fait une recherche
+ * dichotomique dans chacun des deux tableaux puis les lit ensemble,
+ * séquentiellement, dans l'ordre.
+ *
+ * L'ordre est donné à chaque appel par un prédicat precede(gauche, droite)
+ * plutôt que conservé dans l'objet : celui d'IndexNoms lit les clés dans le
+ * tampon de caractères de l'index, et une copie de l'index ne doit pas
+ * comparer avec le tampon de l'original. Tous les appels d'un même tableau
+ * doivent utiliser le même ordre.
+ */
+template<typename Entree>
+class TableauFusionne
+{
+public:
+  /**
+   * \brief Taille en deçà de laquelle les récentes ne sont jamais fusionnées
+   */
+  static constexpr std::size_t TAILLE_RECENTS_MIN = 256;
+
+  /**
+   * \brief Les récentes sont fusionnées au-delà de FACTEUR_RECENTS * √n entrées :
+   *        chaque fusion recopie tout le tableau principal, et décaler un
+   *        tableau de récentes plus grand coûte moins cher que fusionner plus souvent.
+   */
+  static constexpr double FACTEUR_RECENTS = 16;
+
+  //accesseurs
+  std::size_t reqNombreEntrees() const;
+
+  //methodes
+  template<typename Precede>
+  void ajouter(const Entree& p_entree, Precede p_precede);
+  template<typename Avant, typename Retenue, typename Precede, typename Visiteur>
+  void parcourir(Avant p_avant, Retenue p_retenue, Precede p_precede, Visiteur p_visiteur) const;
+
+private:
+  template<typename Precede>
+  void fusionner(Precede p_precede);
+
+  std::vector<Entree> m_principal;
+  std::vector<Entree> m_recents;
+};
+
+
+/**
+ * \brief Retourne le nombre d'entrées du tableau
+ * \return un size_t qui représente le nombre d'entrées, récentes comprises
+ */
+template<typename Entree>
+std::size_t TableauFusionne<Entree>::reqNombreEntrees() const
+{
+  return m_principal.size () + m_recents.size ();
+}
+
+
+/**
+ * \brief Ajoute une entrée, après celles qui lui sont équivalentes
+ * \param[in] p_entree l'entrée à ajouter
+ * \param[in] p_precede l'ordre strict des entrées
+ */
+template<typename Entree>
+template<typename Precede>
+void TableauFusionne<Entree>::ajouter(const Entree& p_entree, Precede p_precede)
+{
+  m_recents.insert (std::upper_bound (m_recents.begin (), m_recents.end (), p_entree, p_precede), p_entree);
+  const std::size_t seuil = std::max (TAILLE_RECENTS_MIN, static_cast<std::size_t> (
+          FACTEUR_RECENTS * std::sqrt (static_cast<double> (m_principal.size ()))));
+  if (m_recents.size () > seuil)
+    {
+      fusionner (p_precede);
+    }
+}
+
+
+/**
+ * \brief Visite dans l'ordre les entrées d'un intervalle, prises dans les deux tableaux
+ * \param[in] p_avant vrai pour une entrée qui précède le début de l'intervalle
+ * \param[in] p_retenue vrai pour une entrée qui n'a pas dépassé la fin de l'intervalle
+ * \param[in] p_precede l'ordre strict des entrées ; à égalité, le tableau principal d'abord
+ * \param[in] p_visiteur appelé pour chaque entrée retenue ; le parcours s'arrête s'il rend faux
+ */
+template<typename Entree>
+template<typename Avant, typename Retenue, typename Precede, typename Visiteur>
+void TableauFusionne<Entree>::parcourir(Avant p_avant, Retenue p_retenue, Precede p_precede,
+                                        Visiteur p_visiteur) const
+{
+  auto principal = std::partition_point (m_principal.begin (), m_principal.end (), p_avant);
+  auto recent = std::partition_point (m_recents.begin (), m_recents.end (), p_avant);
+  bool principalRetenu = principal != m_principal.end () && p_retenue (*principal);
+  bool recentRetenu = recent != m_recents.end () && p_retenue (*recent);
+  while (principalRetenu || recentRetenu)
+    {
+      if (principalRetenu && (!recentRetenu || !p_precede (*recent, *principal)))
+        {
+          if (!p_visiteur (*principal))
+            {
+              return;
+            }
+          ++principal;
+          principalRetenu = principal != m_principal.end () && p_retenue (*principal);
+        }
+      else
+        {
+          if (!p_visiteur (*recent))
+            {
+              return;
+            }
+          ++recent;
+          recentRetenu = recent != m_recents.end () && p_retenue (*recent);
+        }
+    }
+}
+
+
+/**
+ * \brief Fusionne les entrées récentes dans le tableau principal
+ * \param[in] p_precede l'ordre strict des entrées
+ */
+template<typename Entree>
+template<typename Precede>
+void TableauFusionne<Entree>::fusionner(Precede p_precede)
+{
+  std::vector<Entree> fusion;
+  fusion.reserve (m_principal.size () + m_recents.size ());
+  std::merge (m_principal.begin (), m_principal.end (), m_recents.begin (), m_recents.end (),
+              std::back_inserter (fusion), p_precede);
+  m_principal.swap (fusion);
+  m_recents.clear ();
+}
+
+} //namespace bancaire
+
+#endif /* TABLEAUFUSIONNE_H */
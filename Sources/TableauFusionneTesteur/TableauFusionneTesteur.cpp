@@ -0,0 +1,102 @@
+/**
+ * \file TableauFusionneTesteur.cpp
+ * \brief Test unitaire du gabarit TableauFusionne.
+ *
+ * À tester :
+ *         std::size_t reqNombreEntrees() const;
+ *         template<typename Precede>
+ *         void ajouter(const Entree& p_entree, Precede p_precede);
+ *         template<typename Avant, typename Retenue, typename Precede, typename Visiteur>
+ *         void parcourir(Avant p_avant, Retenue p_retenue, Precede p_precede, Visiteur p_visiteur) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "TableauFusionne.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+typedef pair<int, int> Entree;
+
+bool
+precedeCle (const Entree& p_gauche, const Entree& p_droite)
+{
+  return p_gauche.first < p_droite.first;
+}
+
+
+/**
+ * \brief Lit les entrées dont la clé est dans [p_minimum, p_maximum], au plus p_nombre
+ */
+vector<Entree>
+lire (const TableauFusionne<Entree>& p_tableau, int p_minimum, int p_maximum, size_t p_nombre = 1u << 30)
+{
+  vector<Entree> entrees;
+  p_tableau.parcourir ([p_minimum] (const Entree& p_entree)
+  {
+    return p_entree.first < p_minimum;
+  }, [p_maximum] (const Entree& p_entree)
+  {
+    return p_entree.first <= p_maximum;
+  }, precedeCle, [&entrees, p_nombre] (const Entree& p_entree)
+  {
+    entrees.push_back (p_entree);
+    return entrees.size () < p_nombre;
+  });
+  return entrees;
+}
+} //namespace
+
+
+/**
+ * \brief Test de la méthode void ajouter(const Entree& p_entree, Precede p_precede);
+ *     Cas valides : assez d'ajouts dans le désordre pour provoquer plusieurs
+ *                   fusions, toutes les entrées sont comptées et relues dans
+ *                   l'ordre ; des entrées équivalentes gardent leur ordre d'ajout,
+ *                   qu'elles soient fusionnées ou encore récentes.
+ *     Cas invalide : aucun
+ */
+TEST(TableauFusionne, ajouter_NombreusesEntrees_ReluesDansLOrdre)
+{
+  TableauFusionne<Entree> tableau;
+  const int nombre = 5000;
+  for (int i = 0; i < nombre; ++i)
+    {
+      tableau.ajouter (Entree((i * 7919) % nombre, i), precedeCle);
+    }
+  tableau.ajouter (Entree(42, -1), precedeCle);
+  ASSERT_EQ(static_cast<size_t> (nombre + 1), tableau.reqNombreEntrees ());
+
+  vector<Entree> entrees = lire (tableau, 0, nombre);
+  ASSERT_EQ(static_cast<size_t> (nombre + 1), entrees.size ());
+  ASSERT_TRUE(is_sorted (entrees.begin (), entrees.end (), precedeCle));
+  vector<Entree> egales = lire (tableau, 42, 42);
+  ASSERT_EQ(2u, egales.size ());
+  ASSERT_EQ(-1, egales[1].second);
+}
+
+
+/**
+ * \brief Test de la méthode void parcourir(Avant p_avant, Retenue p_retenue, Precede p_precede, Visiteur p_visiteur) const;
+ *     Cas valides : seules les entrées de l'intervalle sont visitées, et le
+ *                   parcours s'arrête dès que le visiteur rend faux.
+ *     Cas invalide : un intervalle vide ne visite rien.
+ */
+TEST(TableauFusionne, parcourir_Intervalle_EntreesRetenues)
+{
+  TableauFusionne<Entree> tableau;
+  for (int cle : {50, 10, 40, 20, 30})
+    {
+      tableau.ajouter (Entree(cle, cle), precedeCle);
+    }
+  ASSERT_EQ((vector<Entree> {{20, 20}, {30, 30}, {40, 40}}), lire (tableau, 15, 45));
+  ASSERT_EQ((vector<Entree> {{20, 20}}), lire (tableau, 15, 45, 1));
+  ASSERT_TRUE(lire (tableau, 31, 39).empty ());
+  ASSERT_EQ(0u, TableauFusionne<Entree>().reqNombreEntrees ());
+}
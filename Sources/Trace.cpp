@@ -0,0 +1,265 @@
+/**
+ * \file Trace.cpp
+ * \brief Implantation des tampons de traçage par fil et de l'export Chrome Trace
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace trace
+{
+namespace
+{
+/**
+ * \brief Un événement : une durée (phase X) ou une valeur de compteur (phase C)
+ */
+struct Evenement
+{
+  const char* nom;
+  uint64_t debut;
+  uint64_t duree;
+  int64_t valeur;
+  char phase;
+};
+
+
+/**
+ * \brief Tampon d'un fil. Seul son fil y écrit ; le nombre d'événements est
+ *        publié après chaque écriture pour que l'export lise des événements complets.
+ */
+struct TamponFil
+{
+  explicit TamponFil (unsigned p_identifiant) : identifiant(p_identifiant), evenements(CAPACITE_FIL) { }
+
+  const unsigned identifiant;
+  vector<Evenement> evenements;
+  atomic<size_t> nombre {0};
+  atomic<uint64_t> perdus {0};
+  atomic<bool> enUsage {true};
+};
+
+
+struct Registre
+{
+  mutex verrou;
+  vector<unique_ptr<TamponFil>> tampons;
+  const chrono::steady_clock::time_point origine = chrono::steady_clock::now ();
+};
+
+
+Registre&
+registre ()
+{
+  static Registre instance;
+  return instance;
+}
+
+
+TamponFil*
+obtenirTampon ()
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  for (auto& tampon : reg.tampons)
+    {
+      bool libre = false;
+      if (tampon->enUsage.compare_exchange_strong (libre, true))
+        {
+          return tampon.get ();
+        }
+    }
+  reg.tampons.push_back (make_unique<TamponFil>(static_cast<unsigned> (reg.tampons.size () + 1)));
+  return reg.tampons.back ().get ();
+}
+
+
+/**
+ * \brief Rattache un tampon au fil courant et le libère à la fin du fil ;
+ *        ses événements restent exportables.
+ */
+struct Attache
+{
+  TamponFil* tampon = obtenirTampon ();
+  ~Attache ()
+  {
+    tampon->enUsage.store (false, memory_order_release);
+  }
+};
+
+
+void
+consigner (const Evenement& p_evenement)
+{
+  thread_local Attache attache;
+  TamponFil& tampon = *attache.tampon;
+  size_t nombre = tampon.nombre.load (memory_order_relaxed);
+  if (nombre == tampon.evenements.size ())
+    {
+      tampon.perdus.store (tampon.perdus.load (memory_order_relaxed) + 1, memory_order_relaxed);
+      return;
+    }
+  tampon.evenements[nombre] = p_evenement;
+  tampon.nombre.store (nombre + 1, memory_order_release);
+}
+
+
+void
+ecrireNom (ostream& p_os, const char* p_nom)
+{
+  p_os << '"';
+  for (const char* c = p_nom; *c != '\0'; ++c)
+    {
+      if (*c == '"' || *c == '\\')
+        {
+          p_os << '\\';
+        }
+      p_os << *c;
+    }
+  p_os << '"';
+}
+
+
+/**
+ * \brief Horodatage en microsecondes, l'unité du format Chrome Trace
+ */
+void
+ecrireMicrosecondes (ostream& p_os, uint64_t p_nanosecondes)
+{
+  p_os << p_nanosecondes / 1000 << '.' << setw (3) << setfill ('0') << p_nanosecondes % 1000
+       << setfill (' ');
+}
+} //namespace
+
+
+/**
+ * \brief Retourne l'instant présent depuis le début du traçage
+ * \return un nombre de nanosecondes
+ */
+std::uint64_t maintenant()
+{
+  return static_cast<uint64_t> (chrono::duration_cast<chrono::nanoseconds>(
+          chrono::steady_clock::now () - registre ().origine).count ());
+}
+
+
+/**
+ * \brief Consigne une durée dans le tampon du fil courant
+ * \param[in] p_nom le nom de la portée, une chaîne littérale
+ * \param[in] p_debut l'instant du début, obtenu de maintenant()
+ * \param[in] p_fin l'instant de la fin, obtenu de maintenant()
+ */
+void consignerDuree(const char* p_nom, std::uint64_t p_debut, std::uint64_t p_fin)
+{
+  consigner (Evenement {p_nom, p_debut, p_fin - p_debut, 0, 'X'});
+}
+
+
+/**
+ * \brief Consigne la valeur courante d'un compteur dans le tampon du fil courant
+ * \param[in] p_nom le nom du compteur, une chaîne littérale
+ * \param[in] p_valeur la valeur à cet instant
+ */
+void compter(const char* p_nom, std::int64_t p_valeur)
+{
+  consigner (Evenement {p_nom, maintenant (), 0, p_valeur, 'C'});
+}
+
+
+/**
+ * \brief Écrit tous les événements consignés au format JSON Chrome Trace
+ * \param[in] p_os le flux de sortie
+ */
+void exporterChrome(std::ostream& p_os)
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  p_os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool premier = true;
+  for (const auto& tampon : reg.tampons)
+    {
+      p_os << (premier ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << tampon->identifiant << ",\"args\":{\"name\":\"fil " << tampon->identifiant << "\"}}";
+      premier = false;
+      size_t nombre = tampon->nombre.load (memory_order_acquire);
+      for (size_t i = 0; i < nombre; ++i)
+        {
+          const Evenement& evenement = tampon->evenements[i];
+          p_os << ",\n{\"name\":";
+          ecrireNom (p_os, evenement.nom);
+          p_os << ",\"cat\":\"bancaire\",\"ph\":\"" << evenement.phase << "\",\"pid\":1,\"tid\":"
+               << tampon->identifiant << ",\"ts\":";
+          ecrireMicrosecondes (p_os, evenement.debut);
+          if (evenement.phase == 'X')
+            {
+              p_os << ",\"dur\":";
+              ecrireMicrosecondes (p_os, evenement.duree);
+            }
+          else
+            {
+              p_os << ",\"args\":{\"valeur\":" << evenement.valeur << "}";
+            }
+          p_os << "}";
+        }
+    }
+  p_os << "\n]}\n";
+}
+
+
+/**
+ * \brief Retourne le nombre d'événements consignés par tous les fils
+ * \return un size_t qui représente le nombre d'événements exportables
+ */
+std::size_t reqNombreEvenements()
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  size_t total = 0;
+  for (const auto& tampon : reg.tampons)
+    {
+      total += tampon->nombre.load (memory_order_acquire);
+    }
+  return total;
+}
+
+
+/**
+ * \brief Retourne le nombre d'événements perdus faute de place dans un tampon
+ * \return un entier qui représente le nombre d'événements perdus
+ */
+std::uint64_t reqNombrePerdus()
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  uint64_t total = 0;
+  for (const auto& tampon : reg.tampons)
+    {
+      total += tampon->perdus.load (memory_order_relaxed);
+    }
+  return total;
+}
+
+
+/**
+ * \brief Oublie tous les événements consignés
+ *        À appeler quand aucun fil ne trace.
+ */
+void vider()
+{
+  Registre& reg = registre ();
+  lock_guard<mutex> verrou(reg.verrou);
+  for (auto& tampon : reg.tampons)
+    {
+      tampon->nombre.store (0, memory_order_release);
+      tampon->perdus.store (0, memory_order_relaxed);
+    }
+}
+
+} // namespace trace
@@ -0,0 +1,72 @@
+/**
+ * \file Trace.h
+ * \brief Macros de traçage TRACE_SCOPE et TRACE_COUNT, exportables au format
+ *        Chrome Trace (chrome://tracing, Perfetto).
+ *
+ * Comme les macros de ContratException.h, elles ne produisent aucun code tant
+ * que BANCAIRE_TRACE n'est pas défini : une compilation de production n'en
+ * garde aucune trace. Lorsqu'elles sont actives, chaque fil consigne ses
+ * événements dans son propre tampon de taille fixe, sans verrou ; les
+ * événements qui ne tiennent plus dans le tampon sont comptés comme perdus.
+ *
+ * Les noms passés aux macros doivent être des chaînes littérales : seul leur
+ * pointeur est conservé.
+ *
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace trace
+{
+const std::size_t CAPACITE_FIL = 1 << 16;
+
+std::uint64_t maintenant();
+void consignerDuree(const char* p_nom, std::uint64_t p_debut, std::uint64_t p_fin);
+void compter(const char* p_nom, std::int64_t p_valeur);
+void exporterChrome(std::ostream& p_os);
+std::size_t reqNombreEvenements();
+std::uint64_t reqNombrePerdus();
+void vider();
+
+/**
+ * \class Portee
+ * \brief Consigne la durée de sa propre portée comme un événement complet.
+ */
+class Portee
+{
+public:
+  explicit Portee (const char* p_nom) : m_nom(p_nom), m_debut(maintenant ()) { }
+  ~Portee () { consignerDuree (m_nom, m_debut, maintenant ()); }
+  Portee (const Portee&) = delete;
+  Portee& operator= (const Portee&) = delete;
+
+private:
+  const char* m_nom;
+  std::uint64_t m_debut;
+};
+} // namespace trace
+
+
+#define TRACE_CONCATENER_(a, b) a##b
+#define TRACE_CONCATENER(a, b) TRACE_CONCATENER_(a, b)
+
+#if defined(BANCAIRE_TRACE)
+
+#define TRACE_SCOPE(nom) \
+      trace::Portee TRACE_CONCATENER(porteeTrace_, __LINE__)(nom)
+#define TRACE_COUNT(nom, valeur) \
+      trace::compter (nom, static_cast<std::int64_t> (valeur))
+
+#else
+
+#define TRACE_SCOPE(nom)
+#define TRACE_COUNT(nom, valeur)
+
+#endif  // --- if defined (BANCAIRE_TRACE)
+#endif /* TRACE_H */
@@ -0,0 +1,111 @@
+/**
+ * \file TraceTesteur.cpp
+ * \brief Test unitaire des macros de traçage et de l'export Chrome Trace.
+ *
+ * Les macros sont activées pour ce fichier seulement ; la bibliothèque est
+ * compilée sans BANCAIRE_TRACE et ne doit donc rien consigner.
+ *
+ * À tester :
+ *         TRACE_SCOPE(nom);
+ *         TRACE_COUNT(nom, valeur);
+ *         void exporterChrome(std::ostream& p_os);
+ *         void vider();
+ *
+ */
+
+#define BANCAIRE_TRACE
+#include <gtest/gtest.h>
+#include "Trace.h"
+#include "Client.h"
+#include "Epargne.h"
+#include <sstream>
+#include <thread>
+
+using namespace bancaire;
+using namespace std;
+
+namespace
+{
+void
+fonctionTracee (int p_profondeur)
+{
+  TRACE_SCOPE("fonctionTracee");
+  TRACE_COUNT("profondeur", p_profondeur);
+  if (p_profondeur > 0)
+    {
+      fonctionTracee (p_profondeur - 1);
+    }
+}
+} //namespace
+
+
+/**
+ * \brief Création d'une fixture qui part de tampons vides
+ */
+class TraceTest : public ::testing::Test
+{
+public:
+  TraceTest()
+  {
+    trace::vider ();
+  }
+};
+
+
+/**
+ * \brief Test des macros TRACE_SCOPE(nom); et TRACE_COUNT(nom, valeur);
+ *     Cas valides : chaque portée et chaque compteur donnent un événement ;
+ *                   le code compilé sans BANCAIRE_TRACE n'en donne aucun.
+ *     Cas invalide : aucun
+ */
+TEST_F(TraceTest, TRACE_SCOPE_PorteesImbriquees_UnEvenementParPortee)
+{
+  fonctionTracee (2);
+  ASSERT_EQ(6u, trace::reqNombreEvenements ());
+  ASSERT_EQ(0u, trace::reqNombrePerdus ());
+}
+
+TEST_F(TraceTest, TRACE_SCOPE_BibliothequeSansTrace_AucunEvenement)
+{
+  Client client(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983));
+  client.ajouterCompte (Epargne(1, 1.5, 100.0, "Etudes"));
+  client.reqReleves ();
+  ASSERT_EQ(0u, trace::reqNombreEvenements ());
+}
+
+
+/**
+ * \brief Test de la méthode void exporterChrome(std::ostream& p_os);
+ *     Cas valides : les événements de chaque fil sont exportés avec leur phase,
+ *                   leur fil et leur durée.
+ *     Cas invalide : un tampon plein compte les événements perdus.
+ */
+TEST_F(TraceTest, exporterChrome_DeuxFils_EvenementsExportes)
+{
+  fonctionTracee (0);
+  thread autre([] ()
+  {
+    TRACE_SCOPE("autreFil");
+  });
+  autre.join ();
+
+  ostringstream os;
+  trace::exporterChrome (os);
+  string json = os.str ();
+  ASSERT_EQ(0u, json.find ("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+  ASSERT_NE(string::npos, json.find ("\"name\":\"fonctionTracee\",\"cat\":\"bancaire\",\"ph\":\"X\""));
+  ASSERT_NE(string::npos, json.find ("\"name\":\"profondeur\",\"cat\":\"bancaire\",\"ph\":\"C\""));
+  ASSERT_NE(string::npos, json.find ("\"args\":{\"valeur\":0}"));
+  ASSERT_NE(string::npos, json.find ("\"name\":\"autreFil\""));
+  ASSERT_NE(string::npos, json.find ("\"dur\":"));
+}
+
+TEST_F(TraceTest, consigner_TamponPlein_EvenementsPerdus)
+{
+  for (size_t i = 0; i < trace::CAPACITE_FIL + 10; ++i)
+    {
+      TRACE_COUNT("compteur", i);
+    }
+  ASSERT_EQ(trace::CAPACITE_FIL, trace::reqNombreEvenements ());
+  ASSERT_EQ(10u, trace::reqNombrePerdus ());
+}
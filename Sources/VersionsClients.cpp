@@ -0,0 +1,296 @@
+/**
+ * \file VersionsClients.cpp
+ * \brief Implantation de la classe VersionsClients et de ses instantanés
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#include "VersionsClients.h"
+#include "ClientException.h"
+#include "ContratException.h"
+#include <thread>
+
+using namespace std;
+
+namespace bancaire
+{
+namespace
+{
+/**
+ * \brief Valeur d'une case d'épinglage libre ; les époques commencent à 1
+ */
+const uint64_t CASE_LIBRE = 0;
+} //namespace
+
+
+VersionsClients::Version::Version(std::uint64_t p_epoque, const Client& p_client, Version* p_precedente):
+        epoque(p_epoque), client(p_client), precedente(p_precedente) { }
+
+
+/**
+ * \brief Constructeur de la classe VersionsClients
+ *        On construit un ensemble sans client, à l'époque 1, sans lecteur.
+ */
+VersionsClients::VersionsClients():
+        m_tetes(new atomic<Version*>[NOMBRE_FOLIOS]), m_epoque(1), m_nombreVersions(0)
+{
+  for (size_t folio = 0; folio < NOMBRE_FOLIOS; ++folio)
+    {
+      m_tetes[folio].store (nullptr, memory_order_relaxed);
+    }
+  for (auto& epingle : m_epingles)
+    {
+      epingle.store (CASE_LIBRE, memory_order_relaxed);
+    }
+}
+
+
+/**
+ * \brief Destructeur ; libère toutes les versions
+ * \pre aucun instantané ne doit encore exister
+ */
+VersionsClients::~VersionsClients()
+{
+  for (size_t folio = 0; folio < NOMBRE_FOLIOS; ++folio)
+    {
+      Version* version = m_tetes[folio].load (memory_order_relaxed);
+      while (version != nullptr)
+        {
+          Version* precedente = version->precedente.load (memory_order_relaxed);
+          delete version;
+          version = precedente;
+        }
+    }
+}
+
+
+/**
+ * \brief Retourne l'époque de la dernière publication
+ * \return un entier qui représente l'époque courante
+ */
+std::uint64_t VersionsClients::reqEpoque() const
+{
+  return m_epoque.load ();
+}
+
+
+/**
+ * \brief Retourne le nombre de versions conservées ; à lire par le fil qui publie
+ * \return un size_t qui représente le nombre de versions
+ */
+std::size_t VersionsClients::reqNombreVersions() const
+{
+  return m_nombreVersions;
+}
+
+
+/**
+ * \brief Publie une nouvelle version d'un client, visible des instantanés
+ *        pris à partir de maintenant
+ *        Les versions de ce client que plus aucun lecteur ne peut voir sont libérées.
+ * \param[in] p_client l'état du client à publier, copié
+ * \pre le folio du client doit être compris entre FOLIO_MINIMUM et FOLIO_MAXIMUM
+ * \post l'époque courante a avancé de 1
+ */
+void VersionsClients::publier(const Client& p_client)
+{
+  PRECONDITION(p_client.reqNoFolio () >= FOLIO_MINIMUM && p_client.reqNoFolio () <= FOLIO_MAXIMUM);
+
+  const size_t folio = static_cast<size_t> (p_client.reqNoFolio () - FOLIO_MINIMUM);
+  const uint64_t epoque = m_epoque.load () + 1;
+  Version* version = new Version(epoque, p_client, m_tetes[folio].load (memory_order_relaxed));
+  m_tetes[folio].store (version, memory_order_release);
+  m_epoque.store (epoque);
+  ++m_nombreVersions;
+  tailler (folio, reqEpoqueMinimum ());
+
+  POSTCONDITION(reqEpoque () == epoque);
+}
+
+
+/**
+ * \brief Épingle l'époque courante
+ *        S'il n'y a plus de case libre, on attend qu'un instantané soit détruit.
+ * \return un instantané des clients à l'époque courante
+ */
+VersionsClients::Instantane VersionsClients::epingler() const
+{
+  for (;;)
+    {
+      for (size_t position = 0; position < NOMBRE_LECTEURS_MAX; ++position)
+        {
+          uint64_t libre = CASE_LIBRE;
+          uint64_t epoque = m_epoque.load ();
+          if (m_epingles[position].compare_exchange_strong (libre, epoque))
+            {
+              // L'écrivain a pu tailler avant de voir l'épingle : on ne la
+              // garde que si l'époque n'a pas avancé entre-temps.
+              for (uint64_t courante = m_epoque.load (); courante != epoque; courante = m_epoque.load ())
+                {
+                  epoque = courante;
+                  m_epingles[position].store (epoque);
+                }
+              return Instantane(*this, position, epoque);
+            }
+        }
+      this_thread::yield ();
+    }
+}
+
+
+/**
+ * \brief Libère, pour tous les clients, les versions que plus aucun lecteur ne peut voir
+ */
+void VersionsClients::recuperer()
+{
+  const uint64_t epoqueMinimum = reqEpoqueMinimum ();
+  for (size_t folio = 0; folio < NOMBRE_FOLIOS; ++folio)
+    {
+      tailler (folio, epoqueMinimum);
+    }
+}
+
+
+/**
+ * \brief Retourne la plus ancienne époque qu'un lecteur peut encore voir
+ */
+std::uint64_t VersionsClients::reqEpoqueMinimum() const
+{
+  uint64_t minimum = m_epoque.load ();
+  for (const auto& epingle : m_epingles)
+    {
+      const uint64_t epoque = epingle.load ();
+      if (epoque != CASE_LIBRE && epoque < minimum)
+        {
+          minimum = epoque;
+        }
+    }
+  return minimum;
+}
+
+
+/**
+ * \brief Libère les versions d'un client plus anciennes que la plus récente
+ *        visible à l'époque p_epoqueMinimum
+ *        Un lecteur épinglé à une époque au moins égale s'arrête au plus tard
+ *        sur cette version et ne suit jamais les versions libérées.
+ */
+void VersionsClients::tailler(std::size_t p_folio, std::uint64_t p_epoqueMinimum)
+{
+  Version* version = m_tetes[p_folio].load (memory_order_relaxed);
+  while (version != nullptr && version->epoque > p_epoqueMinimum)
+    {
+      version = version->precedente.load (memory_order_relaxed);
+    }
+  if (version == nullptr)
+    {
+      return;
+    }
+  Version* perimee = version->precedente.exchange (nullptr);
+  while (perimee != nullptr)
+    {
+      Version* precedente = perimee->precedente.load (memory_order_relaxed);
+      delete perimee;
+      --m_nombreVersions;
+      perimee = precedente;
+    }
+}
+
+
+VersionsClients::Instantane::Instantane(const VersionsClients& p_versions, std::size_t p_case, std::uint64_t p_epoque):
+        m_versions(&p_versions), m_case(p_case), m_epoque(p_epoque) { }
+
+
+/**
+ * \brief Constructeur de déplacement ; l'instantané déplacé n'épingle plus rien
+ */
+VersionsClients::Instantane::Instantane(Instantane&& p_instantane) noexcept:
+        m_versions(p_instantane.m_versions), m_case(p_instantane.m_case), m_epoque(p_instantane.m_epoque)
+{
+  p_instantane.m_versions = nullptr;
+}
+
+
+/**
+ * \brief Destructeur ; libère l'époque épinglée
+ */
+VersionsClients::Instantane::~Instantane()
+{
+  if (m_versions != nullptr)
+    {
+      m_versions->m_epingles[m_case].store (CASE_LIBRE);
+    }
+}
+
+
+/**
+ * \brief Retourne l'époque épinglée
+ * \return un entier qui représente l'époque de l'instantané
+ */
+std::uint64_t VersionsClients::Instantane::reqEpoque() const
+{
+  return m_epoque;
+}
+
+
+/**
+ * \brief Vérifie si un client existait à l'époque de l'instantané
+ * \param[in] p_noFolio Le numéro de folio à vérifier.
+ * \return true si le client est présent, false sinon.
+ */
+bool VersionsClients::Instantane::clientEstPresent(int p_noFolio) const
+{
+  return trouver (p_noFolio) != nullptr;
+}
+
+
+/**
+ * \brief Retourne un client tel qu'il était à l'époque de l'instantané
+ * \param[in] p_noFolio Le numéro de folio du client.
+ * \return une référence constante vers le client, valide tant que l'instantané existe
+ * \exception ClientAbsentException Levée si le client n'existait pas à cette époque.
+ */
+const Client& VersionsClients::Instantane::reqClient(int p_noFolio) const
+{
+  const Client* client = trouver (p_noFolio);
+  if (client == nullptr)
+    {
+      throw ClientAbsentException("Il n'existe aucun client avec le folio " + to_string (p_noFolio));
+    }
+  return *client;
+}
+
+
+/**
+ * \brief Visite, par folio croissant, les clients tels qu'ils étaient à
+ *        l'époque de l'instantané
+ * \param[in] p_visiteur la fonction appelée pour chaque client
+ */
+void VersionsClients::Instantane::parcourirClients(const std::function<void(const Client&)>& p_visiteur) const
+{
+  for (int noFolio = FOLIO_MINIMUM; noFolio <= FOLIO_MAXIMUM; ++noFolio)
+    {
+      const Client* client = trouver (noFolio);
+      if (client != nullptr)
+        {
+          p_visiteur (*client);
+        }
+    }
+}
+
+
+const Client* VersionsClients::Instantane::trouver(int p_noFolio) const
+{
+  if (p_noFolio < FOLIO_MINIMUM || p_noFolio > FOLIO_MAXIMUM)
+    {
+      return nullptr;
+    }
+  const Version* version = m_versions->m_tetes[static_cast<size_t> (p_noFolio - FOLIO_MINIMUM)]
+          .load (memory_order_acquire);
+  while (version != nullptr && version->epoque > m_epoque)
+    {
+      version = version->precedente.load (memory_order_acquire);
+    }
+  return version != nullptr ? &version->client : nullptr;
+}
+
+} //namespace bancaire
@@ -0,0 +1,118 @@
+/**
+ * \file VersionsClients.h
+ * \brief Fichier qui contient l'interface de la classe VersionsClients et de ses instantanés.
+ * \author Petiton Wiseley
+ * \version 1.0
+ */
+#ifndef VERSIONSCLIENTS_H
+#define VERSIONSCLIENTS_H
+
+#include "Client.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace bancaire
+{
+/**
+ * \class VersionsClients
+ * \brief Conserve plusieurs versions de chaque client pour que des lecteurs
+ *        lisent un état cohérent pendant que l'écrivain continue ses mutations.
+ *
+ * Chaque publication d'un client crée une version immuable, étiquetée d'une
+ * nouvelle époque, en tête de la chaîne des versions de son folio, puis avance
+ * l'époque courante. Un lecteur épingle l'époque courante dans un Instantane et
+ * voit, pour chaque folio, la version la plus récente qui ne la dépasse pas :
+ * il ne prend aucun verrou et ne bloque jamais l'écrivain.
+ *
+ * Récupération par époques : les époques épinglées sont affichées dans un
+ * tableau de cases ; une version n'est libérée par l'écrivain que lorsqu'une
+ * version plus récente est visible de toutes les époques épinglées. Une
+ * chaîne est taillée à chaque publication de son client, et toutes le sont
+ * par recuperer.
+ *
+ * Un seul fil à la fois peut publier ; les instantanés peuvent être pris et
+ * lus par n'importe quel fil, mais ne doivent pas survivre à l'objet.
+ */
+class VersionsClients
+{
+  struct Version;
+
+public:
+  static const int FOLIO_MINIMUM = 1000;
+  static const int FOLIO_MAXIMUM = 9999;
+  static const std::size_t NOMBRE_LECTEURS_MAX = 64;
+
+  /**
+   * \class Instantane
+   * \brief Vue en lecture seule des clients à une époque épinglée, libérée à
+   *        la destruction.
+   */
+  class Instantane
+  {
+  public:
+    Instantane(Instantane&& p_instantane) noexcept;
+    ~Instantane();
+    Instantane(const Instantane&) = delete;
+    Instantane& operator=(const Instantane&) = delete;
+    Instantane& operator=(Instantane&&) = delete;
+
+    //accesseurs
+    std::uint64_t reqEpoque() const;
+    bool clientEstPresent(int p_noFolio) const;
+    const Client& reqClient(int p_noFolio) const;
+
+    //methodes
+    void parcourirClients(const std::function<void(const Client&)>& p_visiteur) const;
+
+  private:
+    friend class VersionsClients;
+    Instantane(const VersionsClients& p_versions, std::size_t p_case, std::uint64_t p_epoque);
+    const Client* trouver(int p_noFolio) const;
+
+    const VersionsClients* m_versions;
+    std::size_t m_case;
+    std::uint64_t m_epoque;
+  };
+
+  VersionsClients();
+  ~VersionsClients();
+  VersionsClients(const VersionsClients&) = delete;
+  VersionsClients& operator=(const VersionsClients&) = delete;
+
+  //accesseurs
+  std::uint64_t reqEpoque() const;
+  std::size_t reqNombreVersions() const;
+
+  //methodes
+  void publier(const Client& p_client);
+  Instantane epingler() const;
+  void recuperer();
+
+private:
+  struct Version
+  {
+    Version(std::uint64_t p_epoque, const Client& p_client, Version* p_precedente);
+
+    const std::uint64_t epoque;
+    const Client client;
+    std::atomic<Version*> precedente;
+  };
+
+  static const std::size_t NOMBRE_FOLIOS = FOLIO_MAXIMUM - FOLIO_MINIMUM + 1;
+
+  std::uint64_t reqEpoqueMinimum() const;
+  void tailler(std::size_t p_folio, std::uint64_t p_epoqueMinimum);
+
+  std::unique_ptr<std::atomic<Version*>[]> m_tetes;
+  mutable std::array<std::atomic<std::uint64_t>, NOMBRE_LECTEURS_MAX> m_epingles;
+  std::atomic<std::uint64_t> m_epoque;
+  std::size_t m_nombreVersions;
+};
+
+} //namespace bancaire
+
+#endif /* VERSIONSCLIENTS_H */
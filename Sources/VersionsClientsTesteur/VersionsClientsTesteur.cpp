@@ -0,0 +1,146 @@
+/**
+ * \file VersionsClientsTesteur.cpp
+ * \brief Test unitaire de la classe VersionsClients et de ses instantanés.
+ *
+ * À tester :
+ *         void publier(const Client& p_client);
+ *         Instantane epingler() const;
+ *         void recuperer();
+ *         std::size_t reqNombreVersions() const;
+ *         const Client& Instantane::reqClient(int p_noFolio) const;
+ *         void Instantane::parcourirClients(const std::function<void(const Client&)>& p_visiteur) const;
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "VersionsClients.h"
+#include "ClientException.h"
+#include "Epargne.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace bancaire;
+using namespace std;
+
+/**
+ * \brief Création d'une fixture : un client à deux comptes épargne dont la
+ *        somme des soldes vaut toujours 1000, publié une première fois
+ */
+class VersionsClientsTest : public ::testing::Test
+{
+public:
+  VersionsClientsTest():
+  f_client(1000, "Jean", "Paul", "581 435-5632", util::Date(20, 1, 1983))
+  {
+    f_client.ajouterCompte (Epargne(1, 1.5, 600, "Etudes"));
+    f_client.ajouterCompte (Epargne(2, 2.5, 400, "Voyage"));
+    f_versions.publier (f_client);
+  }
+
+  void virer(double p_montant)
+  {
+    f_client.reqCompte (1).asgSolde (f_client.reqCompte (1).reqSolde () - p_montant);
+    f_client.reqCompte (2).asgSolde (f_client.reqCompte (2).reqSolde () + p_montant);
+    f_versions.publier (f_client);
+  }
+
+  Client f_client;
+  VersionsClients f_versions;
+};
+
+
+/**
+ * \brief Test de la méthode Instantane epingler() const;
+ *     Cas valides : un instantané ne voit pas les publications postérieures ;
+ *                   un nouvel instantané les voit.
+ *     Cas invalides : un client publié après l'instantané, ou hors des folios,
+ *                     en est absent.
+ */
+TEST_F(VersionsClientsTest, epingler_PublicationsPosterieures_Invisibles)
+{
+  VersionsClients::Instantane avant = f_versions.epingler ();
+  virer (100);
+  f_versions.publier (Client(2000, "Carlo", "Ancelotti", "590 234-0342", util::Date(20, 1, 1983)));
+
+  ASSERT_EQ(600, avant.reqClient (1000).reqCompte (1).reqSolde ());
+  ASSERT_FALSE(avant.clientEstPresent (2000));
+  ASSERT_THROW(avant.reqClient (2000), ClientAbsentException);
+  ASSERT_FALSE(avant.clientEstPresent (42));
+
+  VersionsClients::Instantane apres = f_versions.epingler ();
+  ASSERT_EQ(avant.reqEpoque () + 2, apres.reqEpoque ());
+  ASSERT_EQ(500, apres.reqClient (1000).reqCompte (1).reqSolde ());
+  vector<int> folios;
+  apres.parcourirClients ([&folios] (const Client& p_client)
+  {
+    folios.push_back (p_client.reqNoFolio ());
+  });
+  ASSERT_EQ((vector<int> {1000, 2000}), folios);
+}
+
+
+/**
+ * \brief Test des méthodes void recuperer() et std::size_t reqNombreVersions() const;
+ *     Cas valides : sans lecteur, seule la dernière version est gardée ; une
+ *                   version épinglée est gardée jusqu'à la fin de l'instantané.
+ *     Cas invalide : aucun
+ */
+TEST_F(VersionsClientsTest, recuperer_VersionsInvisibles_Liberees)
+{
+  for (int i = 0; i < 10; ++i)
+    {
+      virer (1);
+    }
+  ASSERT_EQ(1u, f_versions.reqNombreVersions ());
+  {
+    VersionsClients::Instantane instantane = f_versions.epingler ();
+    virer (1);
+    virer (1);
+    ASSERT_EQ(3u, f_versions.reqNombreVersions ());
+    ASSERT_EQ(590, instantane.reqClient (1000).reqCompte (1).reqSolde ());
+  }
+  f_versions.recuperer ();
+  ASSERT_EQ(1u, f_versions.reqNombreVersions ());
+}
+
+/**
+ * \brief Test de lecteurs concurrents d'un écrivain qui publie sans arrêt
+ *     Cas valide : chaque instantané voit un état cohérent, où la somme des
+ *                  soldes vaut toujours 1000, et les versions sont récupérées.
+ *     Cas invalide : aucun
+ */
+TEST_F(VersionsClientsTest, epingler_LecteursConcurrents_EtatsCoherents)
+{
+  atomic<bool> fin(false);
+  atomic<int> incoherences(0);
+  vector<thread> lecteurs;
+  for (int i = 0; i < 4; ++i)
+    {
+      lecteurs.emplace_back ([this, &fin, &incoherences] ()
+      {
+        while (!fin.load ())
+          {
+            VersionsClients::Instantane instantane = f_versions.epingler ();
+            const Client& client = instantane.reqClient (1000);
+            if (client.reqCompte (1).reqSolde () + client.reqCompte (2).reqSolde () != 1000)
+              {
+                ++incoherences;
+              }
+          }
+      });
+    }
+  for (int i = 0; i < 20000; ++i)
+    {
+      virer (i % 2 == 0 ? 7 : -7);
+    }
+  fin.store (true);
+  for (thread& lecteur : lecteurs)
+    {
+      lecteur.join ();
+    }
+  f_versions.recuperer ();
+
+  ASSERT_EQ(0, incoherences.load ());
+  ASSERT_EQ(1u, f_versions.reqNombreVersions ());
+}
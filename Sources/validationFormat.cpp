@@ -195,4 +195,63 @@ bool validerFormatNumero(const std::string& p_numero)
   return valide;
 }
 
+
+/**
+ * \brief Ramène un numéro de téléphone nord-américain à une clé entière
+ *        Les séparateurs usuels (espaces, tirets, points, parenthèses) et un
+ *        indicatif de pays +1 sont acceptés : « 418 555-1234 »,
+ *        « (418) 555-1234 » et « +1 418.555.1234 » donnent la même clé,
+ *        4185551234. Le « + » ne peut paraître qu'une fois, avant tout autre
+ *        caractère que des espaces, et seul lui annonce l'indicatif : sans
+ *        « + », onze chiffres sont refusés.
+ * \param[in] p_numero une chaîne de caractères représentant le numéro
+ * \param[out] p_cle les dix chiffres du numéro, lus comme un entier
+ * \return un booléen indiquant si le numéro a pu être normalisé ; p_cle n'est
+ *         pas modifiée sinon
+ */
+bool normaliserNumero(std::string_view p_numero, std::uint64_t& p_cle)
+{
+  uint64_t cle = 0;
+  int chiffres = 0;
+  bool indicatif = false;
+  bool debut = true;
+  for (size_t i = 0; i < p_numero.size (); ++i)
+    {
+      const char c = p_numero[i];
+      if (c >= '0' && c <= '9')
+        {
+          cle = cle * 10 + static_cast<uint64_t> (c - '0');
+          ++chiffres;
+        }
+      else if (c == '+' && debut)
+        {
+          indicatif = true;
+        }
+      else if (!(c == ESPACE || c == TIRET || c == '.' || c == '(' || c == ')'))
+        {
+          return false;
+        }
+      debut = debut && c == ESPACE;
+      if (chiffres > 11)
+        {
+          return false;
+        }
+    }
+  if (indicatif)
+    {
+      if (chiffres != 11 || cle / 10000000000ULL != 1)
+        {
+          return false;
+        }
+      cle %= 10000000000ULL;
+      chiffres = 10;
+    }
+  if (chiffres != 10)
+    {
+      return false;
+    }
+  p_cle = cle;
+  return true;
+}
+
 } //namespace util
\ No newline at end of file
@@ -7,7 +7,9 @@
 #ifndef VALIDATIONFORMAT_H
 #define VALIDATIONFORMAT_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <fstream>
 
 
@@ -21,6 +23,7 @@ bool validerFormatNom(const std::string& p_nom);
 bool validerFormatFichier(std::istream& p_is);
 bool validerFormatDate(const std::string& p_date);
 bool validerFormatNumero(const std::string& p_numero);
+bool normaliserNumero(std::string_view p_numero, std::uint64_t& p_cle);
 } //namespace util
 #endif /* VALIDATIONFORMAT_H */
 